@@ -0,0 +1,129 @@
+function results = check_amplitude_grid(profile_dir, tolerance)
+    % Check the coarse-grid amplitude of SignalGenerator (see
+    % setAmplitudeTolerance) against exact evaluation of the power profile.
+    %
+    % The profiles are the L1CA signal power profiles of the ID13 and ID17
+    % spoofed and true signals of the tv1_both test vector, which switch on
+    % and off. A generator of constant chips is run with each profile, once
+    % with and once without the tolerance, in a window around every break
+    % of the profile, where the amplitude steps or kinks; the amplitude is
+    % the magnitude of the samples. The check fails if any amplitude differs
+    % from the exact one by more than the tolerance, relative to the exact
+    % amplitude, or is not zero where the exact amplitude is zero.
+    %
+    % Parameters:
+    % profile_dir: Optional. The tv1_both directory of tvs_for_distro.zipx
+    %     (default tv1_both in the repository root, where the archive
+    %     extracts to).
+    % tolerance: Optional. The relative amplitude tolerance (default 1e-5).
+    %
+    % Returns: A struct array with one element per profile, with fields
+    %     name, amplitude_interval (in sec), max_relative_error,
+    %     max_zero_error and status ('pass' or 'fail'). Without an output
+    %     argument, an error is raised if any profile fails.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+    PROFILES = { ...
+        'Spoof_GPS_L1CA_ID13_Signal_Power.mgpp', ...
+        'Spoof_GPS_L1CA_ID17_Signal_Power.mgpp', ...
+        'True_GPS_L1CA_ID13_Signal_Power.mgpp', ...
+        'True_GPS_L1CA_ID17_Signal_Power.mgpp'};
+    WINDOW_SECONDS = 4e-3; % The span checked around each break (in sec)
+
+    [local_dir, ~, ~] = fileparts(mfilename('fullpath'));
+    root_dir = fileparts(local_dir);
+    if nargin < 1 || isempty(profile_dir)
+        profile_dir = [root_dir, filesep, 'tv1_both'];
+    end
+    if nargin < 2
+        tolerance = 1e-5;
+    end
+    addpath([root_dir, filesep, 'oosiggen']);
+    addpath([root_dir, filesep, 'tools']);
+
+    results = struct('name', {}, 'amplitude_interval', {}, ...
+                     'max_relative_error', {}, 'max_zero_error', {}, ...
+                     'status', {});
+    for i = 1:numel(PROFILES)
+        power_spline = readPiecewisePolynomialBinary( ...
+            [profile_dir, filesep, PROFILES{i}]);
+        exact_gen = make_generator(power_spline);
+        grid_gen = make_generator(power_spline);
+        grid_gen.setAmplitudeTolerance(tolerance);
+
+        max_relative_error = 0;
+        max_zero_error = 0;
+        window_starts = max(power_spline.breaks - WINDOW_SECONDS / 2, 0);
+        for window_start = window_starts
+            exact_gen.seek(window_start);
+            grid_gen.seek(window_start);
+            [~, exact_samples] = exact_gen.getSamples(WINDOW_SECONDS);
+            [~, grid_samples] = grid_gen.getSamples(WINDOW_SECONDS);
+            exact_amplitude = abs(exact_samples);
+            error_amplitude = abs(abs(grid_samples) - exact_amplitude);
+            nonzero = exact_amplitude > 0;
+            max_relative_error = max([max_relative_error; ...
+                error_amplitude(nonzero) ./ exact_amplitude(nonzero)]);
+            max_zero_error = max([max_zero_error; error_amplitude(~nonzero)]);
+        end
+
+        result = struct();
+        result.name = PROFILES{i};
+        result.amplitude_interval = grid_gen.amplitude_interval;
+        result.max_relative_error = max_relative_error;
+        result.max_zero_error = max_zero_error;
+        result.status = 'pass';
+        if max_relative_error > tolerance || max_zero_error > 0
+            result.status = 'fail';
+        end
+        fprintf(['%-40s %s: interval %g s, relative error %.3g, ' ...
+                 'error where zero %.3g\n'], result.name, ...
+                upper(result.status), result.amplitude_interval, ...
+                max_relative_error, max_zero_error);
+        results(end + 1) = result; %#ok<AGROW>
+    end
+
+    if nargout == 0
+        if any(strcmp({results.status}, 'fail'))
+            error('The amplitude grid exceeds its tolerance.');
+        end
+        clear results
+    end
+end
+
+function sig_gen = make_generator(power_spline)
+    % A generator of constant chips with a power profile, so that the
+    % magnitude of each sample is the amplitude.
+    CHIP_RATE = 1.023e6; % (in chips/sec)
+    NUM_CHIPS = 1023;
+    codegen = RepeatingSampleGenerator(ones(NUM_CHIPS, 1), 1, CHIP_RATE, ...
+                                       false);
+    sig_gen = SignalGenerator(ReferenceSignalGenerator(codegen), ...
+                              power_spline);
+end
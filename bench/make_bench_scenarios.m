@@ -0,0 +1,190 @@
+function make_bench_scenarios(output_dir)
+    % Write the synthetic scenarios of the end-to-end benchmark (see
+    % run_benchmark) in the scenario format read by generate_iq.
+    %
+    % Every profile is computed from a few exactly representable parameters
+    % per signal, using only basic arithmetic, so the files are the same on
+    % every machine and the checked-in copies can be regenerated exactly.
+    % The scenarios share one directory and one set of profile files:
+    % - l1ca_8: GPS L1CA PRNs 1 to 8.
+    % - mixed_30: GPS L1CA and Galileo E1OS PRNs 1 to 15.
+    % - l1ca_8_fdma_16msps: The signals of l1ca_8, each given a different
+    %     FDMA offset, a multiple of 562.5 kHz as between GLONASS channels,
+    %     to be sampled at 16 Msps.
+    %
+    % Parameters:
+    % output_dir: Optional. The directory to write the scenarios to.
+    %     Defaults to the `scenarios` directory beside this file.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+    PROFILE_SECONDS = 4; % The span of every profile (in sec)
+    NUM_PRNS = 15; % PRNs of each system
+    C = 299792458; % Speed of light (in m/s)
+    FC = 1575420000; % L1 and E1 carrier frequency (in Hz)
+    CHIP = 1 / 1.023e6; % L1CA and E1OS chip length (in sec)
+    NOISE_DENSITY = 4e-21; % (in W/Hz)
+    FDMA_SPACING = 562500; % (in Hz)
+
+    [local_dir, ~, ~] = fileparts(mfilename('fullpath'));
+    addpath([local_dir, filesep, '..', filesep, 'tools']);
+    if nargin < 1
+        output_dir = [local_dir, filesep, 'scenarios'];
+    end
+    if ~exist(output_dir, 'dir')
+        mkdir(output_dir);
+    end
+
+    % Profiles shared by every signal. The autocorrelation functions are
+    % only loaded on demand (see load_signal), but must exist.
+    write_profile(output_dir, 'default_noise_density.mgpp', ...
+                  [0, PROFILE_SECONDS], NOISE_DENSITY);
+    write_profile(output_dir, 'zero_data.mgpp', [0, PROFILE_SECONDS], 0);
+    write_profile(output_dir, 'CA_Autocorrelation.mgpp', ...
+                  [-CHIP, 0, CHIP], [1 / CHIP, 0; -1 / CHIP, 1]);
+    write_profile(output_dir, 'E1OS_Autocorrelation.mgpp', ...
+                  [-CHIP, -CHIP / 2, 0, CHIP / 2, CHIP], ...
+                  [-1 / CHIP, 0; 3 / CHIP, -0.5; -3 / CHIP, 1; ...
+                   1 / CHIP, -0.5]);
+
+    piece_starts = (0:(PROFILE_SECONDS - 1)).';
+    signals = cell(1, 2 * NUM_PRNS);
+    for j = 1:(2 * NUM_PRNS)
+        if j <= NUM_PRNS
+            system = 'GPS';
+            name = 'L1CA';
+            prn = j;
+            data_rate = 50;
+            autocorr_file = 'CA_Autocorrelation.mgpp';
+        else
+            system = 'Galileo';
+            name = 'E1OS';
+            prn = j - NUM_PRNS;
+            data_rate = 250;
+            autocorr_file = 'E1OS_Autocorrelation.mgpp';
+        end
+        prefix = sprintf('%s_%s_PRN%02d', system, name, prn);
+
+        % A range, range rate and acceleration per signal, with Doppler to
+        % match.
+        range = 2.0e7 + 1.5e5 * j;
+        range_rate = -900 + 60 * j;
+        acceleration = 0.0625 * (mod(j, 5) - 2);
+        write_profile(output_dir, [prefix '_Pseudorange.mgpp'], ...
+            0:PROFILE_SECONDS, ...
+            [acceleration / 2 * ones(PROFILE_SECONDS, 1), ...
+             range_rate + acceleration * piece_starts, ...
+             range + range_rate * piece_starts + ...
+             acceleration / 2 * (piece_starts .* piece_starts)]);
+        write_profile(output_dir, [prefix '_Doppler.mgpp'], ...
+            0:PROFILE_SECONDS, ...
+            [-acceleration * FC / C * ones(PROFILE_SECONDS, 1), ...
+             -(range_rate + acceleration * piece_starts) * FC / C]);
+
+        % A power of 1 to 2e-16 W (-160 to -157 dBW), drifting slowly.
+        power = 1e-16 * (1 + mod(j, 4) / 4);
+        power_rate = 1e-16 / 64 * (mod(j, 3) - 1);
+        write_profile(output_dir, [prefix '_Signal_Power.mgpp'], ...
+            0:PROFILE_SECONDS, ...
+            [power_rate * ones(PROFILE_SECONDS, 1), ...
+             power + power_rate * piece_starts]);
+
+        % Pseudorandom symbols from a Park-Miller generator, whose products
+        % are exact in double precision.
+        num_symbols = PROFILE_SECONDS * data_rate;
+        symbols = zeros(num_symbols, 1);
+        state = j;
+        for k = 1:num_symbols
+            state = mod(16807 * state, 2147483647);
+            symbols(k) = 2 * (state >= 2^30) - 1;
+        end
+        write_profile(output_dir, [prefix '_I_Data.mgpp'], ...
+                      (0:num_symbols) / data_rate, symbols);
+
+        signals{j} = struct( ...
+            'comment', sprintf('%s %s PRN %d', system, name, prn), ...
+            'system', system, ...
+            'name', name, ...
+            'tx_id', j, ...
+            'has_data', true, ...
+            'fc', FC, ...
+            'carrier_phase', 0.75 * mod(j, 8), ...
+            'autocorr_function', autocorr_file, ...
+            'pseudorange_profile', [prefix '_Pseudorange.mgpp'], ...
+            'doppler_profile', [prefix '_Doppler.mgpp'], ...
+            'signal_power_profile', [prefix '_Signal_Power.mgpp'], ...
+            'noise_power_density_profile', 'default_noise_density.mgpp', ...
+            'data_symbols_real', [prefix '_I_Data.mgpp'], ...
+            'data_symbols_imag', 'zero_data.mgpp', ...
+            'signal_params', struct('prn', prn, 'data_rate', data_rate), ...
+            'signal_options', []);
+    end
+
+    fdma_signals = signals(1:8);
+    for j = 1:numel(fdma_signals)
+        fdma_signals{j}.fdma_offset = FDMA_SPACING * (j - 5);
+    end
+    write_scenario(output_dir, 'l1ca_8', signals(1:8));
+    write_scenario(output_dir, 'mixed_30', signals);
+    write_scenario(output_dir, 'l1ca_8_fdma_16msps', fdma_signals);
+end
+
+function write_profile(output_dir, filename, breaks, coefs)
+    % Write one profile, with one row of `coefs`, from the highest order
+    % down, per piece between `breaks`.
+    piecewise_polynomial = struct('form', 'pp', 'breaks', breaks, ...
+                                  'coefs', coefs, ...
+                                  'pieces', numel(breaks) - 1, ...
+                                  'order', size(coefs, 2), 'dim', 1);
+    writePiecewisePolynomialBinary([output_dir, filesep, filename], ...
+                                   piecewise_polynomial);
+end
+
+function write_scenario(output_dir, name, signals)
+    % Write `<name>.json` and the `<name>_signals.json` it refers to.
+    signals_file = [name '_signals.json'];
+    scenario = struct( ...
+        'antennas', {{struct('signals', signals_file, ...
+                             'string_id', 'antenna_01')}}, ...
+        't0', struct('zcount', struct('week_number', 2243, ...
+                                      'time_of_week_int', 0, ...
+                                      'time_of_week_frac', 0)), ...
+        'default_noise_density_profile', 'default_noise_density.mgpp');
+    write_json([output_dir, filesep, name, '.json'], scenario);
+    write_json([output_dir, filesep, signals_file], signals);
+end
+
+function write_json(filename, value)
+    % Write a value to a JSON file, replacing any earlier contents.
+    fid = fopen(filename, 'w');
+    if fid == -1
+        error(['Could not open file: ' filename]);
+    end
+    fprintf(fid, '%s\n', jsonencode(value, 'PrettyPrint', true));
+    fclose(fid);
+end
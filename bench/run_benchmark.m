@@ -0,0 +1,327 @@
+function results = run_benchmark(update_baseline, scenario_names)
+    % Run generate_iq end to end on each canned benchmark scenario and
+    % compare the results against a stored baseline.
+    %
+    % The scenarios are the synthetic ones in the `scenarios` directory
+    % beside this file (see make_bench_scenarios). For each run this
+    % measures:
+    % - Throughput: Output Msamples/sec over the wall time of the whole
+    %   generate_iq call, after the scenario cache has been built.
+    % - Peak RSS: The peak resident set size of the process during the run
+    %   (Linux only).
+    % - A per-stage breakdown, from generate_iq's profiler, with the
+    %   per-stream stages summed over the streams (such as 'streams/native').
+    % - An SHA-256 checksum of the IQ file, and a probe of samples spread
+    %   evenly through it.
+    %
+    % A run fails if its throughput is more than REGRESSION_THRESHOLD below
+    % the baseline's, its peak RSS is more than REGRESSION_THRESHOLD above,
+    % or its samples differ from the baseline's probe by more than
+    % SAMPLE_TOLERANCE. An output that is within the tolerance but not bit
+    % exact passes with a note. Throughput and memory depend on the machine,
+    % so the baseline must be recorded on the machine it is compared on.
+    %
+    % Parameters:
+    % update_baseline: Optional. True to store the results as the baseline
+    %     instead of comparing them (default false). A scenario missing from
+    %     the baseline is always stored.
+    % scenario_names: Optional. A cell array of the names of the scenarios
+    %     to run (default all of them).
+    %
+    % Returns: A struct array with one element per scenario run, with fields
+    %     name, msps, peak_rss_mib, stages (with fields name, seconds and
+    %     fraction of the run), num_samples, sha256, probe, status ('pass',
+    %     'fail' or 'new') and messages. Without an output argument, an
+    %     error is raised if any scenario fails.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+    % The scenarios, at their recommended rate except for
+    % l1ca_8_fdma_16msps, which is sampled at 4x that rate to leave room for
+    % its FDMA offsets. Every run uses generate_iq's default 4x composite
+    % oversampling and decimation.
+    SCENARIOS = struct( ...
+        'name', {'l1ca_8', 'mixed_30', 'l1ca_8_fdma_16msps'}, ...
+        'sampling_rate', {4e6, 8e6, 16e6}, ... % (in samples/sec)
+        'run_seconds', {2, 2, 2});
+    REGRESSION_THRESHOLD = 0.10; % Allowed fraction slower or larger
+    SAMPLE_TOLERANCE = 2; % Allowed difference of a probe sample (in LSB)
+    NUM_PROBE_SAMPLES = 1024; % IQ samples kept from each output
+    % The generate_iq settings of every run: fixed-point output, so that
+    % the checksum covers what is delivered, the stage timings, and the
+    % coarse-grid power profiles (see check_amplitude_grid).
+    OPTIONS = struct('FIXED_POINT', true, 'PROFILE', true, ...
+                     'AMPLITUDE_TOLERANCE', 1e-5);
+
+    if nargin < 1
+        update_baseline = false;
+    end
+    if nargin < 2
+        scenario_names = {SCENARIOS.name};
+    end
+    scenario_names = cellstr(scenario_names);
+
+    [local_dir, ~, ~] = fileparts(mfilename('fullpath'));
+    root_dir = fileparts(local_dir);
+    addpath(root_dir);
+    addpath([root_dir, filesep, 'oosiggen']);
+    addpath([root_dir, filesep, 'oosiggen', filesep, 'gps']);
+    addpath([root_dir, filesep, 'oosiggen', filesep, 'galileo']);
+    addpath([root_dir, filesep, 'tools']);
+    scenario_dir = [local_dir, filesep, 'scenarios'];
+    baseline_file = [local_dir, filesep, 'baseline.json'];
+
+    baseline = struct('scenarios', struct());
+    if exist(baseline_file, 'file')
+        baseline = jsondecode(fileread(baseline_file));
+    end
+
+    results = struct('name', {}, 'msps', {}, 'peak_rss_mib', {}, ...
+                     'stages', {}, 'num_samples', {}, 'sha256', {}, ...
+                     'probe', {}, 'status', {}, 'messages', {});
+    for i = 1:numel(scenario_names)
+        scenario = SCENARIOS(strcmp({SCENARIOS.name}, scenario_names{i}));
+        if isempty(scenario)
+            error('Unknown scenario: %s', scenario_names{i});
+        end
+        scenario_file = [scenario_dir, filesep, scenario.name, '.json'];
+        output_dir = tempname();
+
+        % Build the scenario cache first, so that only generation is timed.
+        compile_scenario(scenario_file);
+        rss_reset = reset_peak_rss();
+        run_timer = tic;
+        generate_iq(scenario_file, output_dir, scenario.name, ...
+                    scenario.sampling_rate, scenario.run_seconds, 0, ...
+                    [1, 1], OPTIONS);
+        run_seconds = toc(run_timer);
+        result = struct();
+        result.name = scenario.name;
+        result.msps = scenario.sampling_rate * scenario.run_seconds / ...
+                      run_seconds / 1e6;
+        result.peak_rss_mib = NaN;
+        if rss_reset
+            result.peak_rss_mib = read_peak_rss();
+        end
+        report = jsondecode(fileread([output_dir, filesep, ...
+                                      scenario.name, '_profile.json']));
+        result.stages = stage_breakdown(report, run_seconds);
+        [result.num_samples, result.sha256, result.probe] = ...
+            checksum_iq([output_dir, filesep, scenario.name, '.iq'], ...
+                        NUM_PROBE_SAMPLES);
+        rmdir(output_dir, 's');
+
+        result.status = 'new';
+        result.messages = {};
+        if ~update_baseline && isfield(baseline.scenarios, scenario.name)
+            result.messages = compare(result, ...
+                                      baseline.scenarios.(scenario.name), ...
+                                      REGRESSION_THRESHOLD, ...
+                                      SAMPLE_TOLERANCE);
+            result.status = 'pass';
+            if any(strncmp(result.messages, 'FAIL', 4))
+                result.status = 'fail';
+            end
+        end
+        results(end + 1) = result; %#ok<AGROW>
+    end
+
+    print_results(results, baseline);
+
+    new_idx = find(strcmp({results.status}, 'new'));
+    if ~isempty(new_idx)
+        for i = new_idx
+            stored = rmfield(results(i), {'name', 'status', 'messages'});
+            stored.probe = matlab.net.base64encode( ...
+                typecast(stored.probe(:), 'uint8'));
+            baseline.scenarios.(results(i).name) = stored;
+        end
+        baseline.computer = computer();
+        baseline.num_threads = maxNumCompThreads();
+        baseline.date = datestr(now(), 'yyyy-mm-dd HH:MM:SS');
+        fid = fopen(baseline_file, 'w');
+        if fid == -1
+            error(['Could not open file: ' baseline_file]);
+        end
+        fprintf(fid, '%s\n', jsonencode(baseline, 'PrettyPrint', true));
+        fclose(fid);
+        fprintf('Stored the baseline of %d scenario(s) in "%s".\n', ...
+                numel(new_idx), baseline_file);
+    end
+
+    if nargout == 0
+        if any(strcmp({results.status}, 'fail'))
+            error('The benchmark failed against its baseline.');
+        end
+        clear results
+    end
+end
+
+function messages = compare(result, base, threshold, sample_tolerance)
+    % Compare a run with its baseline. Failures begin with 'FAIL'.
+    messages = {};
+    if result.msps < (1 - threshold) * base.msps
+        messages{end + 1} = sprintf( ...
+            'FAIL: %.2f Msps is %.1f%% below the baseline of %.2f Msps.', ...
+            result.msps, 100 * (1 - result.msps / base.msps), base.msps);
+    end
+    % JSON stores an unmeasured RSS as null, which decodes as [].
+    if ~isnan(result.peak_rss_mib) && ~isempty(base.peak_rss_mib) && ...
+       result.peak_rss_mib > (1 + threshold) * base.peak_rss_mib
+        messages{end + 1} = sprintf( ...
+            ['FAIL: Peak RSS of %.0f MiB is %.1f%% above the baseline ' ...
+             'of %.0f MiB.'], ...
+            result.peak_rss_mib, ...
+            100 * (result.peak_rss_mib / base.peak_rss_mib - 1), ...
+            base.peak_rss_mib);
+    end
+    if result.num_samples ~= base.num_samples
+        messages{end + 1} = sprintf( ...
+            'FAIL: %d samples were generated, not %d.', ...
+            result.num_samples, base.num_samples);
+    elseif ~strcmp(result.sha256, base.sha256)
+        base_probe = typecast(matlab.net.base64decode(base.probe), 'int16');
+        difference = max(abs(double(result.probe(:)) - double(base_probe(:))));
+        if difference > sample_tolerance
+            messages{end + 1} = sprintf( ...
+                ['FAIL: The output differs from the baseline by up to ' ...
+                 '%d LSB (tolerance %d).'], difference, sample_tolerance);
+        else
+            messages{end + 1} = sprintf( ...
+                ['The output is not bit exact, but is within %d LSB of ' ...
+                 'the baseline (tolerance %d).'], difference, ...
+                sample_tolerance);
+        end
+    end
+end
+
+function stages = stage_breakdown(report, run_seconds)
+    % Sum the profiler's per-stream stages, such as 'GPS L1CA PRN 5/native',
+    % over the streams, as 'streams/native'. The streams' native times are
+    % summed over the engine's threads, so may exceed the run time.
+    names = {};
+    seconds = [];
+    for i = 1:numel(report.stages)
+        name = report.stages(i).name;
+        if ~strncmp(name, 'composite/', 10) && ~strncmp(name, 'output/', 7)
+            name = ['streams', name(find(name == '/', 1, 'last'):end)];
+        end
+        stage_idx = find(strcmp(names, name));
+        if isempty(stage_idx)
+            names{end + 1} = name; %#ok<AGROW>
+            seconds(end + 1) = 0; %#ok<AGROW>
+            stage_idx = numel(names);
+        end
+        seconds(stage_idx) = seconds(stage_idx) + report.stages(i).seconds;
+    end
+    stages = struct('name', names, 'seconds', num2cell(seconds), ...
+                    'fraction', num2cell(seconds / run_seconds));
+end
+
+function [num_samples, sha256, probe] = checksum_iq(filename, num_probe)
+    % Hash an int16 I/Q file, and keep `num_probe` of its IQ samples, spread
+    % evenly from the first to the last, as a 2-by-num_probe int16 array.
+    fid = fopen(filename, 'r', 'ieee-le');
+    if fid == -1
+        error(['Could not open file: ' filename]);
+    end
+    contents = fread(fid, inf, '*int16');
+    fclose(fid);
+    digest = java.security.MessageDigest.getInstance('SHA-256');
+    if ~isempty(contents)
+        digest.update(typecast(contents, 'int8'));
+    end
+    sha256 = lower(reshape(dec2hex(typecast(digest.digest(), 'uint8'), ...
+                                   2).', 1, []));
+    iq = reshape(contents, 2, []);
+    num_samples = size(iq, 2);
+    probe = iq(:, unique(round(linspace(1, num_samples, num_probe))));
+end
+
+function reset = reset_peak_rss()
+    % Reset the process's peak RSS, which Linux allows by writing 5 to
+    % clear_refs. False if it could not be reset.
+    reset = false;
+    fid = fopen('/proc/self/clear_refs', 'w');
+    if fid == -1
+        return
+    end
+    reset = fprintf(fid, '5') == 1;
+    reset = fclose(fid) == 0 && reset;
+end
+
+function peak_mib = read_peak_rss()
+    % The process's peak RSS since reset_peak_rss() (in MiB), or NaN if it
+    % is not available.
+    peak_mib = NaN;
+    fid = fopen('/proc/self/status', 'r');
+    if fid == -1
+        return
+    end
+    status = fread(fid, inf, '*char').';
+    fclose(fid);
+    tokens = regexp(status, 'VmHWM:\s*(\d+)\s*kB', 'tokens', 'once');
+    if ~isempty(tokens)
+        peak_mib = str2double(tokens{1}) / 1024;
+    end
+end
+
+function print_results(results, baseline)
+    % Print each run, its stages and its comparison with the baseline.
+    for i = 1:numel(results)
+        result = results(i);
+        fprintf('\n%s: %s\n', result.name, upper(result.status));
+        base = [];
+        if isfield(baseline.scenarios, result.name)
+            base = baseline.scenarios.(result.name);
+        end
+        if isempty(base) || strcmp(result.status, 'new')
+            fprintf('  Throughput: %8.2f Msps\n', result.msps);
+            fprintf('  Peak RSS:   %8.0f MiB\n', result.peak_rss_mib);
+        else
+            fprintf('  Throughput: %8.2f Msps (baseline %.2f, %+.1f%%)\n', ...
+                    result.msps, base.msps, ...
+                    100 * (result.msps / base.msps - 1));
+            base_rss = base.peak_rss_mib;
+            if isempty(base_rss) % Stored as null when not measured
+                base_rss = NaN;
+            end
+            fprintf('  Peak RSS:   %8.0f MiB (baseline %.0f)\n', ...
+                    result.peak_rss_mib, base_rss);
+        end
+        fprintf('  SHA-256:    %s\n', result.sha256);
+        for j = 1:numel(result.stages)
+            fprintf('  %-24s %8.3f s %5.1f%%\n', result.stages(j).name, ...
+                    result.stages(j).seconds, ...
+                    100 * result.stages(j).fraction);
+        end
+        for j = 1:numel(result.messages)
+            fprintf('  %s\n', result.messages{j});
+        end
+    end
+end
@@ -1,4 +1,4 @@
-function generate_iq(scenario_file, output_dir, output_name, desired_samp_rate, run_seconds)
+function generate_iq(scenario_file, output_dir, output_name, desired_samp_rate, run_seconds, start_seconds, segment, options)
     % Generate baseband samples from a set of scenario splines.
     %
     % Parameters:
@@ -10,6 +10,20 @@ function generate_iq(scenario_file, output_dir, output_name, desired_samp_rate,
     % run_seconds: Number of seconds of signal data to produce. Requesting more
     %     signal data than is present in the provided simenv will cause
     %     oosiggen to crash.
+    % start_seconds: Optional. Scenario time of the first sample, in seconds
+    %     (default 0). The generators are positioned directly at this time,
+    %     so regenerating a window of a long scenario does not generate the
+    %     samples before it; the window matches the same samples of a run
+    %     from the start, including the noise.
+    % segment: Optional. [index, count] to generate only the index-th of
+    %     count contiguous time segments of the run (default [1, 1], the
+    %     whole run). Independent processes or cluster nodes, each given a
+    %     different index, then generate the run together: each seeks to its
+    %     segment and writes it in place in the shared IQ file (see
+    %     plan_segment). Segment 1 also writes the metadata.
+    % options: Optional. A struct whose fields override the tunable settings
+    %     of the same names below, such as struct('PROFILE', true) (default
+    %     struct(), which uses them all as set here).
 	
 	% NOTICE
 	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
@@ -43,10 +57,73 @@ function generate_iq(scenario_file, output_dir, output_name, desired_samp_rate,
     validateattributes(output_name, {'char', 'string'}, {'scalartext'});
     validateattributes(desired_samp_rate, {'numeric'}, {'scalar'});
     validateattributes(run_seconds, {'numeric'}, {'scalar'});
+    if nargin < 6
+        start_seconds = 0;
+    end
+    validateattributes(start_seconds, {'numeric'}, {'scalar', 'nonnegative'});
+    if nargin < 7
+        segment = [1, 1];
+    end
+    validateattributes(segment, {'numeric'}, ...
+                       {'numel', 2, 'integer', 'positive'});
+    is_segmented = segment(2) > 1;
+    if nargin < 8
+        options = struct();
+    end
+    validateattributes(options, {'struct'}, {'scalar'});
+
+    % The run is a whole number of these (in sec)
+    CHUNK_SIZE = tunable(options, 'CHUNK_SIZE', 0.05);
+    % Per-stage block sizing tunables; empty values are chosen from the cache
+    % sizes and sample rate (see plan_pipeline).
+    PIPELINE = tunable(options, 'PIPELINE', struct( ...
+        'private_cache_bytes', 2^20, ... % Per-core (L2) cache
+        'shared_cache_bytes', 8 * 2^20, ... % Shared (L3) cache
+        'chunk_size', [], ... % Seconds per getSamples() call
+        'engine_block_size', [], ... % High-rate samples per engine block
+        'writer_block_size', [])); % Bytes per file writer block
+    FIXED_POINT = tunable(options, 'FIXED_POINT', true);
+    % Only used for fixed point
+    FULL_SCALE_POWER_DBW = tunable(options, 'FULL_SCALE_POWER_DBW', -115.0);
+    % Sum supported signals in the native engine
+    USE_NATIVE_ENGINE = tunable(options, 'USE_NATIVE_ENGINE', true);
+    % Native engine samples chips at output rate
+    DIRECT_SYNTHESIS = tunable(options, 'DIRECT_SYNTHESIS', false);
+    % Storage of the native engine's sum: 'double', or 'single' to halve
+    % its memory traffic, rounding each summed sample to 24 bits (well
+    % below one LSB of the fixed-point output, but not bit exact).
+    NATIVE_SAMPLE_CLASS = tunable(options, 'NATIVE_SAMPLE_CLASS', 'double');
+    % Relative amplitude error of interpolating the power profiles from a
+    % coarse grid, such as 1e-5; 0 evaluates them exactly at every sample.
+    AMPLITUDE_TOLERANCE = tunable(options, 'AMPLITUDE_TOLERANCE', 0);
+    % Seed of the thermal noise generator
+    NOISE_SEED = tunable(options, 'NOISE_SEED', 0);
+    % Bypass the page cache for the IQ file (Linux only)
+    DIRECT_IO = tunable(options, 'DIRECT_IO', false);
+    % Reuse prepared signals from earlier runs
+    USE_SCENARIO_CACHE = tunable(options, 'USE_SCENARIO_CACHE', true);
+    % Write per-stage timings to <output_name>_profile.json
+    PROFILE = tunable(options, 'PROFILE', false);
+    % Stream live to a sink such as 'udp://127.0.0.1:5000' at the sample
+    % rate, instead of writing the IQ file; empty writes the file.
+    STREAM_DESTINATION = tunable(options, 'STREAM_DESTINATION', '');
+    % Seconds of samples queued before streaming
+    STREAM_PREFILL = tunable(options, 'STREAM_PREFILL', 0.5);
+    % Options must name one of the tunables above.
+    TUNABLE_NAMES = {'CHUNK_SIZE', 'PIPELINE', 'FIXED_POINT', ...
+        'FULL_SCALE_POWER_DBW', 'USE_NATIVE_ENGINE', 'DIRECT_SYNTHESIS', ...
+        'NATIVE_SAMPLE_CLASS', 'AMPLITUDE_TOLERANCE', 'NOISE_SEED', ...
+        'DIRECT_IO', 'USE_SCENARIO_CACHE', 'PROFILE', ...
+        'STREAM_DESTINATION', 'STREAM_PREFILL'};
+    unknown_options = setdiff(fieldnames(options), TUNABLE_NAMES);
+    if ~isempty(unknown_options)
+        error('Unknown option: %s', unknown_options{1});
+    end
 
-    CHUNK_SIZE = 0.05;
-    FIXED_POINT = true;
-    FULL_SCALE_POWER_DBW = -115.0; % Only used for fixed point
+    is_streaming = ~isempty(STREAM_DESTINATION);
+    if is_streaming && is_segmented
+        error('A streamed run cannot be segmented.');
+    end
 
     tic;
     restore_core_value = maxNumCompThreads('automatic');
@@ -57,23 +134,24 @@ function generate_iq(scenario_file, output_dir, output_name, desired_samp_rate,
     addpath([local_dir, filesep, 'oosiggen', filesep, 'galileo']);
     addpath([local_dir, filesep, 'tools']);
 
-    [simenv_path, ~, ~] = fileparts(scenario_file);
-    fprintf('Loading path [%s]\n', scenario_file);
-    scenario_def = jsondecode(fileread(scenario_file));
-
-    signals_filename = scenario_def.antennas.signals;
-    signals_def = jsondecode(fileread([simenv_path, filesep, signals_filename]));
-    if ~iscell(signals_def)
-        signals_def = num2cell(signals_def);
+    if USE_SCENARIO_CACHE
+        scenario = compile_scenario(scenario_file);
+    else
+        scenario = compile_scenario(scenario_file, '');
     end
 
     sig_gen_v = {};
+    sig_gen_labels = {};
+    sig_gen_fdma_offsets = zeros(1, 0);
     composite_sample_rate = 0.0;
-    for i = 1:numel(signals_def)
-        signal = signals_def{i};
-        [sig_gen, sample_rate] = make_sig_gen(signal, simenv_path);
-        composite_sample_rate = max(composite_sample_rate, sample_rate);
-        sig_gen_v = [sig_gen_v, sig_gen];
+    for i = 1:numel(scenario.recipes)
+        composite_sample_rate = max(composite_sample_rate, ...
+                                    scenario.sample_rates(i));
+        [recipe_sig_gen_v, recipe_labels, recipe_fdma_offsets] = ...
+            build_sig_gen(scenario.recipes{i});
+        sig_gen_v = [sig_gen_v, recipe_sig_gen_v];
+        sig_gen_labels = [sig_gen_labels, recipe_labels];
+        sig_gen_fdma_offsets = [sig_gen_fdma_offsets, recipe_fdma_offsets];
     end
     if desired_samp_rate < composite_sample_rate
         reply = input(sprintf(['Warning: desired sample rate is lower '...
@@ -93,66 +171,166 @@ function generate_iq(scenario_file, output_dir, output_name, desired_samp_rate,
 
     comp_sig_gen = CompositeSignalGenerator(composite_sample_rate);
     for i=1:numel(sig_gen_v)
-        comp_sig_gen.addSignalGenerator(sig_gen_v{i});
+        comp_sig_gen.addSignalGenerator(sig_gen_v{i}, ...
+                                        sig_gen_fdma_offsets(i));
     end
+    comp_sig_gen.setAmplitudeTolerance(AMPLITUDE_TOLERANCE);
+    comp_sig_gen.setNativeSampleClass(NATIVE_SAMPLE_CLASS);
+    comp_sig_gen.setUseNativeEngine(USE_NATIVE_ENGINE, DIRECT_SYNTHESIS);
+    profiler = PipelineProfiler(PROFILE);
+    comp_sig_gen.setProfiler(profiler, sig_gen_labels);
 
-    noise_ppoly = readPiecewisePolynomialBinary( ...
-        [simenv_path, filesep , scenario_def.default_noise_density_profile]);
+    noise_ppoly = scenario.noise_density;
 
-    fprintf('Creating output directory and metadata...\n');
+    fprintf('Creating output directory...\n');
     mkdir(output_dir);
     output_filename = [output_name '.iq'];
     output_file = [output_dir, filesep, output_filename];
     metadata_file = [output_dir, filesep, output_name '.xml'];
-
+    if is_segmented
+        profile_file = [output_dir, filesep, ...
+                        sprintf('%s_profile_%d.json', output_name, segment(1))];
+    else
+        profile_file = [output_dir, filesep, output_name '_profile.json'];
+    end
 
     if FIXED_POINT
         scale_factor = (2^15 - 1) / 10^(FULL_SCALE_POWER_DBW/20);
         out_dtype_name = 'int16';
-        out_dtype = @int16;
-        make_ion_xml(output_filename, sprintf('%f', composite_sample_rate),...
-            'int16', metadata_file);
+        ion_format = 'int16';
     else
         scale_factor = 1.0;
         out_dtype_name = 'single';
-        out_dtype = @single;
-        make_ion_xml(output_filename, sprintf('%f', composite_sample_rate),...
-            'float', metadata_file);
-    end
-    chunks_per_second = round(1 ./ CHUNK_SIZE);
-    chunks_per_minute = round(60 ./ CHUNK_SIZE);
-    minute = 0;
-    t = 0;
-    i = 0;
-    fid = fopen(output_file, 'w');
-    fprintf('Writing to "%s"...\n0', output_file);
-    while t < run_seconds
-        i = i + 1;
-        if mod(i, chunks_per_second) == 0
-            fprintf('.')
-            if mod(i, chunks_per_minute) == 0
-                minute = minute + 1;
-                fprintf('\n%d', minute);
+        ion_format = 'float';
+    end
+    output_stage = IQOutputStage(noise_ppoly, composite_sample_rate, ...
+                                 scale_factor, NOISE_SEED, out_dtype_name);
+
+    % Size each stage's blocks; the run length is unaffected.
+    pipeline = PIPELINE;
+    pipeline.output_granule = CHUNK_SIZE;
+    if FIXED_POINT
+        pipeline.sample_bytes = 4; % int16 I/Q
+    else
+        pipeline.sample_bytes = 8; % single I/Q
+    end
+    plan = plan_pipeline(composite_sample_rate, ...
+                         comp_sig_gen.oversample_ratio, numel(sig_gen_v), ...
+                         run_seconds, pipeline);
+    comp_sig_gen.setNativeBlockSize(plan.engine_block_size);
+    fprintf(['Generating %.1f ms per chunk in %d-sample engine blocks, ' ...
+             'writing %d KiB blocks.\n'], ...
+            1e3 * plan.chunk_samples / comp_sig_gen.sampling_rate_high, ...
+            plan.engine_block_size, plan.writer_block_size / 2^10);
+
+    seg_plan = plan_segment(plan, comp_sig_gen.oversample_ratio, ...
+                            pipeline.sample_bytes, segment(1), segment(2));
+    first_sample = round(start_seconds * composite_sample_rate) + ...
+                   seg_plan.first_sample;
+    if first_sample > 0
+        fprintf('Seeking to %.6f sec...\n', ...
+                first_sample / composite_sample_rate);
+        comp_sig_gen.seek(first_sample / composite_sample_rate);
+        output_stage.seek(first_sample);
+    end
+
+    seconds_shown = floor(first_sample / composite_sample_rate);
+    samples_done = 0;
+    underruns_shown = 0;
+    % The metadata is written once the IQ file (or segment 1) is complete.
+    finalize_fcn = [];
+    if segment(1) == 1 && ~is_streaming
+        finalize_fcn = @() make_ion_xml(output_filename, ...
+            sprintf('%f', composite_sample_rate), ion_format, metadata_file);
+    end
+    if is_streaming
+        % Twice the prefill leaves room for a chunk generated ahead.
+        writer = RealtimeIQStreamer(STREAM_DESTINATION, ...
+                                    composite_sample_rate, ...
+                                    pipeline.sample_bytes, ...
+                                    max(2 * STREAM_PREFILL, ...
+                                        STREAM_PREFILL + 2 * CHUNK_SIZE), ...
+                                    STREAM_PREFILL);
+        fprintf('Streaming to "%s" after %.0f ms of prefill...\n%d', ...
+                STREAM_DESTINATION, 1e3 * STREAM_PREFILL, ...
+                floor(seconds_shown / 60));
+    elseif is_segmented
+        writer = AsyncIQWriter(output_file, finalize_fcn, ...
+                               plan.writer_block_size, 4, DIRECT_IO, ...
+                               seg_plan.byte_offset, seg_plan.file_bytes);
+        fprintf('Writing segment %d of %d to "%s"...\n%d', segment(1), ...
+                segment(2), output_file, floor(seconds_shown / 60));
+    else
+        writer = AsyncIQWriter(output_file, finalize_fcn, ...
+                               plan.writer_block_size, 4, DIRECT_IO);
+        fprintf('Writing to "%s"...\n%d', output_file, ...
+                floor(seconds_shown / 60));
+    end
+    while samples_done < seg_plan.total_samples
+        % Request a whole number of high-rate samples; getSamples() rounds
+        % the duration down.
+        num_samples = min(plan.chunk_samples, ...
+                          seg_plan.total_samples - samples_done);
+        samples_done = samples_done + num_samples;
+        t = profiler.start();
+        [time_vector, data] = comp_sig_gen.getSamples( ...
+            (num_samples + 0.5) / comp_sig_gen.sampling_rate_high);
+        profiler.stop('composite/get_samples', t, num_samples, data);
+        if isempty(data)
+            continue;
+        end
+        while seconds_shown + 1 <= time_vector(end)
+            seconds_shown = seconds_shown + 1;
+            % Mark the seconds in which a live stream ran dry.
+            underruns = underruns_shown;
+            if is_streaming
+                stream_statistics = writer.getStatistics();
+                underruns = stream_statistics.underruns;
+            end
+            if underruns > underruns_shown
+                underruns_shown = underruns;
+                fprintf('u')
+            else
+                fprintf('.')
+            end
+            if mod(seconds_shown, 60) == 0
+                fprintf('\n%d', seconds_shown / 60);
+                if profiler.enabled
+                    profiler.writeJson(profile_file);
+                end
             end
         end
-        [time_vector, data] = comp_sig_gen.getSamples(CHUNK_SIZE);
-        n_samples = numel(data);
-        noise_power_v = ppval(noise_ppoly, time_vector);
-        noise_std_v = sqrt(noise_power_v .* (composite_sample_rate / 2));
-        noise_buffer = noise_std_v .* ...
-            (randn(n_samples, 1) + 1j * randn(n_samples, 1));
-        data = data + noise_buffer;
-        t = time_vector(end);
-        data_iq = zeros(1, 2*n_samples, out_dtype_name);
-        data = data * scale_factor;
-        data_iq(1:2:end) = out_dtype(real(data));
-        data_iq(2:2:end) = out_dtype(imag(data));
-        fwrite(fid, data_iq, out_dtype_name);
+        % Add noise, scale, quantize and interleave in one native pass.
+        t = profiler.start();
+        data_iq = output_stage.process(time_vector, data);
+        profiler.stop('output/process', t, numel(data), data_iq);
+        t = profiler.start();
+        writer.write(data_iq);
+        profiler.stop('output/write', t, numel(data));
     end
+    t = profiler.start();
+    writer.close();
+    profiler.stop('output/close', t, 0);
     fprintf('done.\n');
-    fclose(fid);
+    if is_streaming
+        writer.printLatencyBudget();
+    end
+    if profiler.enabled
+        profiler.writeJson(profile_file);
+        fprintf('Wrote stage timings to "%s".\n', profile_file);
+    end
 
     maxNumCompThreads(restore_core_value);
     toc
 
 end
+
+function value = tunable(options, name, default_value)
+    % Get a tunable setting: the field of `options` named `name`, if
+    % present, or else `default_value`.
+    if isfield(options, name)
+        value = options.(name);
+    else
+        value = default_value;
+    end
+end
@@ -0,0 +1,166 @@
+classdef (Sealed = true) AsyncIQWriter < handle
+%%
+% @brief Writes an IQ file from a background thread, overlapping disk I/O
+%        with sample generation.
+%
+% Each call to write() copies the data into one of a fixed set of
+% preallocated blocks and returns; full blocks are written to the file, in
+% order, by a native background thread while the next chunk of samples is
+% generated. write() only waits on the disk when every block is still
+% queued. On Linux, the file can optionally be opened with @c O_DIRECT so
+% that large sequential writes bypass the page cache.
+%
+% Errors from the background thread are reported by the next call to
+% write() or close(). The optional finalizer, such as a call to
+% make_ion_xml(), runs once close() has written all of the data, so
+% metadata only describes files that were completely written.
+%
+% @note
+% This class wraps a core MEX function, which must be compiled with make.m.
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        output_file; % The path of the IQ file.
+        bytes_written = 0; % The bytes written, once closed.
+    end
+
+    properties (Access = private)
+        writer_handle; % The uint64 handle to the native writer.
+        finalize_fcn; % Called with no arguments once the file is closed.
+    end
+
+    methods (Access = public)
+        function obj = AsyncIQWriter(output_file, finalize_fcn, ...
+                                     block_size, num_blocks, direct_io, ...
+                                     offset, file_size)
+        %%
+        % @brief Create (or truncate) an IQ file for writing, or open one to
+        %        write a range of it in place.
+        %
+        % Writing in place lets several writers, such as the workers of a
+        % segmented run (see generate_iq), each fill their own range of one
+        % file. The file is created if need be and is never truncated; each
+        % writer sets it to the same total size.
+        %
+        % @par Usage
+        % obj = AsyncIQWriter(output_file)
+        % obj = AsyncIQWriter(output_file, finalize_fcn)
+        % obj = AsyncIQWriter(output_file, finalize_fcn, block_size, ...
+        %                     num_blocks, direct_io)
+        % obj = AsyncIQWriter(output_file, finalize_fcn, block_size, ...
+        %                     num_blocks, direct_io, offset, file_size)
+        %
+        % @param[in] output_file The path of the IQ file.
+        % @param[in] finalize_fcn A function handle taking no arguments,
+        %            called by close() after all data is written, or [].
+        %            Defaults to [].
+        % @param[in] block_size The size of each buffered block (in bytes).
+        %            Defaults to 4 MiB.
+        % @param[in] num_blocks The number of buffered blocks, at least two.
+        %            Defaults to 4.
+        % @param[in] direct_io True to bypass the page cache, where the
+        %            platform and file system support it. Defaults to false.
+        % @param[in] offset The byte offset at which to write in place. If
+        %            not specified, the file is truncated and written from
+        %            the start.
+        % @param[in] file_size The size of the whole file (in bytes). Must be
+        %            specified with @c offset.
+        %
+        % @param[out] obj The created instance.
+            if nargin < 2
+                finalize_fcn = [];
+            end
+            if nargin < 3
+                block_size = 4 * 2^20;
+            end
+            if nargin < 4
+                num_blocks = 4;
+            end
+            if nargin < 5
+                direct_io = false;
+            end
+            if nargin == 6
+                error('file_size must be specified with offset.');
+            end
+            validateattributes(output_file, {'char', 'string'}, ...
+                               {'scalartext'});
+            if ~isempty(finalize_fcn)
+                validateattributes(finalize_fcn, {'function_handle'}, ...
+                                   {'scalar'});
+            end
+            validateattributes(block_size, {'numeric'}, ...
+                               {'scalar', 'integer', 'positive'});
+            validateattributes(num_blocks, {'numeric'}, ...
+                               {'scalar', 'integer', '>=', 2});
+            validateattributes(direct_io, {'logical', 'numeric'}, ...
+                               {'scalar'});
+            obj.output_file = char(output_file);
+            obj.finalize_fcn = finalize_fcn;
+            if nargin < 6
+                obj.writer_handle = asyncFileWriterCore('create', ...
+                    obj.output_file, double(block_size), ...
+                    double(num_blocks), double(direct_io));
+            else
+                validateattributes(offset, {'numeric'}, ...
+                                   {'scalar', 'integer', 'nonnegative'});
+                validateattributes(file_size, {'numeric'}, ...
+                                   {'scalar', 'integer', '>=', offset});
+                obj.writer_handle = asyncFileWriterCore('create', ...
+                    obj.output_file, double(block_size), ...
+                    double(num_blocks), double(direct_io), double(offset), ...
+                    double(file_size));
+            end
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native writer. An unclosed file is closed
+        %        without running the finalizer.
+        %
+        % @param[in] obj The instance of the class.
+            if ~isempty(obj.writer_handle)
+                asyncFileWriterCore('free', obj.writer_handle);
+            end
+        end
+
+        function write(obj, data)
+        %%
+        % @brief Append data to the file.
+        %
+        % @par Usage
+        % obj.write(data)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] data A real numeric array, such as the output of
+        %            IQOutputStage.process(). Its elements are written in
+        %            column-major order and native byte order, as by fwrite()
+        %            with a precision of <c>class(data)</c>.
+            asyncFileWriterCore('write', obj.writer_handle, data);
+        end
+
+        function close(obj)
+        %%
+        % @brief Write any buffered data, close the file and run the
+        %        finalizer.
+        %
+        % @par Usage
+        % obj.close()
+        %
+        % @param[in] obj The instance of the class.
+            obj.bytes_written = asyncFileWriterCore('close', ...
+                                                    obj.writer_handle);
+            asyncFileWriterCore('free', obj.writer_handle);
+            obj.writer_handle = [];
+            if ~isempty(obj.finalize_fcn)
+                obj.finalize_fcn();
+            end
+        end
+    end
+end
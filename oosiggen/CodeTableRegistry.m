@@ -0,0 +1,92 @@
+classdef (Sealed = true) CodeTableRegistry
+%%
+% @brief A process-wide cache of PRN code tables and of the chip sequences
+%        derived from them.
+%
+% Each code table file is loaded from disk at most once, and each expanded
+% chip sequence (with any secondary code overlay and BOC modulation
+% applied) is built at most once per PRN and component. Code generators
+% created for the same PRN and component therefore share one copy of the
+% sequence: MATLAB arrays are copied only when modified, and the sequences
+% are never modified.
+%
+% @par Usage
+% table = CodeTableRegistry.getTable('ca_code_table.mat')
+% samples = CodeTableRegistry.getSequence(key, build_fcn)
+% CodeTableRegistry.reset()
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    methods (Static = true, Access = public)
+        function table = getTable(filename)
+        %%
+        % @brief Get the variables of a code table file, loading it on
+        %        first use.
+        %
+        % @param[in] filename The code table file name, on the MATLAB path.
+        %
+        % @param[out] table A struct of the variables in the file, as
+        %             returned by load().
+            tables = CodeTableRegistry.store('tables');
+            if ~isKey(tables, filename)
+                if ~exist(filename, 'file')
+                    error(['Cannot find code table ' filename '\n'])
+                end
+                tables(filename) = load(filename);
+            end
+            table = tables(filename);
+        end
+
+        function samples = getSequence(key, build_fcn)
+        %%
+        % @brief Get a chip sequence, building it on first use.
+        %
+        % @param[in] key A string that identifies the sequence, such as
+        %            the signal, component and PRN.
+        % @param[in] build_fcn A function handle, taking no arguments, that
+        %            builds the sequence. Called only if @c key is new.
+        %
+        % @param[out] samples The chip sequence.
+            sequences = CodeTableRegistry.store('sequences');
+            if ~isKey(sequences, key)
+                sequences(key) = build_fcn();
+            end
+            samples = sequences(key);
+        end
+
+        function reset()
+        %%
+        % @brief Release all cached code tables and chip sequences. Existing
+        %        code generators keep their sequences.
+            remove(CodeTableRegistry.store('tables'), ...
+                   keys(CodeTableRegistry.store('tables')));
+            remove(CodeTableRegistry.store('sequences'), ...
+                   keys(CodeTableRegistry.store('sequences')));
+        end
+    end
+
+    methods (Static = true, Access = private)
+        function map = store(name)
+        %%
+        % @brief Get one of the persistent caches, by name.
+            persistent tables sequences;
+            if isempty(tables)
+                tables = containers.Map('KeyType', 'char', ...
+                                        'ValueType', 'any');
+                sequences = containers.Map('KeyType', 'char', ...
+                                           'ValueType', 'any');
+            end
+            if strcmp(name, 'tables')
+                map = tables;
+            else
+                map = sequences;
+            end
+        end
+    end
+end
@@ -0,0 +1,245 @@
+classdef (Sealed = true) CompositeEngine < handle
+%%
+% @brief A native engine that generates and sums signal streams onto a
+%        common sample grid.
+%
+% Each stream is added from a descriptor (see
+% SignalGenerator.getStreamDescriptor()), after which the engine
+% reproduces the stream entirely in native code: code and data symbol
+% lookup, time dilation, power scaling, Doppler and FDMA carrier rotation,
+% nearest-lower-neighbor resampling and accumulation. This replaces one
+% round trip through the MATLAB signal generator objects per stream per
+% chunk with a single call per chunk.
+%
+% With direct synthesis, the chip-rate generation and resampling steps are
+% skipped: each output sample's signal time is found by inverting the
+% stream's signal time profile, and its chip and data symbol are looked up
+% directly, in a single pass at the output rate.
+%
+% Streams are rendered in parallel, and then summed in a fixed order, so the
+% output is identical for any number of threads. The sum is always
+% accumulated in double precision, but may be returned in single precision
+% (see setSampleClass()) to halve the memory traffic of the later stages.
+%
+% @note
+% The Doppler and FDMA carrier phases are continuous from one render() call
+% to the next. This class wraps a core MEX function, which must be compiled
+% with make.m.
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        sampling_rate; % The output sampling rate (in samples/sec).
+        num_streams; % The number of streams added.
+        num_threads; % The number of threads used to render.
+        % True if streams are synthesized directly at the output rate.
+        direct_synthesis;
+        % The number of output samples rendered per stream at a time, or
+        % empty for the native default (see setBlockSize()).
+        block_size;
+        % True if the time spent on each stream is measured (see
+        % setProfiling()).
+        profiling;
+        % The class of the rendered samples, 'double' or 'single' (see
+        % setSampleClass()).
+        sample_class;
+    end
+
+    properties (Access = private)
+        engine_handle; % The uint64 handle to the native engine.
+    end
+
+    methods (Access = public)
+        function obj = CompositeEngine(sampling_rate, time_offset, ...
+                                       num_threads, direct_synthesis)
+        %%
+        % @brief Create an engine with no streams.
+        %
+        % @par Usage
+        % obj = CompositeEngine(sampling_rate, time_offset)
+        % obj = CompositeEngine(sampling_rate, time_offset, num_threads)
+        % obj = CompositeEngine(sampling_rate, time_offset, num_threads, ...
+        %                       direct_synthesis)
+        %
+        % @param[in] sampling_rate The output sampling rate (in
+        %            samples/sec). Output sample @c n is at time
+        %            <c>n / sampling_rate</c>.
+        % @param[in] time_offset An offset added to the true time of every
+        %            stream sample (in sec), such as the negated group delay
+        %            of a downsampling filter.
+        % @param[in] num_threads The number of threads to render with.
+        %            Defaults to maxNumCompThreads().
+        % @param[in] direct_synthesis If true, synthesize each stream
+        %            directly at the output rate from its inverted signal
+        %            time profile, rather than generating chip-rate samples
+        %            and resampling them. The power and Doppler profiles are
+        %            then evaluated at each output sample rather than held
+        %            over each chip. Defaults to false.
+        %
+        % @param[out] obj The created instance.
+            if nargin < 3 || isempty(num_threads)
+                num_threads = maxNumCompThreads();
+            end
+            if nargin < 4
+                direct_synthesis = false;
+            end
+            validateattributes(sampling_rate, {'numeric'}, ...
+                               {'scalar', 'positive'});
+            validateattributes(time_offset, {'numeric'}, {'scalar'});
+            validateattributes(num_threads, {'numeric'}, ...
+                               {'scalar', 'integer', 'positive'});
+            validateattributes(direct_synthesis, {'logical', 'numeric'}, ...
+                               {'scalar'});
+            obj.sampling_rate = sampling_rate;
+            obj.num_streams = 0;
+            obj.num_threads = num_threads;
+            obj.direct_synthesis = logical(direct_synthesis);
+            obj.block_size = [];
+            obj.profiling = false;
+            obj.sample_class = 'double';
+            obj.engine_handle = compositeEngineCore('create', ...
+                                                    double(sampling_rate), ...
+                                                    double(time_offset), ...
+                                                    double(num_threads), ...
+                                                    double(direct_synthesis));
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native engine.
+        %
+        % @param[in] obj The instance of the class.
+            if ~isempty(obj.engine_handle)
+                compositeEngineCore('free', obj.engine_handle);
+            end
+        end
+
+        function addStream(obj, descriptor, fdma_offset, fdma_phase, ...
+                           first_sample)
+        %%
+        % @brief Add a stream to the engine.
+        %
+        % @par Usage
+        % obj.addStream(descriptor, fdma_offset, fdma_phase, first_sample)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] descriptor The stream descriptor, from
+        %            SignalGenerator.getStreamDescriptor().
+        % @param[in] fdma_offset The FDMA offset (in Hz).
+        % @param[in] fdma_phase The FDMA carrier phase (in rad) at output
+        %            sample @c first_sample.
+        % @param[in] first_sample The zero-indexed output sample at which
+        %            the stream is added.
+            validateattributes(descriptor, {'struct'}, {'scalar'});
+            compositeEngineCore('add_stream', obj.engine_handle, ...
+                                descriptor, double(fdma_offset), ...
+                                double(fdma_phase), double(first_sample));
+            obj.num_streams = obj.num_streams + 1;
+        end
+
+        function setBlockSize(obj, block_size)
+        %%
+        % @brief Set the number of output samples rendered per stream at a
+        %        time.
+        %
+        % Each stream renders a block into its own buffer before the buffers
+        % are summed, so blocks small enough for the buffers of every stream
+        % to stay in cache are summed without a round trip through memory.
+        % The output depends on the block size only through rounding.
+        %
+        % @par Usage
+        % obj.setBlockSize(block_size)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] block_size The number of output samples per block.
+            validateattributes(block_size, {'numeric'}, ...
+                               {'scalar', 'integer', 'positive'});
+            compositeEngineCore('set_block_size', obj.engine_handle, ...
+                                double(block_size));
+            obj.block_size = block_size;
+        end
+
+        function setProfiling(obj, profiling)
+        %%
+        % @brief Enable or disable timing of each stream's rendering and of
+        %        the summation.
+        %
+        % Timing reads the clock twice per stream per block. Disabling it
+        % keeps the statistics gathered so far.
+        %
+        % @par Usage
+        % obj.setProfiling(profiling)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] profiling True to enable timing.
+            validateattributes(profiling, {'logical', 'numeric'}, ...
+                               {'scalar'});
+            compositeEngineCore('set_profiling', obj.engine_handle, ...
+                                double(profiling));
+            obj.profiling = logical(profiling);
+        end
+
+        function setSampleClass(obj, class_name)
+        %%
+        % @brief Set the class of the rendered samples.
+        %
+        % The streams are summed in double precision either way; 'single'
+        % only rounds the sum when it is stored, to a relative error of
+        % <c>eps('single')</c>, far below the thermal noise later added.
+        %
+        % @par Usage
+        % obj.setSampleClass(class_name)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] class_name 'double' (the default) or 'single'.
+            obj.sample_class = validatestring(class_name, ...
+                                              {'double', 'single'});
+        end
+
+        function statistics = getStatistics(obj)
+        %%
+        % @brief Get the time spent rendering while profiling.
+        %
+        % @par Usage
+        % statistics = obj.getStatistics()
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] statistics A struct with fields:
+        %             - @c stream_blocks, @c stream_seconds,
+        %               @c stream_samples: Column vectors of the number of
+        %               blocks, cumulative time (in sec) and output samples
+        %               rendered for each stream, in the order added.
+        %             - @c sum_blocks, @c sum_seconds, @c sum_samples: The
+        %               same, for summing the streams.
+            statistics = compositeEngineCore('statistics', obj.engine_handle);
+        end
+
+        function samples = render(obj, first_sample, num_samples)
+        %%
+        % @brief Render the sum of all streams.
+        %
+        % @par Usage
+        % samples = obj.render(first_sample, num_samples)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] first_sample The zero-indexed first output sample. Must
+        %            not precede the samples of the previous call.
+        % @param[in] num_samples The number of output samples.
+        %
+        % @param[out] samples The complex column vector of summed samples,
+        %             of class @c sample_class.
+            samples = compositeEngineCore('render', obj.engine_handle, ...
+                                          double(first_sample), ...
+                                          double(num_samples), ...
+                                          double(strcmp(obj.sample_class, ...
+                                                        'single')));
+        end
+    end
+end
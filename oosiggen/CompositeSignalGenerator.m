@@ -16,26 +16,60 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
 
     properties (SetAccess = private)
         signal_generators; % Cell array of signal generators.
-        % A map from the signal generator indices to their Frequency-Division
-        % Multiple-Access (FDMA) frequencies (in Hz).
+        % The Frequency-Division Multiple-Access (FDMA) frequency of each
+        % signal generator (in Hz), indexed as signal_generators.
         signal_generator_fdma_offsets;
-        % A map from the signal generator indices to the current FDMA carrier 
-        % phase (in rad).
+        % The current FDMA carrier phase of each signal generator (in rad),
+        % indexed as signal_generators.
         signal_generator_fdma_carrier_phases;
+        % The high-rate sample at which each signal generator was added,
+        % where its FDMA carrier phase is zero.
+        signal_generator_fdma_references;
         % Cell array of data buffers for each signal generator.
         signal_data_buffers;
         % Cell array of time axis buffers for each signal generator
         signal_time_axis_buffers;
+        % Cell array of StreamingResampler instances for each signal generator
+        % that uses nearest-neighbor interpolation (empty for the others).
+        signal_resamplers;
         sampling_rate; % The sampling rate (in samples/sec).
         sampling_rate_high; % The high sampling rate (in samples/sec).
         sample_counter_hr; % The current sample (in terms of oversampling rate).
         ds_filter_b; % The downsampling FIR filter coefficients (see filter()).
         ds_filter_order; % The order of the downsampling FIR filter.
-        ds_filter_state; % The downsampling filter state (see filter()).
+        ds_decimator; % The downsampling filter (see PolyphaseDecimator).
         ds_filter_delay; % Group delay of downsampling filter in seconds.
         ds_filter_alpha; % The alpha parameter for downsampling filter design.
         oversample_ratio; % Oversampling ratio; must be a positive integer.
         using_oversampling; % True if using oversampling (ratio ~= 1).
+        % True if supported signal generators are run by the native
+        % CompositeEngine (see setUseNativeEngine()).
+        use_native_engine;
+        % True if the native engine synthesizes its streams directly at the
+        % output rate (see setUseNativeEngine()).
+        use_direct_synthesis;
+        % The native engine's block size (in high-rate samples), or empty
+        % for its default (see setNativeBlockSize()).
+        native_block_size;
+        % The class of the native engine's summed samples, 'double' or
+        % 'single' (see setNativeSampleClass()).
+        native_sample_class;
+        % The relative amplitude error allowed to every signal generator, or
+        % empty to leave each its own (see setAmplitudeTolerance()).
+        amplitude_tolerance;
+    end
+    
+    properties (Access = private)
+        native_engine; % The CompositeEngine instance, if in use.
+        % Logical array; true for each signal generator run by the native
+        % engine rather than in MATLAB.
+        native_stream_flags;
+        % The enabled PipelineProfiler that times each stage, or empty (see
+        % setProfiler()).
+        profiler;
+        % Cell array of the label of each signal generator in profiler stage
+        % names.
+        stream_labels;
     end
     
     methods (Access = public)
@@ -89,7 +123,20 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
                                {'scalar', 'positive'});
             obj.signal_generators = {};
             obj.signal_data_buffers = {};
+            obj.signal_time_axis_buffers = {};
+            obj.signal_resamplers = {};
+            obj.signal_generator_fdma_offsets = zeros(1, 0);
+            obj.signal_generator_fdma_carrier_phases = zeros(1, 0);
+            obj.signal_generator_fdma_references = uint64([]);
             obj.sample_counter_hr = uint64(0);
+            obj.use_native_engine = false;
+            obj.use_direct_synthesis = false;
+            obj.native_block_size = [];
+            obj.native_sample_class = 'double';
+            obj.amplitude_tolerance = [];
+            obj.native_stream_flags = false(1, 0);
+            obj.profiler = [];
+            obj.stream_labels = {};
             if nargin == 1
                 obj.oversample_ratio = 4;
                 obj.ds_filter_order = 60;
@@ -123,21 +170,11 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
                 obj.ds_filter_b = fir1(obj.ds_filter_order, ...
                                        obj.ds_filter_alpha / ...
                                        obj.oversample_ratio);
-                obj.ds_filter_state = zeros(obj.ds_filter_order, 1);
+                obj.ds_decimator = PolyphaseDecimator(obj.ds_filter_b, ...
+                                                      obj.oversample_ratio);
                 obj.ds_filter_delay = mean(grpdelay(obj.ds_filter_b)) / ...
                                       (obj.oversample_ratio * obj.sampling_rate);
             end
-            
-            % Instantiate map object (double->double). This maps the signal
-            % generator index to the FDMA offset (in Hz) for that signal
-            % generator.
-            obj.signal_generator_fdma_offsets = ...
-                containers.Map('KeyType', 'double', 'ValueType', 'double');
-            
-            % Instantiate map object (double->double). This maps the signal
-            % generator index to the current FDMA carrier phase (in rad).
-            obj.signal_generator_fdma_carrier_phases = ...
-                containers.Map('KeyType', 'double', 'ValueType', 'double');
         end
         
         function [time_vector, samples] = getSamples(obj, duration)
@@ -174,6 +211,7 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
                 double(obj.sample_counter_hr:(obj.sample_counter_hr + ...
                                               num_samples_hr - 1)).' / ...
                 obj.sampling_rate_high;
+            first_sample_hr = obj.sample_counter_hr;
 
             % Update sample counters.
             obj.sample_counter_hr = obj.sample_counter_hr + num_samples_hr;
@@ -182,104 +220,95 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
             % due to time dilation, the time axes returned for each
             % SignalGenerator may be different. Before interpolating and adding
             % each signal into the composite output, ensure that the data
-            % vectors for each signal generator cover the entire time output
-            % (@c time_min, @c time_max).
-            time_min = time_vector_hr(1);
-            time_max = time_vector_hr(end);
-            samples_hr = zeros(num_samples_hr, 1);
-            for sig_idx = 1:numel(obj.signal_generators)
-                
-                % Trim off old, unneeded data from current buffer.
-                remove_idx = obj.signal_time_axis_buffers{sig_idx} < time_min;
-                obj.signal_time_axis_buffers{sig_idx}(remove_idx) = [];
-                obj.signal_data_buffers{sig_idx}(remove_idx) = [];
-                
-                % Add samples until the signal time axis buffer covers at least
-                % to the end of the true time axis.
-                done_generating_cur_signal = ...
-                    numel(obj.signal_time_axis_buffers{sig_idx}) > 0 && ...
-                    obj.signal_time_axis_buffers{sig_idx}(end) >= time_max;
-                while (~done_generating_cur_signal)
-                    
-                    % Add new data to buffers.
-                    [new_times, new_samples, stream_ended] = ...
-                        obj.signal_generators{sig_idx}.getSamples(duration);
-                    if obj.using_oversampling
-                        % If using oversampling subtract the filter delay from
-                        % the sample times so that the output times correspond
-                        % to the expected input observables times.
-                        new_times = new_times - obj.ds_filter_delay;
-                    end
-                    obj.signal_time_axis_buffers{sig_idx} = ...
-                        [obj.signal_time_axis_buffers{sig_idx}; new_times];
-                    obj.signal_data_buffers{sig_idx} = ...
-                        [obj.signal_data_buffers{sig_idx}; new_samples];
-                    
-                    % Check that the time axis is monotonically increasing;
-                    % if it isn't, something is wrong and we may be waiting in
-                    % this loop forever for the time to increase.
-                    %
-                    % This can happen, for example, if the user specifies a
-                    % signal time spline (in SignalGenerator) that is not
-                    % defined over the interval that is currently being
-                    % generated.
-                    if ~all(diff(obj.signal_time_axis_buffers{sig_idx}) > 0)
-                        error(['Signal time axis is not monotonically ' ...
-                               'increasing; exiting to prevent possible ' ...
-                               'infinite loop. Consider checking the ' ...
-                               'signal time spline for proper definition ' ...
-                               'over the desired duration.']);
-                    end
-                    
-                    % Check if enough data has been generated for current
-                    % result.
-                    done_generating_cur_signal = ...
-                        stream_ended || ...
-                        obj.signal_time_axis_buffers{sig_idx}(end) >= time_max;
+            % for each signal generator covers the entire output time axis.
+            %
+            % Signals run by the native engine are summed in a single call;
+            % any others are generated here.
+            profiler = obj.profiler;
+            if any(obj.native_stream_flags)
+                if ~isempty(profiler)
+                    t = profiler.start();
                 end
-                
-                % Interpolate current signal to common time axis.
-                if obj.signal_generators{sig_idx}.use_neighbor_interp
-                    cur_samples_hr = nonUniformResampleFast( ...
-                        obj.signal_time_axis_buffers{sig_idx}, ...
-                        obj.signal_data_buffers{sig_idx}, time_vector_hr);
+                samples_hr = obj.native_engine.render(first_sample_hr, ...
+                                                      num_samples_hr);
+                if ~isempty(profiler)
+                    profiler.stop('composite/native_render', t, ...
+                                  num_samples_hr, samples_hr);
+                    obj.recordNativeStatistics();
+                end
+            else
+                samples_hr = zeros(num_samples_hr, 1);
+            end
+            for sig_idx = find(~obj.native_stream_flags)
+                if ~isempty(profiler)
+                    label = obj.streamLabel(sig_idx);
+                    t = profiler.start();
+                end
+                signal_generator = obj.signal_generators{sig_idx};
+                if signal_generator.use_neighbor_interp
+                    cur_samples_hr = ...
+                        obj.getResampledSamples(sig_idx, time_vector_hr);
                 else
-                    cur_samples_hr = interp1( ...
-                        obj.signal_time_axis_buffers{sig_idx}, ...
-                        obj.signal_data_buffers{sig_idx}, time_vector_hr, ...
-                        'pchip');
+                    cur_samples_hr = ...
+                        obj.getInterpolatedSamples(sig_idx, time_vector_hr);
+                end
+                if ~isempty(profiler)
+                    profiler.stop([label '/total'], t, num_samples_hr, ...
+                                  cur_samples_hr);
                 end
                 
-                % Apply FDMA offset.
+                % Apply FDMA offset. The stored carrier phase is that of the
+                % next output sample, so the carrier is continuous across
+                % chunks.
                 fdma_offset = obj.signal_generator_fdma_offsets(sig_idx);
                 if (fdma_offset ~= 0)
-                    cur_carrier_phase = ...
-                        obj.signal_generator_fdma_carrier_phases(sig_idx);
-                    t_rel = time_vector_hr - time_vector_hr(1);
-                    carrier_phases = cur_carrier_phase + ...
-                                     2 * pi * t_rel * fdma_offset;
-                    cur_samples_hr = cur_samples_hr .* exp(1i * carrier_phases);
+                    if ~isempty(profiler)
+                        t = profiler.start();
+                    end
+                    fdma_cycles = fdma_offset / obj.sampling_rate_high;
+                    [cur_samples_hr, last_phase] = ncoRotate( ...
+                        cur_samples_hr, ...
+                        obj.signal_generator_fdma_carrier_phases(sig_idx), ...
+                        fdma_cycles);
                     obj.signal_generator_fdma_carrier_phases(sig_idx) = ...
-                        carrier_phases(end);
+                        mod(last_phase + 2 * pi * fdma_cycles, 2 * pi);
+                    if ~isempty(profiler)
+                        profiler.stop([label '/fdma'], t, num_samples_hr, ...
+                                      cur_samples_hr);
+                    end
                 end
                 
                 % Add current signal's samples to the running composite.
+                if ~isempty(profiler)
+                    t = profiler.start();
+                end
                 samples_hr = samples_hr + cur_samples_hr;
+                if ~isempty(profiler)
+                    profiler.stop('composite/sum', t, num_samples_hr, ...
+                                  samples_hr);
+                end
             end
             
             % If using oversampling, apply the anti-aliasing filter to the
             % oversampled data, downsample and return. Otherwise just return
             % the time/samples as-is.
             if obj.using_oversampling
-                % Anti-aliasing filter (before downsampling).
-                [samples_hr_filt, obj.ds_filter_state] = ...
-                    filter(obj.ds_filter_b, 1, samples_hr, obj.ds_filter_state);                
-                % Downsample.
-                time_vector = time_vector_hr(1:obj.oversample_ratio:end);
-                samples = samples_hr_filt(1:obj.oversample_ratio:end);
+                % Anti-aliasing filter and downsample, computing only the
+                % retained outputs. The decimation phase carries over between
+                % chunks.
+                if ~isempty(profiler)
+                    t = profiler.start();
+                end
+                [samples, offset] = obj.ds_decimator.process(samples_hr);
+                time_vector = ...
+                    time_vector_hr((offset + 1):obj.oversample_ratio:end);
+                if ~isempty(profiler)
+                    profiler.stop('composite/decimate', t, num_samples_hr, ...
+                                  samples, time_vector);
+                end
             else
                 time_vector = time_vector_hr;
-                samples = samples_hr;
+                samples = double(samples_hr);
             end
         end
 
@@ -313,6 +342,11 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
             obj.signal_generators{end + 1} = new_signal_generator;
             obj.signal_data_buffers{end + 1} = [];
             obj.signal_time_axis_buffers{end + 1} = [];
+            if new_signal_generator.use_neighbor_interp
+                obj.signal_resamplers{end + 1} = StreamingResampler();
+            else
+                obj.signal_resamplers{end + 1} = [];
+            end
             
             % Store the FDMA offset for this signal generator.
             signal_generator_index = numel(obj.signal_generators);
@@ -326,6 +360,482 @@ classdef (Sealed = true) CompositeSignalGenerator < handle
                 signal_generator_index) = fdma_offset;
             obj.signal_generator_fdma_carrier_phases(...
                 signal_generator_index) = 0;
+            obj.signal_generator_fdma_references(signal_generator_index) = ...
+                obj.sample_counter_hr;
+            
+            if ~isempty(obj.profiler)
+                new_signal_generator.setProfiler( ...
+                    obj.profiler, obj.streamLabel(signal_generator_index));
+            end
+            if ~isempty(obj.amplitude_tolerance)
+                new_signal_generator.setAmplitudeTolerance( ...
+                    obj.amplitude_tolerance);
+            end
+
+            obj.native_stream_flags(signal_generator_index) = false;
+            if obj.use_native_engine
+                obj.addNativeStream(signal_generator_index);
+            end
+        end
+        
+        function setUseNativeEngine(obj, use_native_engine, ...
+                                    use_direct_synthesis)
+        %%
+        % @brief Enable or disable the native composite engine.
+        %
+        % When enabled, every signal generator that the engine supports (see
+        % SignalGenerator.getStreamDescriptor()) is run by a CompositeEngine,
+        % which generates and sums all of them in one native call per chunk.
+        % Unsupported signal generators, such as those using cubic
+        % interpolation, continue to be run in MATLAB and are added to the
+        % engine's output.
+        %
+        % With direct synthesis, the engine also skips the chip-rate buffers
+        % and resampling: each output sample's code phase is computed from
+        % the inverted signal time spline and the chip table is indexed at
+        % the output rate (see CompositeEngine).
+        %
+        % @note
+        % This must be set before the first call to getSamples(). Both the
+        % engine and the MATLAB path carry the Doppler and FDMA carrier
+        % phases continuously across chunk boundaries.
+        %
+        % @par Usage
+        % obj.setUseNativeEngine(use_native_engine)
+        % obj.setUseNativeEngine(use_native_engine, use_direct_synthesis)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] use_native_engine If true, use the native engine.
+        % @param[in] use_direct_synthesis If true, the native engine
+        %            synthesizes its streams directly at the output rate.
+        %            Defaults to false.
+            if nargin < 3
+                use_direct_synthesis = false;
+            end
+            validateattributes(use_native_engine, {'logical'}, {'scalar'});
+            validateattributes(use_direct_synthesis, {'logical'}, {'scalar'});
+            if obj.sample_counter_hr ~= 0
+                error(['The native engine must be selected before samples ' ...
+                       'are generated.']);
+            end
+            obj.use_native_engine = use_native_engine;
+            obj.use_direct_synthesis = use_native_engine && ...
+                                       use_direct_synthesis;
+            obj.createNativeEngine();
+        end
+
+        function seek(obj, time)
+        %%
+        % @brief Position the generator so that the next call to
+        %        getSamples() starts at a given time, without generating the
+        %        samples before it.
+        %
+        % Every signal generator is positioned directly from its profiles
+        % and code periods (see SignalGenerator.seek()), the FDMA carrier
+        % phases are computed from the sample index, and the native engine,
+        % if in use, is rebuilt from the repositioned signal generators, so
+        % the cost does not depend on @c time. When oversampling, the
+        % downsampling filter's history is then rebuilt by generating the
+        % span of the filter just before @c time, so that the output matches
+        % that of an unbroken run to within the rounding of the carrier
+        % phases.
+        %
+        % @par Usage
+        % obj.seek(time)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] time The true time (in sec), which is rounded to the
+        %            nearest output sample. Must be non-negative.
+            validateattributes(time, {'numeric'}, ...
+                               {'scalar', 'real', 'nonnegative'});
+            
+            % Seek to an output sample, so that the decimation phase is that
+            % of an unbroken run.
+            target_sample_hr = round(time * obj.sampling_rate) * ...
+                               obj.oversample_ratio;
+            num_history_hr = 0;
+            stream_time_offset = 0;
+            if obj.using_oversampling
+                filter_span = ceil((numel(obj.ds_filter_b) - 1) / ...
+                                   obj.oversample_ratio) * ...
+                              obj.oversample_ratio;
+                num_history_hr = min(target_sample_hr, filter_span);
+                % The stream times are shifted by the filter delay (see
+                % getStreamSamples()).
+                stream_time_offset = obj.ds_filter_delay;
+            end
+            first_sample_hr = target_sample_hr - num_history_hr;
+            
+            stream_time = first_sample_hr / obj.sampling_rate_high + ...
+                          stream_time_offset;
+            for sig_idx = 1:numel(obj.signal_generators)
+                signal_generator = obj.signal_generators{sig_idx};
+                signal_generator.seek(stream_time);
+                obj.signal_data_buffers{sig_idx} = [];
+                obj.signal_time_axis_buffers{sig_idx} = [];
+                if signal_generator.use_neighbor_interp
+                    obj.signal_resamplers{sig_idx} = StreamingResampler();
+                end
+                obj.signal_generator_fdma_carrier_phases(sig_idx) = ...
+                    CompositeSignalGenerator.fdmaPhase( ...
+                        obj.signal_generator_fdma_offsets(sig_idx) / ...
+                        obj.sampling_rate_high, ...
+                        first_sample_hr - ...
+                        double(obj.signal_generator_fdma_references(sig_idx)));
+            end
+            obj.sample_counter_hr = uint64(first_sample_hr);
+            
+            if obj.using_oversampling
+                obj.ds_decimator = PolyphaseDecimator(obj.ds_filter_b, ...
+                                                      obj.oversample_ratio);
+            end
+            obj.createNativeEngine();
+            if num_history_hr > 0
+                obj.getSamples((num_history_hr + 0.5) / ...
+                               obj.sampling_rate_high);
+            end
+        end
+
+        function setNativeBlockSize(obj, block_size)
+        %%
+        % @brief Set the number of high-rate samples that the native engine
+        %        renders per stream at a time.
+        %
+        % This is independent of the duration requested from getSamples(),
+        % which only sets how much is returned per call; the output depends
+        % on either only through rounding. It may be set at any time, and is
+        % kept if the native engine is (re)selected.
+        %
+        % @par Usage
+        % obj.setNativeBlockSize(block_size)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] block_size The number of high-rate samples per block,
+        %            or empty for the default of engines created later.
+            if ~isempty(block_size)
+                validateattributes(block_size, {'numeric'}, ...
+                                   {'scalar', 'integer', 'positive'});
+            end
+            obj.native_block_size = block_size;
+            if ~isempty(obj.native_engine) && ~isempty(block_size)
+                obj.native_engine.setBlockSize(block_size);
+            end
+        end
+
+        function setNativeSampleClass(obj, class_name)
+        %%
+        % @brief Set the class of the samples summed by the native engine.
+        %
+        % The engine accumulates in double precision either way; 'single'
+        % stores the sum in half the memory for the downsampling filter,
+        % which accepts it directly. Signals generated in MATLAB are then
+        % added in single precision. The samples returned by getSamples()
+        % are always double. It may be set at any time, and is kept if the
+        % native engine is (re)selected.
+        %
+        % @par Usage
+        % obj.setNativeSampleClass(class_name)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] class_name 'double' (the default) or 'single'.
+            obj.native_sample_class = validatestring(class_name, ...
+                                                     {'double', 'single'});
+            if ~isempty(obj.native_engine)
+                obj.native_engine.setSampleClass(obj.native_sample_class);
+            end
+        end
+
+        function setAmplitudeTolerance(obj, tolerance)
+        %%
+        % @brief Evaluate the power profile of every signal generator on a
+        %        coarse grid, within a relative amplitude error (see
+        %        SignalGenerator.setAmplitudeTolerance()).
+        %
+        % The tolerance also applies to signal generators added later, and
+        % to the streams of the native engine. It must be set before any
+        % samples are generated or the generator is positioned with seek().
+        %
+        % @par Usage
+        % obj.setAmplitudeTolerance(tolerance)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] tolerance The largest relative amplitude error, or zero
+        %            to evaluate the power profiles at every sample.
+            validateattributes(tolerance, {'numeric'}, ...
+                               {'scalar', 'real', 'nonnegative'});
+            if obj.sample_counter_hr > 0
+                error(['The amplitude tolerance must be set before ' ...
+                       'generating samples.']);
+            end
+            obj.amplitude_tolerance = tolerance;
+            for sig_idx = 1:numel(obj.signal_generators)
+                obj.signal_generators{sig_idx}.setAmplitudeTolerance( ...
+                    tolerance);
+            end
+            
+            % The native streams take the new grid when handed over again.
+            if ~isempty(obj.native_engine)
+                obj.createNativeEngine();
+            end
+        end
+        
+        function setProfiler(obj, profiler, stream_labels)
+        %%
+        % @brief Record the time spent in each stage of getSamples() with a
+        %        profiler.
+        %
+        % The stages are named after the signal generator they belong to,
+        % or 'composite' for the shared stages:
+        % - '<label>/native': Rendering a stream in the native engine.
+        % - '<label>/total': Generating and resampling a stream in MATLAB,
+        %   including its SignalGenerator stages (see
+        %   SignalGenerator.setProfiler()).
+        % - '<label>/fdma': Applying a MATLAB stream's FDMA offset.
+        % - 'composite/native_render': The call to the native engine.
+        % - 'composite/native_sum': Summing the native streams.
+        % - 'composite/sum': Adding the MATLAB streams.
+        % - 'composite/decimate': Filtering and downsampling.
+        %
+        % @par Usage
+        % obj.setProfiler(profiler)
+        % obj.setProfiler(profiler, stream_labels)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] profiler A PipelineProfiler, or empty to stop timing. A
+        %            disabled profiler is not kept.
+        % @param[in] stream_labels A cell array of the label of each signal
+        %            generator added so far. Defaults to 'signal <index>'.
+            if nargin < 3
+                stream_labels = {};
+            end
+            validateattributes(stream_labels, {'cell'}, {});
+            if ~isempty(profiler) && ~profiler.enabled
+                profiler = [];
+            end
+            obj.profiler = profiler;
+            obj.stream_labels = stream_labels;
+            for sig_idx = 1:numel(obj.signal_generators)
+                obj.signal_generators{sig_idx}.setProfiler( ...
+                    profiler, obj.streamLabel(sig_idx));
+            end
+            if ~isempty(obj.native_engine)
+                obj.native_engine.setProfiling(~isempty(profiler));
+            end
+        end
+    end
+
+    methods (Access = private)
+        function label = streamLabel(obj, sig_idx)
+        %%
+        % @brief The label of a signal generator in profiler stage names.
+            if sig_idx <= numel(obj.stream_labels) && ...
+                    ~isempty(obj.stream_labels{sig_idx})
+                label = char(obj.stream_labels{sig_idx});
+            else
+                label = sprintf('signal %d', sig_idx);
+            end
+        end
+
+        function createNativeEngine(obj)
+        %%
+        % @brief Create the native engine, if selected, and hand it every
+        %        signal generator it supports at their current positions.
+        %
+        % @param[in] obj The instance of the class.
+            obj.native_stream_flags = false(1, numel(obj.signal_generators));
+            obj.native_engine = [];
+            if ~obj.use_native_engine
+                return;
+            end
+            time_offset = 0;
+            if obj.using_oversampling
+                % Match the filter delay compensation of the MATLAB path (see
+                % getStreamSamples()).
+                time_offset = -obj.ds_filter_delay;
+            end
+            obj.native_engine = CompositeEngine(obj.sampling_rate_high, ...
+                                                time_offset, [], ...
+                                                obj.use_direct_synthesis);
+            if ~isempty(obj.native_block_size)
+                obj.native_engine.setBlockSize(obj.native_block_size);
+            end
+            obj.native_engine.setSampleClass(obj.native_sample_class);
+            obj.native_engine.setProfiling(~isempty(obj.profiler));
+            for sig_idx = 1:numel(obj.signal_generators)
+                obj.addNativeStream(sig_idx);
+            end
+        end
+
+        function recordNativeStatistics(obj)
+        %%
+        % @brief Copy the native engine's cumulative per-stream times to the
+        %        profiler.
+            statistics = obj.native_engine.getStatistics();
+            native_indices = find(obj.native_stream_flags);
+            for stream_idx = 1:numel(native_indices)
+                obj.profiler.setTotals( ...
+                    [obj.streamLabel(native_indices(stream_idx)) '/native'], ...
+                    statistics.stream_blocks(stream_idx), ...
+                    statistics.stream_seconds(stream_idx), ...
+                    statistics.stream_samples(stream_idx));
+            end
+            obj.profiler.setTotals('composite/native_sum', ...
+                                   statistics.sum_blocks, ...
+                                   statistics.sum_seconds, ...
+                                   statistics.sum_samples);
+        end
+
+        function addNativeStream(obj, sig_idx)
+        %%
+        % @brief Hand a signal generator over to the native engine, if the
+        %        engine supports it.
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] sig_idx The index of the signal generator.
+            descriptor = obj.signal_generators{sig_idx}.getStreamDescriptor();
+            if isempty(descriptor)
+                return;
+            end
+            obj.native_engine.addStream( ...
+                descriptor, obj.signal_generator_fdma_offsets(sig_idx), ...
+                obj.signal_generator_fdma_carrier_phases(sig_idx), ...
+                obj.sample_counter_hr);
+            obj.native_stream_flags(sig_idx) = true;
+        end
+
+        function [new_times, new_samples, stream_ended] = ...
+                getStreamSamples(obj, sig_idx, time_max, num_following)
+        %%
+        % @brief Get the next block of samples from a signal generator,
+        %        running to a time on the common time axis, with the sample
+        %        times shifted by the downsampling filter delay.
+        %
+        % The signal generator computes how many samples reach @c time_max
+        % from its inverse signal time profile (see
+        % SignalGenerator.coveringDuration()), so one call generates them.
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] sig_idx The index of the signal generator.
+        % @param[in] time_max The time the (shifted) samples must reach (in
+        %            sec).
+        % @param[in] num_following The number of samples wanted after the
+        %            first sample at or after @c time_max.
+        %
+        % @param[out] new_times The sample times (in sec).
+        % @param[out] new_samples The samples.
+        % @param[out] stream_ended True if the signal generator has no more
+        %             samples.
+            signal_generator = obj.signal_generators{sig_idx};
+            if obj.using_oversampling
+                time_max = time_max + obj.ds_filter_delay;
+            end
+            [new_times, new_samples, stream_ended] = ...
+                signal_generator.getSamples( ...
+                    signal_generator.coveringDuration(time_max, ...
+                                                      num_following));
+            if obj.using_oversampling
+                % If using oversampling subtract the filter delay from the
+                % sample times so that the output times correspond to the
+                % expected input observables times.
+                new_times = new_times - obj.ds_filter_delay;
+            end
+        end
+
+        function cur_samples_hr = getResampledSamples(obj, sig_idx, ...
+                                                      time_vector_hr)
+        %%
+        % @brief Get a signal's samples on the common time axis by
+        %        nearest-lower-neighbor interpolation.
+        %
+        % The signal's samples are held by a StreamingResampler, which
+        % validates that the time axis increases as each block is appended
+        % and keeps only the history needed for the current output block.
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] sig_idx The index of the signal generator.
+        % @param[in] time_vector_hr The common (oversampled) time axis.
+        %
+        % @param[out] cur_samples_hr The signal resampled at
+        %             @c time_vector_hr.
+            resampler = obj.signal_resamplers{sig_idx};
+            time_max = time_vector_hr(end);
+            
+            % Add the samples that cover the rest of the true time axis, if
+            % the resampler does not already.
+            last_time = resampler.getLastTime();
+            if ~resampler.finished && ...
+               (isempty(last_time) || last_time < time_max)
+                [new_times, new_samples, stream_ended] = ...
+                    obj.getStreamSamples(sig_idx, time_max, 0);
+                resampler.append(new_times, new_samples);
+                if stream_ended
+                    resampler.finish();
+                end
+            end
+            
+            cur_samples_hr = resampler.resample(time_vector_hr);
+        end
+
+        function cur_samples_hr = getInterpolatedSamples(obj, sig_idx, ...
+                                                         time_vector_hr)
+        %%
+        % @brief Get a signal's samples on the common time axis by pchip
+        %        interpolation of its buffered samples.
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] sig_idx The index of the signal generator.
+        % @param[in] time_vector_hr The common (oversampled) time axis.
+        %
+        % @param[out] cur_samples_hr The signal interpolated at
+        %             @c time_vector_hr.
+            time_min = time_vector_hr(1);
+            time_max = time_vector_hr(end);
+            
+            % Trim off old, unneeded data from current buffer.
+            remove_idx = obj.signal_time_axis_buffers{sig_idx} < time_min;
+            obj.signal_time_axis_buffers{sig_idx}(remove_idx) = [];
+            obj.signal_data_buffers{sig_idx}(remove_idx) = [];
+            
+            % Add the samples that cover the rest of the true time axis, and
+            % one more so that pchip has a neighbor on each side of
+            % time_max. The signal time profile was checked to increase when
+            % the signal generator was created, so the buffer stays in order.
+            if isempty(obj.signal_time_axis_buffers{sig_idx}) || ...
+               obj.signal_time_axis_buffers{sig_idx}(end) < time_max
+                [new_times, new_samples] = ...
+                    obj.getStreamSamples(sig_idx, time_max, 1);
+                obj.signal_time_axis_buffers{sig_idx} = ...
+                    [obj.signal_time_axis_buffers{sig_idx}; new_times];
+                obj.signal_data_buffers{sig_idx} = ...
+                    [obj.signal_data_buffers{sig_idx}; new_samples];
+            end
+            
+            cur_samples_hr = interp1(obj.signal_time_axis_buffers{sig_idx}, ...
+                                     obj.signal_data_buffers{sig_idx}, ...
+                                     time_vector_hr, 'pchip');
+        end
+    end
+
+    methods (Static, Access = private)
+        function phase = fdmaPhase(cycles_per_sample, num_samples)
+        %%
+        % @brief The carrier phase of a constant frequency after a number of
+        %        samples, wrapped to [0, 2*pi).
+        %
+        % The sample count is split so that the whole cycles are discarded
+        % before they can swamp the fraction, which keeps the phase accurate
+        % after the many samples of a long run.
+        %
+        % @param[in] cycles_per_sample The frequency (in cycles/sample).
+        % @param[in] num_samples The number of samples; may be negative.
+        %
+        % @param[out] phase The carrier phase (in rad).
+            split = 2^20;
+            high = floor(num_samples / split);
+            low = num_samples - high * split;
+            cycles = mod(mod(cycles_per_sample * split, 1) * high + ...
+                         cycles_per_sample * low, 1);
+            phase = 2 * pi * cycles;
         end
     end
 end
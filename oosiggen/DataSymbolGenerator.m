@@ -48,4 +48,43 @@ classdef DataSymbolGenerator < handle
         %
         % @param[out] symbol The data symbol.
     end
+    
+    methods (Access = public)
+        function descriptor = getStreamDescriptor(obj)
+        %%
+        % @brief Describe the remaining data symbols for the native composite
+        %        engine (see CompositeEngine).
+        %
+        % Symbol generators that the engine can reproduce natively override
+        % this function; the default returns empty.
+        %
+        % @par Usage
+        % descriptor = obj.getStreamDescriptor()
+        %
+        % @param[in] obj The class instance.
+        %
+        % @param[out] descriptor A struct with the field @c symbols, holding
+        %             the symbols still to be returned by getNextSymbol(),
+        %             after which the symbol is one; or empty if the generator
+        %             is not supported by the engine.
+            descriptor = [];
+        end
+
+        function seek(obj, symbol_index)
+        %%
+        % @brief Position the generator so that the next call to
+        %        getNextSymbol() returns the symbol at a given index.
+        %
+        % Symbol generators whose state can be computed directly from the
+        % symbol index override this function; the default raises an error.
+        %
+        % @par Usage
+        % obj.seek(symbol_index)
+        %
+        % @param[in] obj The class instance.
+        % @param[in] symbol_index The zero-indexed symbol, counted from the
+        %            first symbol returned after the generator was created.
+            error('%s does not support seek().', class(obj));
+        end
+    end
 end
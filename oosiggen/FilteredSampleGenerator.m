@@ -92,5 +92,34 @@ classdef FilteredSampleGenerator < SampleGenerator
                            obj.filter_state);
             end
         end
+        
+        function seek(obj, sample_index)
+        %%
+        % @brief Position the generator at a sample index from its start
+        %        (see SampleGenerator.seek()).
+        %
+        % Only FIR filters (a scalar @c filter_a) are supported: the filter
+        % state is rebuilt by filtering the source samples that precede
+        % @c sample_index, back as far as the filter's memory, which gives
+        % the state of an unbroken run. The source must also support seek().
+        %
+        % @par Usage
+        % obj.seek(sample_index)
+        %
+        % @param[in] obj The class instance.
+        % @param[in] sample_index The zero-indexed sample.
+            validateattributes(sample_index, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            if numel(obj.filter_a) ~= 1
+                error(['seek() is only supported for FIR filters ' ...
+                       '(scalar filter_a).']);
+            end
+            num_history = min(sample_index, numel(obj.filter_b) - 1);
+            obj.sample_generator.seek(sample_index - num_history);
+            obj.filter_state_initialized = false;
+            if num_history > 0
+                obj.getSamples(num_history);
+            end
+        end
     end
 end
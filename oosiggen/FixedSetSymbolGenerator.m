@@ -58,5 +58,37 @@ classdef FixedSetSymbolGenerator < DataSymbolGenerator
                 obj.symbol_idx = obj.symbol_idx + 1;
             end
         end
+        
+        function descriptor = getStreamDescriptor(obj)
+        %%
+        % @brief Describe the remaining data symbols for the native composite
+        %        engine (see DataSymbolGenerator.getStreamDescriptor()).
+        %
+        % @par Usage
+        % descriptor = obj.getStreamDescriptor()
+        %
+        % @param[in] obj The class instance.
+        %
+        % @param[out] descriptor The descriptor struct.
+            descriptor = struct('symbols', ...
+                                double(obj.symbols(obj.symbol_idx:end)));
+            descriptor.symbols = descriptor.symbols(:);
+        end
+
+        function seek(obj, symbol_index)
+        %%
+        % @brief Position the generator at a symbol (see
+        %        DataSymbolGenerator.seek()).
+        %
+        % @par Usage
+        % obj.seek(symbol_index)
+        %
+        % @param[in] obj The class instance.
+        % @param[in] symbol_index The zero-indexed symbol; symbols beyond the
+        %            end of the set are ones.
+            validateattributes(symbol_index, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            obj.symbol_idx = min(symbol_index, obj.num_symbols) + 1;
+        end
     end
 end
\ No newline at end of file
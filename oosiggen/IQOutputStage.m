@@ -0,0 +1,138 @@
+classdef (Sealed = true) IQOutputStage < handle
+%%
+% @brief Adds thermal noise to composite samples and quantizes them to
+%        interleaved I/Q for output.
+%
+% For each sample, noise with standard deviation
+% <c>sqrt(noise_density(t) * sampling_rate / 2)</c> per component is added,
+% the result is multiplied by @c scale_factor and converted to the output
+% data type (rounded and saturated, for int16), and the I and Q values are
+% interleaved. The spline lookup, noise generation, scaling and conversion
+% are fused into a single native pass over each block, with no intermediate
+% vectors.
+%
+% The noise is drawn from a counter-based (Philox) generator keyed by the
+% seed and indexed by the sample number from the start of the run, so the
+% output is reproducible from the seed, and independent of the chunk size
+% and of the number of threads.
+%
+% @note
+% This class wraps a core MEX function, which must be compiled with make.m.
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        sampling_rate; % The sampling rate (in samples/sec).
+        scale_factor; % The factor applied to the noisy samples.
+        seed; % The noise generator seed.
+        data_type; % The output data type, 'int16' or 'single'.
+    end
+
+    properties (Access = private)
+        stage_handle; % The uint64 handle to the native output stage.
+    end
+
+    methods (Access = public)
+        function obj = IQOutputStage(noise_density_pp, sampling_rate, ...
+                                     scale_factor, seed, data_type, ...
+                                     num_threads)
+        %%
+        % @brief Create an output stage.
+        %
+        % @par Usage
+        % obj = IQOutputStage(noise_density_pp, sampling_rate, ...
+        %                     scale_factor, seed, data_type)
+        % obj = IQOutputStage(noise_density_pp, sampling_rate, ...
+        %                     scale_factor, seed, data_type, num_threads)
+        %
+        % @param[in] noise_density_pp The noise power spectral density vs
+        %            time (in W/Hz vs sec), as a spline struct with @c breaks
+        %            and @c coefs fields (see ppval()). Negative values are
+        %            treated as zero.
+        % @param[in] sampling_rate The sampling rate (in samples/sec).
+        % @param[in] scale_factor The factor applied to the noisy samples.
+        % @param[in] seed The noise generator seed, a non-negative integer.
+        % @param[in] data_type The output data type, 'int16' or 'single'.
+        % @param[in] num_threads The number of threads to process with.
+        %            Defaults to maxNumCompThreads().
+        %
+        % @param[out] obj The created instance.
+            if nargin < 6
+                num_threads = maxNumCompThreads();
+            end
+            validateattributes(noise_density_pp, {'struct'}, {'scalar'});
+            validateattributes(sampling_rate, {'numeric'}, ...
+                               {'scalar', 'positive'});
+            validateattributes(scale_factor, {'numeric'}, {'scalar'});
+            validateattributes(seed, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            data_type = validatestring(data_type, {'int16', 'single'});
+            validateattributes(num_threads, {'numeric'}, ...
+                               {'scalar', 'integer', 'positive'});
+            obj.sampling_rate = sampling_rate;
+            obj.scale_factor = scale_factor;
+            obj.seed = seed;
+            obj.data_type = data_type;
+            obj.stage_handle = iqOutputStageCore('create', ...
+                double(noise_density_pp.breaks(:).'), ...
+                double(noise_density_pp.coefs), double(sampling_rate), ...
+                double(scale_factor), double(seed), data_type, ...
+                double(num_threads));
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native output stage.
+        %
+        % @param[in] obj The instance of the class.
+            if ~isempty(obj.stage_handle)
+                iqOutputStageCore('free', obj.stage_handle);
+            end
+        end
+
+        function data_iq = process(obj, time_vector, samples)
+        %%
+        % @brief Add noise to, scale and quantize the next block of samples.
+        %
+        % @par Usage
+        % data_iq = obj.process(time_vector, samples)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] time_vector The time of each sample (in sec). Must be a
+        %            real column vector.
+        % @param[in] samples The next block of samples. Must be a real or
+        %            complex column vector the size of @c time_vector.
+        %
+        % @param[out] data_iq The row vector of interleaved I/Q values, of
+        %             the output data type, ready for fwrite().
+            data_iq = iqOutputStageCore('process', obj.stage_handle, ...
+                                        time_vector, samples);
+        end
+
+        function seek(obj, sample_index)
+        %%
+        % @brief Set the sample that the next call to process() starts at.
+        %
+        % The noise of each sample depends only on the seed and the sample's
+        % index from the start of the run, so a run that starts part way
+        % through (see CompositeSignalGenerator.seek()) reproduces the noise
+        % of the corresponding samples of a run from the start.
+        %
+        % @par Usage
+        % obj.seek(sample_index)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] sample_index The zero-indexed sample, from the start of
+        %            the run, of the next sample to be processed.
+            validateattributes(sample_index, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            iqOutputStageCore('seek', obj.stage_handle, double(sample_index));
+        end
+    end
+end
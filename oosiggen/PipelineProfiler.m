@@ -0,0 +1,217 @@
+classdef (Sealed = true) PipelineProfiler < handle
+%%
+% @brief Accumulates the time, samples and output bytes of each stage of
+%        the sample generation pipeline.
+%
+% Each stage is timed between a call to start() and a call to stop(), which
+% add to the stage's number of calls, cumulative time, samples processed and
+% bytes of output allocated. Stages are named by strings such as
+% 'composite/decimate' or 'GPS L1CA PRN 5/doppler', so that the report
+% breaks the time down per stream as well as per stage. Statistics gathered
+% elsewhere, such as by the native CompositeEngine, are recorded with
+% setTotals(). Stages may nest: a stream's 'total' stage includes the time
+% of its other stages.
+%
+% A disabled profiler records nothing. The classes that accept a profiler
+% (see CompositeSignalGenerator.setProfiler()) discard a disabled one, so
+% that they skip their timing calls altogether.
+%
+% @par Usage
+% profiler = PipelineProfiler(enabled)
+% t = profiler.start();
+% ...
+% profiler.stop('output/write', t, num_samples, data);
+% profiler.writeJson('profile.json');
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        enabled; % True if stages are recorded.
+    end
+
+    properties (Access = private)
+        stage_indices; % A map from stage names to indices of the arrays.
+        stage_names; % The stage names, in the order first recorded.
+        calls; % The number of calls to each stage.
+        seconds; % The cumulative time of each stage (in sec).
+        samples; % The cumulative samples processed by each stage.
+        bytes; % The cumulative bytes of output allocated by each stage.
+        start_time; % The tic() value when the profiler was created.
+    end
+
+    methods (Access = public)
+        function obj = PipelineProfiler(enabled)
+        %%
+        % @brief Create a profiler with no stages.
+        %
+        % @par Usage
+        % obj = PipelineProfiler()
+        % obj = PipelineProfiler(enabled)
+        %
+        % @param[in] enabled True to record stages. Defaults to true.
+        %
+        % @param[out] obj The created instance.
+            if nargin < 1
+                enabled = true;
+            end
+            validateattributes(enabled, {'logical', 'numeric'}, {'scalar'});
+            obj.enabled = logical(enabled);
+            obj.stage_indices = containers.Map('KeyType', 'char', ...
+                                               'ValueType', 'double');
+            obj.stage_names = {};
+            obj.calls = [];
+            obj.seconds = [];
+            obj.samples = [];
+            obj.bytes = [];
+            obj.start_time = tic;
+        end
+
+        function t = start(obj)
+        %%
+        % @brief Start timing a stage.
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] t The timer value to pass to stop(), or empty if the
+        %             profiler is disabled.
+            if obj.enabled
+                t = tic;
+            else
+                t = [];
+            end
+        end
+
+        function stop(obj, stage, t, num_samples, varargin)
+        %%
+        % @brief Stop timing a stage, and add the call to its statistics.
+        %
+        % @par Usage
+        % obj.stop(stage, t, num_samples)
+        % obj.stop(stage, t, num_samples, output, ...)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] stage The stage name.
+        % @param[in] t The value returned by start().
+        % @param[in] num_samples The number of samples processed.
+        % @param[in] output The arrays that the stage allocated, if any, whose
+        %            sizes are added to the stage's bytes.
+            if ~obj.enabled
+                return;
+            end
+            elapsed = toc(t);
+            stage_idx = obj.stageIndex(stage);
+            obj.calls(stage_idx) = obj.calls(stage_idx) + 1;
+            obj.seconds(stage_idx) = obj.seconds(stage_idx) + elapsed;
+            obj.samples(stage_idx) = obj.samples(stage_idx) + num_samples;
+            for output_idx = 1:numel(varargin)
+                obj.bytes(stage_idx) = obj.bytes(stage_idx) + ...
+                    PipelineProfiler.arrayBytes(varargin{output_idx});
+            end
+        end
+
+        function setTotals(obj, stage, calls, seconds, samples)
+        %%
+        % @brief Set the cumulative statistics of a stage that is timed
+        %        elsewhere.
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] stage The stage name.
+        % @param[in] calls The number of calls, or of blocks processed.
+        % @param[in] seconds The cumulative time (in sec).
+        % @param[in] samples The cumulative samples processed.
+            if ~obj.enabled
+                return;
+            end
+            stage_idx = obj.stageIndex(stage);
+            obj.calls(stage_idx) = calls;
+            obj.seconds(stage_idx) = seconds;
+            obj.samples(stage_idx) = samples;
+        end
+
+        function report = getReport(obj)
+        %%
+        % @brief Get the statistics of every stage.
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] report A struct with fields:
+        %             - @c elapsed_seconds: The time since the profiler was
+        %               created (in sec).
+        %             - @c stages: A struct array with one element per
+        %               stage, in the order first recorded, with fields
+        %               @c name, @c calls, @c seconds, @c fraction (of
+        %               @c elapsed_seconds), @c samples,
+        %               @c samples_per_second and @c bytes.
+            report = struct();
+            report.elapsed_seconds = toc(obj.start_time);
+            rates = obj.samples ./ obj.seconds;
+            rates(obj.seconds <= 0) = 0;
+            report.stages = struct( ...
+                'name', obj.stage_names, ...
+                'calls', num2cell(obj.calls), ...
+                'seconds', num2cell(obj.seconds), ...
+                'fraction', num2cell(obj.seconds / ...
+                                     max(report.elapsed_seconds, eps)), ...
+                'samples', num2cell(obj.samples), ...
+                'samples_per_second', num2cell(rates), ...
+                'bytes', num2cell(obj.bytes));
+        end
+
+        function writeJson(obj, filename)
+        %%
+        % @brief Write the report (see getReport()) to a JSON file,
+        %        replacing any earlier contents.
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] filename The path of the JSON file.
+            fid = fopen(filename, 'w');
+            if fid == -1
+                error(['Could not open file: ' filename]);
+            end
+            fprintf(fid, '%s\n', jsonencode(obj.getReport()));
+            fclose(fid);
+        end
+    end
+
+    methods (Access = private)
+        function stage_idx = stageIndex(obj, stage)
+        %%
+        % @brief Get the index of a stage, adding it if it is new.
+            if isKey(obj.stage_indices, stage)
+                stage_idx = obj.stage_indices(stage);
+                return;
+            end
+            stage_idx = numel(obj.stage_names) + 1;
+            obj.stage_indices(stage) = stage_idx;
+            obj.stage_names{stage_idx} = stage;
+            obj.calls(stage_idx) = 0;
+            obj.seconds(stage_idx) = 0;
+            obj.samples(stage_idx) = 0;
+            obj.bytes(stage_idx) = 0;
+        end
+    end
+
+    methods (Static = true, Access = private)
+        function num_bytes = arrayBytes(data)
+        %%
+        % @brief The size of a numeric array's data (in bytes).
+            switch class(data)
+                case {'double', 'int64', 'uint64'}
+                    element_bytes = 8;
+                case {'single', 'int32', 'uint32'}
+                    element_bytes = 4;
+                case {'int16', 'uint16', 'char'}
+                    element_bytes = 2;
+                otherwise
+                    element_bytes = 1;
+            end
+            num_bytes = numel(data) * element_bytes * (1 + ~isreal(data));
+        end
+    end
+end
@@ -0,0 +1,88 @@
+classdef (Sealed = true) PolyphaseDecimator < handle
+%%
+% @brief A stateful decimating FIR filter for signal streams that are
+%        generated in chunks.
+%
+% Processing a stream block by block with process() gives the same output as
+% <c>y = filter(b, 1, x)</c> followed by <c>y(1:factor:end)</c> over the
+% whole stream, but only the retained outputs are ever computed, so the cost
+% is divided by the downsampling factor. The filter history and the position
+% within the decimation cycle are kept in native memory across calls.
+%
+% @note
+% This class wraps a core MEX function, which must be compiled with make.m.
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        b; % The FIR filter coefficients (see filter()).
+        factor; % The downsampling factor.
+    end
+
+    properties (Access = private)
+        decimator_handle; % The uint64 handle to the native decimator.
+    end
+
+    methods (Access = public)
+        function obj = PolyphaseDecimator(b, factor)
+        %%
+        % @brief Create a decimator with a zero initial state.
+        %
+        % @par Usage
+        % obj = PolyphaseDecimator(b, factor)
+        %
+        % @param[in] b The FIR filter coefficients, as for filter().
+        % @param[in] factor The downsampling factor; must be a positive
+        %            integer.
+        %
+        % @param[out] obj The created instance.
+            validateattributes(b, {'numeric'}, ...
+                               {'vector', 'real', 'nonempty'});
+            validateattributes(factor, {'numeric'}, ...
+                               {'scalar', 'integer', 'positive'});
+            obj.b = b;
+            obj.factor = factor;
+            obj.decimator_handle = polyphaseDecimatorCore('create', ...
+                                                          double(b), ...
+                                                          double(factor));
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native decimator.
+        %
+        % @param[in] obj The instance of the class.
+            if ~isempty(obj.decimator_handle)
+                polyphaseDecimatorCore('free', obj.decimator_handle);
+            end
+        end
+
+        function [y, offset] = process(obj, x)
+        %%
+        % @brief Filter and decimate the next block of the stream.
+        %
+        % @par Usage
+        % y = obj.process(x)
+        % [y, offset] = obj.process(x)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] x The next block of input samples. Must be a real or
+        %            complex column vector of class double or single; the
+        %            output is double either way.
+        %
+        % @param[out] y The filtered and decimated output; complex if any
+        %             complex input has been processed.
+        % @param[out] offset The zero-indexed position within @c x of the
+        %             input sample that produced <c>y(1)</c>; the outputs
+        %             correspond to <c>x(offset + 1:factor:end)</c>.
+            [y, offset] = polyphaseDecimatorCore('process', ...
+                                                 obj.decimator_handle, x);
+        end
+    end
+end
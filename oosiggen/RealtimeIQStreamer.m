@@ -0,0 +1,207 @@
+classdef (Sealed = true) RealtimeIQStreamer < handle
+%%
+% @brief Streams IQ samples live to a network or SDR sink, paced at the
+%        sample rate, in place of writing an IQ file.
+%
+% Each call to write() copies the data into a lock-free ring and returns;
+% a native transmit thread sends it to the sink in packets, each due when
+% the samples before it would have played out in real time. Transmission
+% starts once the ring holds a prefill, which sets the latency from
+% generation to the sink and the margin against slow chunks. write() only
+% waits while the ring is full, so generation runs at most one ring ahead
+% of real time.
+%
+% If generation falls behind and the ring runs dry, the underrun is counted
+% and zeros are sent in place of the missing samples, keeping the
+% receiver's sample clock continuous. getStatistics() and
+% printLatencyBudget() report the underruns and how much of the latency
+% budget was used.
+%
+% Destinations take the form <c>'udp://host:port'</c>: one UDP datagram
+% per packet, with no header, so the receiver sees the same byte stream as
+% an IQ file.
+%
+% @note
+% This class wraps a core MEX function, which must be compiled with make.m.
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        destination; % The sink, such as 'udp://host:port'.
+        sampling_rate; % The real-time sample rate (in samples/sec).
+        sample_bytes; % The size of one interleaved IQ sample (in bytes).
+        ring_seconds; % The capacity of the ring (in sec of samples).
+        prefill_seconds; % The samples queued before transmitting (in sec).
+        statistics = []; % The final counters, once closed.
+    end
+
+    properties (Access = private)
+        streamer_handle; % The uint64 handle to the native streamer.
+    end
+
+    methods (Access = public)
+        function obj = RealtimeIQStreamer(destination, sampling_rate, ...
+                                          sample_bytes, ring_seconds, ...
+                                          prefill_seconds, packet_bytes)
+        %%
+        % @brief Open a sink and start the transmit thread.
+        %
+        % @par Usage
+        % obj = RealtimeIQStreamer(destination, sampling_rate, sample_bytes)
+        % obj = RealtimeIQStreamer(destination, sampling_rate, ...
+        %                          sample_bytes, ring_seconds, ...
+        %                          prefill_seconds, packet_bytes)
+        %
+        % @param[in] destination The sink, such as 'udp://127.0.0.1:5000'.
+        % @param[in] sampling_rate The real-time sample rate (in
+        %            samples/sec).
+        % @param[in] sample_bytes The size of one interleaved IQ sample (in
+        %            bytes), such as 4 for int16 I/Q.
+        % @param[in] ring_seconds The capacity of the ring (in sec of
+        %            samples). Defaults to 1.
+        % @param[in] prefill_seconds The samples queued before transmission
+        %            starts (in sec); at most @c ring_seconds. Defaults to
+        %            half of @c ring_seconds.
+        % @param[in] packet_bytes The largest packet to send (in bytes), or
+        %            0 for the sink's default (one Ethernet frame for UDP).
+        %            Defaults to 0.
+        %
+        % @param[out] obj The created instance.
+            if nargin < 4
+                ring_seconds = 1.0;
+            end
+            if nargin < 5
+                prefill_seconds = ring_seconds / 2;
+            end
+            if nargin < 6
+                packet_bytes = 0;
+            end
+            validateattributes(destination, {'char', 'string'}, ...
+                               {'scalartext'});
+            validateattributes(sampling_rate, {'numeric'}, ...
+                               {'scalar', 'positive'});
+            validateattributes(sample_bytes, {'numeric'}, ...
+                               {'scalar', 'integer', 'positive'});
+            validateattributes(ring_seconds, {'numeric'}, ...
+                               {'scalar', 'positive'});
+            validateattributes(prefill_seconds, {'numeric'}, ...
+                               {'scalar', 'nonnegative', ...
+                                '<=', ring_seconds});
+            validateattributes(packet_bytes, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            obj.destination = char(destination);
+            obj.sampling_rate = sampling_rate;
+            obj.sample_bytes = sample_bytes;
+            obj.ring_seconds = ring_seconds;
+            obj.prefill_seconds = prefill_seconds;
+            byte_rate = sampling_rate * sample_bytes;
+            obj.streamer_handle = realtimeStreamerCore('create', ...
+                obj.destination, double(byte_rate), double(sample_bytes), ...
+                double(sample_bytes * ceil(ring_seconds * sampling_rate)), ...
+                double(sample_bytes * round(prefill_seconds * ...
+                                            sampling_rate)), ...
+                double(packet_bytes));
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native streamer, discarding any queued data.
+        %
+        % @param[in] obj The instance of the class.
+            if ~isempty(obj.streamer_handle)
+                realtimeStreamerCore('free', obj.streamer_handle);
+            end
+        end
+
+        function write(obj, data)
+        %%
+        % @brief Queue data for transmission.
+        %
+        % @par Usage
+        % obj.write(data)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] data A real numeric array, such as the output of
+        %            IQOutputStage.process(). Its elements are sent in
+        %            column-major order and native byte order.
+            realtimeStreamerCore('write', obj.streamer_handle, data);
+        end
+
+        function statistics = getStatistics(obj)
+        %%
+        % @brief Get the transmit counters.
+        %
+        % @par Usage
+        % statistics = obj.getStatistics()
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] statistics A struct with the fields
+        %             @c bytes_accepted, @c bytes_sent (including underrun
+        %             fill), @c packets_sent, @c underruns (the number of
+        %             times the ring ran dry), @c underrun_bytes, @c elapsed
+        %             (sec since transmission started), @c max_lateness (the
+        %             longest a packet was sent past its due time, in sec),
+        %             @c min_queued_bytes (the smallest ring fill while
+        %             writing) and @c packet_bytes.
+            if isempty(obj.streamer_handle)
+                statistics = obj.statistics;
+            else
+                statistics = realtimeStreamerCore('statistics', ...
+                                                  obj.streamer_handle);
+            end
+        end
+
+        function close(obj)
+        %%
+        % @brief Transmit the queued data, then stop.
+        %
+        % @par Usage
+        % obj.close()
+        %
+        % @param[in] obj The instance of the class.
+            obj.statistics = realtimeStreamerCore('close', ...
+                                                  obj.streamer_handle);
+            realtimeStreamerCore('free', obj.streamer_handle);
+            obj.streamer_handle = [];
+        end
+
+        function printLatencyBudget(obj)
+        %%
+        % @brief Print how the stream's latency budget was used.
+        %
+        % The prefill is the latency from generation to the sink and the
+        % budget for generation to run slower than real time; the smallest
+        % ring fill seen while writing is the part of it never used.
+        %
+        % @par Usage
+        % obj.printLatencyBudget()
+        %
+        % @param[in] obj The instance of the class.
+            statistics = obj.getStatistics();
+            byte_rate = obj.sampling_rate * obj.sample_bytes;
+            fprintf(['Streamed %.3f s to %s in %.3f s ' ...
+                     '(%d packets of %d B).\n'], ...
+                    statistics.bytes_sent / byte_rate, obj.destination, ...
+                    statistics.elapsed, statistics.packets_sent, ...
+                    statistics.packet_bytes);
+            fprintf('  Prefill latency:     %8.1f ms\n', ...
+                    1e3 * obj.prefill_seconds);
+            fprintf('  Minimum margin:      %8.1f ms\n', ...
+                    1e3 * statistics.min_queued_bytes / byte_rate);
+            fprintf('  Packet period:       %8.1f us\n', ...
+                    1e6 * statistics.packet_bytes / byte_rate);
+            fprintf('  Worst send lateness: %8.1f us\n', ...
+                    1e6 * statistics.max_lateness);
+            fprintf('  Underruns:           %8d (%.1f ms of zeros)\n', ...
+                    statistics.underruns, ...
+                    1e3 * statistics.underrun_bytes / byte_rate);
+        end
+    end
+end
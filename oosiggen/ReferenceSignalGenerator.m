@@ -155,6 +155,86 @@ classdef (Sealed = true) ReferenceSignalGenerator < handle
                 end
             end
         end
+        
+        function descriptor = getStreamDescriptor(obj)
+        %%
+        % @brief Describe this generator's output for the native composite
+        %        engine (see CompositeEngine).
+        %
+        % Only sample-and-hold streams are supported, and only at a segment
+        % boundary (for example, before the first call to getSamples()), so
+        % that the engine can take over at the start of a data symbol.
+        %
+        % @par Usage
+        % descriptor = obj.getStreamDescriptor()
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] descriptor The SampleGenerator.getStreamDescriptor()
+        %             struct, with the additional fields @c segment_length
+        %             (the number of samples per data symbol) and @c symbols
+        %             (see DataSymbolGenerator.getStreamDescriptor(); empty
+        %             if not using data); or empty if the generator is not
+        %             supported by the engine.
+            descriptor = [];
+            if ~obj.use_neighbor_interp || obj.segment_length < 1 || ...
+               obj.sample_index ~= obj.segment_length
+                return;
+            end
+            sample_descriptor = obj.sample_generator.getStreamDescriptor();
+            if isempty(sample_descriptor)
+                return;
+            end
+            sample_descriptor.segment_length = obj.segment_length;
+            if obj.use_data
+                symbol_descriptor = ...
+                    obj.data_symbol_generator.getStreamDescriptor();
+                if isempty(symbol_descriptor)
+                    return;
+                end
+                sample_descriptor.symbols = symbol_descriptor.symbols;
+            else
+                sample_descriptor.symbols = [];
+            end
+            descriptor = sample_descriptor;
+        end
+        
+        function segment_start = seek(obj, sample_index)
+        %%
+        % @brief Position the generator at the start of the segment (data
+        %        symbol) that contains a given sample.
+        %
+        % The sample and data symbol generators are positioned directly (see
+        % SampleGenerator.seek() and DataSymbolGenerator.seek()), so the cost
+        % does not depend on @c sample_index. Segments are generated whole,
+        % and a generator at a segment boundary can be handed to the native
+        % engine (see getStreamDescriptor()), so the generator is positioned
+        % at the boundary at or before @c sample_index rather than at the
+        % sample itself.
+        %
+        % @par Usage
+        % segment_start = obj.seek(sample_index)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] sample_index The zero-indexed sample, counted from the
+        %            first sample returned after the generator was created.
+        %
+        % @param[out] segment_start The zero-indexed sample that the next
+        %             call to getSamples() starts at.
+            validateattributes(sample_index, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            if obj.segment_length < 1
+                error('Cannot seek with a segment length of less than 1.');
+            end
+            segment_idx = floor(sample_index / obj.segment_length);
+            segment_start = segment_idx * obj.segment_length;
+            obj.sample_generator.seek(segment_start);
+            if obj.use_data
+                obj.data_symbol_generator.seek(segment_idx);
+            end
+            % As at creation, the "last" segment appears exhausted.
+            obj.sample_index = obj.segment_length;
+        end
     end
     
     methods (Access = private)
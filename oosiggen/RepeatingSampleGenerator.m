@@ -7,6 +7,15 @@ classdef RepeatingSampleGenerator < SampleGenerator
 % derived subclasses need only to specify their repeating sequence and sampling
 % rate.
 %
+% Sequences of +/-1 chips (any spreading code) are also held natively as one
+% bit per chip, and blocks are expanded from that compact copy with
+% wrap-around copies rather than a modular index gather; other sequences are
+% indexed in MATLAB.
+%
+% @note
+% The native chip source requires a core MEX function, which must be
+% compiled with make.m.
+%
 %
 % @copyright Copyright &copy; 2013 The %MITRE Corporation
 %
@@ -17,9 +26,15 @@ classdef RepeatingSampleGenerator < SampleGenerator
 % (DFARS) 252.227-7014 (JUN 1995)
     
     properties (Access = private)
-        samples_array; % The fixed samples array.
+        % The fixed samples array, or empty once it is held by the native
+        % chip source.
+        samples_array;
         current_chip_index; % The zero-indexed current @c samples_array pointer.
+        start_chip_index; % The zero-indexed initial @c samples_array pointer.
         samples_array_length; % The length of @c samples_array.
+        % The uint64 handle to the native packed chip source, or empty if the
+        % samples are not all +/-1.
+        chip_source_handle;
     end
     
     methods (Access = public)
@@ -66,6 +81,23 @@ classdef RepeatingSampleGenerator < SampleGenerator
                        'Must be 1-' num2str(obj.samples_array_length) '.']);
             end
             obj.current_chip_index = start_sample - 1; % Zero-indexed.
+            obj.start_chip_index = obj.current_chip_index;
+            if isa(samples_array, 'double') && isreal(samples_array) && ...
+               all(samples_array == 1 | samples_array == -1)
+                obj.chip_source_handle = ...
+                    chipSourceCore('create', samples_array);
+                obj.samples_array = []; % The packed copy replaces it.
+            end
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native chip source.
+        %
+        % @param[in] obj The class instance.
+            if ~isempty(obj.chip_source_handle)
+                chipSourceCore('free', obj.chip_source_handle);
+            end
         end
     end
     
@@ -89,12 +121,17 @@ classdef RepeatingSampleGenerator < SampleGenerator
             num_samples = round(num_samples); % Ensure an integer.
             validateattributes(num_samples, {'scalar', 'numeric'}, {'>', 0});
             
-            % Zero-indexed current_idxs.
-            current_idxs = (obj.current_chip_index) : ...
-                           (obj.current_chip_index + num_samples - 1);
-            current_idxs = mod(current_idxs, obj.samples_array_length);
+            if ~isempty(obj.chip_source_handle)
+                samples = chipSourceCore('expand', obj.chip_source_handle, ...
+                                         obj.current_chip_index, num_samples);
+            else
+                % Zero-indexed current_idxs.
+                current_idxs = (obj.current_chip_index) : ...
+                               (obj.current_chip_index + num_samples - 1);
+                current_idxs = mod(current_idxs, obj.samples_array_length);
             
-            samples = obj.samples_array(current_idxs + 1);
+                samples = obj.samples_array(current_idxs + 1);
+            end
             
             obj.current_chip_index = mod(obj.current_chip_index + num_samples, ...
                                          obj.samples_array_length);
@@ -115,5 +152,50 @@ classdef RepeatingSampleGenerator < SampleGenerator
             obj.current_chip_index = mod(obj.current_chip_index + num_samples, ...
                                          obj.samples_array_length);
         end
+        
+        function seek(obj, sample_index)
+        %%
+        % @brief Position the sample generator at a sample index from its
+        %        start (see SampleGenerator.seek()).
+        %
+        % @par Usage
+        % obj.seek(sample_index)
+        %
+        % @param[in] obj The class instance.
+        % @param[in] sample_index The zero-indexed sample, counted from
+        %            @c start_sample.
+            validateattributes(sample_index, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            obj.current_chip_index = ...
+                mod(obj.start_chip_index + ...
+                    mod(sample_index, obj.samples_array_length), ...
+                    obj.samples_array_length);
+        end
+        
+        function descriptor = getStreamDescriptor(obj)
+        %%
+        % @brief Describe this generator's output for the native composite
+        %        engine (see SampleGenerator.getStreamDescriptor()).
+        %
+        % @par Usage
+        % descriptor = obj.getStreamDescriptor()
+        %
+        % @param[in] obj The class instance.
+        %
+        % @param[out] descriptor The descriptor struct, or empty if the
+        %             samples are complex.
+            if ~isempty(obj.chip_source_handle)
+                chips = chipSourceCore('expand', obj.chip_source_handle, ...
+                                       0, obj.samples_array_length);
+            elseif isreal(obj.samples_array)
+                chips = double(obj.samples_array);
+            else
+                descriptor = [];
+                return;
+            end
+            descriptor = struct('chips', chips, ...
+                                'start_index', obj.current_chip_index, ...
+                                'chip_rate', obj.sampling_rate);
+        end
     end
 end
@@ -78,5 +78,44 @@ classdef SampleGenerator < handle
         % @param[out] sampling_rate The sampling rate (in samples/sec).
             sampling_rate = obj.sampling_rate;
         end
+        
+        function descriptor = getStreamDescriptor(obj)
+        %%
+        % @brief Describe this generator's output for the native composite
+        %        engine (see CompositeEngine).
+        %
+        % Generators that the engine can reproduce natively override this
+        % function; the default returns empty, which leaves the generator to
+        % be run in MATLAB.
+        %
+        % @par Usage
+        % descriptor = obj.getStreamDescriptor()
+        %
+        % @param[in] obj The class instance.
+        %
+        % @param[out] descriptor A struct with fields @c chips (the repeating
+        %             sample sequence), @c start_index (the zero-indexed
+        %             position of the next sample) and @c chip_rate (the
+        %             sampling rate, in samples/sec); or empty if the
+        %             generator is not supported by the engine.
+            descriptor = [];
+        end
+
+        function seek(obj, sample_index)
+        %%
+        % @brief Position the generator so that the next sample returned is
+        %        that at a given index from its start.
+        %
+        % Generators whose state can be computed directly from the sample
+        % index override this function; the default raises an error.
+        %
+        % @par Usage
+        % obj.seek(sample_index)
+        %
+        % @param[in] obj The class instance.
+        % @param[in] sample_index The zero-indexed sample, counted from the
+        %            first sample the generator returned after it was created.
+            error('%s does not support seek().', class(obj));
+        end
     end
 end
\ No newline at end of file
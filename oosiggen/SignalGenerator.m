@@ -31,12 +31,44 @@ classdef (Sealed = true) SignalGenerator < handle
         use_doppler_profile; % Flag, true if using Doppler profile.
         use_signal_time_profile; % Flag, true if using time dilation profile.
         signal_time; % The current reference signal time (in sec).
+        % The true-time spacing of the grid on which the amplitude is
+        % evaluated and then linearly interpolated (in sec), or zero to
+        % evaluate the power profile at every sample (see
+        % setAmplitudeTolerance()).
+        amplitude_interval;
         % If true, use last-neighbor interpolation when resampling this
         % generator's samples to another rate. Controlled by the member 
         % ReferenceSignalGenerator.
         use_neighbor_interp;
     end
     
+    properties (Access = private)
+        % Compiled spline handles (see ppvalCompile()) for the power, Doppler
+        % and signal time profiles, respectively. Empty if the profile is not
+        % used.
+        power_spline_handle;
+        doppler_spline_handle;
+        signal_time_spline_handle;
+        % The compiled inverse of the signal time profile, signal time vs
+        % true time (see signalTimeAt()); empty if the profile is not used.
+        signal_time_inverse_handle;
+        % The compiled antiderivative of the Doppler profile (see
+        % ppvalIntegrate()), the carrier phase vs true time (in cycles vs
+        % sec) modulo one cycle; empty if the Doppler profile is not used.
+        doppler_phase_spline_handle;
+        % The carrier phase at a true time is this plus 2*pi times the
+        % value of the Doppler phase spline (in rad).
+        phase_offset;
+        % The enabled PipelineProfiler that times each step of getSamples(),
+        % or empty (see setProfiler()).
+        profiler;
+        % The profiler stage name of each step, by step.
+        profile_stages;
+        % The breaks of the power profile in units of the amplitude
+        % interval, a column vector; empty without an amplitude interval.
+        amplitude_break_positions;
+    end
+    
     methods (Access = public)
         function obj = SignalGenerator(reference_signal_generator, ...
                                        power_spline, doppler_spline, ...
@@ -56,8 +88,8 @@ classdef (Sealed = true) SignalGenerator < handle
         % polynomials, in the format that is returned by the MATLAB 
         % spline() function (or interp1() by specifying the 'spline' 
         % interpolation method). They are only verified to the point that 
-        % the correct struct fields are present, and then are directly 
-        % passed to ppval() for evaluation.
+        % the correct struct fields are present, and then are compiled
+        % with ppvalCompile() for repeated evaluation.
         %
         % The convertToSignalTimeSpline() utility can be used to transform
         % a pseudorange spline (as m vs true time in sec) to a signal time
@@ -99,6 +131,7 @@ classdef (Sealed = true) SignalGenerator < handle
         % @param[out] obj The created instance.
             obj.signal_time = 0;
             obj.carrier_phase = 0;
+            obj.amplitude_interval = 0;
             obj.use_power_profile = false;
             obj.use_doppler_profile = false;
             obj.use_signal_time_profile = false;
@@ -162,10 +195,50 @@ classdef (Sealed = true) SignalGenerator < handle
                 validateattributes(obj.signal_time_spline, ...
                                    {'struct'}, {'scalar'});
                 if ~SignalGenerator.validateSplineStructFields(...
-                    obj.doppler_spline)
+                    obj.signal_time_spline)
                     error('Error validating time dilation spline.');
                 end
             end
+            
+            % Compile the profiles once, so per-chunk evaluation does not
+            % re-marshal the spline structs and resumes each bin search where
+            % the previous chunk left off.
+            if obj.use_power_profile
+                obj.power_spline_handle = ppvalCompile(obj.power_spline);
+            end
+            if obj.use_signal_time_profile
+                obj.signal_time_spline_handle = ...
+                    ppvalCompile(obj.signal_time_spline);
+                obj.signal_time_inverse_handle = ppvalCompile( ...
+                    SignalGenerator.invertSpline(obj.signal_time_spline));
+            end
+            
+            % The carrier phase is the closed-form integral of the Doppler
+            % profile, offset to the initial carrier phase at the first
+            % sample, so it has no integration error to accumulate.
+            obj.phase_offset = obj.carrier_phase;
+            if obj.use_doppler_profile
+                obj.doppler_spline_handle = ppvalCompile(obj.doppler_spline);
+                obj.doppler_phase_spline_handle = ...
+                    ppvalIntegrate(obj.doppler_spline_handle, 1);
+                obj.phase_offset = obj.carrier_phase - 2 * pi * ...
+                    ppvalEval(obj.doppler_phase_spline_handle, ...
+                              obj.trueTime(0));
+            end
+        end
+        
+        function delete(obj)
+        %%
+        % @brief Release the compiled spline handles.
+        %
+        % @param[in] obj The instance of the class.
+            handles = [obj.power_spline_handle, obj.doppler_spline_handle, ...
+                       obj.doppler_phase_spline_handle, ...
+                       obj.signal_time_spline_handle, ...
+                       obj.signal_time_inverse_handle];
+            if ~isempty(handles)
+                ppvalFree(handles);
+            end
         end
 
         function [time_vector, samples, stream_ended] = getSamples(obj, duration)
@@ -195,7 +268,15 @@ classdef (Sealed = true) SignalGenerator < handle
         %             generated. This can occur if using a signal time profile
         %             and the generated sample stream has exceeded the bounds
         %             over which the profile is defined.
+            profiler = obj.profiler;
+            if ~isempty(profiler)
+                t = profiler.start();
+            end
             samples = obj.reference_signal_generator.getSamples(duration);
+            if ~isempty(profiler)
+                profiler.stop(obj.profile_stages.reference, t, ...
+                              numel(samples), samples);
+            end
             ref_sample_period = ...
                 1 / obj.reference_signal_generator.sampling_rate;
             reference_signal_duration = numel(samples) * ref_sample_period;
@@ -213,8 +294,15 @@ classdef (Sealed = true) SignalGenerator < handle
                 samples = samples(idx);
                 reference_signal_duration = numel(samples) * ref_sample_period;
                 
-                time_vector = ppvalFast(obj.signal_time_spline, ...
+                if ~isempty(profiler)
+                    t = profiler.start();
+                end
+                time_vector = ppvalEval(obj.signal_time_spline_handle, ...
                                         signal_time_vector);
+                if ~isempty(profiler)
+                    profiler.stop(obj.profile_stages.signal_time, t, ...
+                                  numel(time_vector), time_vector);
+                end
             else
                 time_vector = signal_time_vector;
                 stream_ended = false;
@@ -229,29 +317,376 @@ classdef (Sealed = true) SignalGenerator < handle
             
             % Apply amplitude modulation specified by power spline.
             if (obj.use_power_profile)
-                samples = samples .* ...
-                          sqrt(ppvalFast(obj.power_spline, time_vector));
+                if ~isempty(profiler)
+                    t = profiler.start();
+                end
+                amplitude = obj.evaluateAmplitude(time_vector);
+                if ~isempty(profiler)
+                    profiler.stop(obj.profile_stages.profiles, t, ...
+                                  numel(time_vector), amplitude);
+                    t = profiler.start();
+                end
+                samples = samples .* amplitude;
+                if ~isempty(profiler)
+                    profiler.stop(obj.profile_stages.power, t, ...
+                                  numel(samples), samples);
+                end
             end
             
-            % Apply Doppler shift.
+            % Apply Doppler shift, from the carrier phase at each sample's
+            % true time. The phase spline is evaluated as the samples are
+            % rotated, so no Doppler or phase vector is formed, and the
+            % phase is continuous across chunks by construction.
             if (obj.use_doppler_profile)
-                doppler = ppvalFast(obj.doppler_spline, time_vector);
-                if(numel(time_vector) > 1)
-                    carrier_phases = ...
-                        obj.carrier_phase + ...
-                        2 * pi * cumtrapz(time_vector, doppler);
-                else
-                    carrier_phases = ...
-                        obj.carrier_phase + ...
-                        2 * pi * time_vector * doppler;
+                if ~isempty(profiler)
+                    t = profiler.start();
+                end
+                [samples, obj.carrier_phase] = ppvalRotate( ...
+                    obj.doppler_phase_spline_handle, samples, ...
+                    obj.phase_offset, time_vector);
+                if ~isempty(profiler)
+                    profiler.stop(obj.profile_stages.doppler, t, ...
+                                  numel(samples), samples);
                 end
-                samples = samples .* exp(1i * carrier_phases);
-                obj.carrier_phase = mod(carrier_phases(end), 2 * pi);
+            end
+        end
+        
+        function seek(obj, true_time)
+        %%
+        % @brief Position the generator at a true time, computing its state
+        %        directly rather than by generating the samples before it.
+        %
+        % The signal time of @c true_time is found from the inverse signal
+        % time profile (see signalTimeAt()), and the reference signal
+        % generator is positioned at the start of the segment (data symbol)
+        % containing the sample at or before it (see
+        % ReferenceSignalGenerator.seek()), so the samples that follow begin
+        % at or before @c true_time. The carrier phase is a closed-form
+        % function of true time, so the samples match those of an unbroken
+        % run.
+        %
+        % @par Usage
+        % obj.seek(true_time)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] true_time The true time (in sec). Times before the first
+        %            sample position the generator at its start.
+            validateattributes(true_time, {'numeric'}, {'scalar', 'real'});
+            ref_sample_rate = obj.reference_signal_generator.sampling_rate;
+            signal_time = obj.signalTimeAt(true_time);
+            
+            % Start a sample early, so that rounding at a sample boundary
+            % cannot skip the sample at or before true_time.
+            sample_index = max(0, floor(signal_time * ref_sample_rate) - 1);
+            sample_index = obj.reference_signal_generator.seek(sample_index);
+            obj.signal_time = sample_index / ref_sample_rate;
+            
+            obj.carrier_phase = obj.carrierPhaseAt(obj.signal_time);
+        end
+        
+        function duration = coveringDuration(obj, true_time, num_following)
+        %%
+        % @brief The duration to request from getSamples() so that the
+        %        samples returned reach a true time.
+        %
+        % The signal time of @c true_time comes from the inverse signal time
+        % profile (see signalTimeAt()), so the number of reference samples
+        % needed is known before any are generated. The samples returned run
+        % to the first sample at or after @c true_time, plus
+        % @c num_following samples, and up to one more to allow for
+        % rounding; they stop early at the end of the signal time profile
+        % (see getSamples()).
+        %
+        % @par Usage
+        % duration = obj.coveringDuration(true_time, num_following)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] true_time The true time to reach (in sec).
+        % @param[in] num_following The number of samples wanted after the
+        %            first sample at or after @c true_time, such as those an
+        %            interpolator needs.
+        %
+        % @param[out] duration The signal time duration (in sec) of a whole,
+        %             positive number of reference samples.
+            ref_sample_rate = obj.reference_signal_generator.sampling_rate;
+            num_samples = floor((obj.signalTimeAt(true_time) - ...
+                                 obj.signal_time) * ref_sample_rate) + ...
+                          2 + num_following;
+            duration = (max(num_samples, 1) + 0.5) / ref_sample_rate;
+        end
+        
+        function setAmplitudeTolerance(obj, tolerance)
+        %%
+        % @brief Evaluate the power profile on a coarse grid, within a
+        %        relative amplitude error.
+        %
+        % Power profiles change over seconds, while samples arrive at
+        % megahertz rates, so the amplitude (the square root of the power)
+        % is evaluated only at multiples of an interval of true time and
+        % linearly interpolated between them. The error of linear
+        % interpolation is at most <c>h^2/8</c> times the largest second
+        % derivative of the amplitude, so the interval @c h is chosen from
+        % the largest relative curvature of the amplitude, estimated at the
+        % ends and middle of each piece of the power profile, to keep the
+        % relative amplitude error within @c tolerance. The interval is at
+        % most one millisecond, an L1 C/A code period. The amplitude may
+        % step or kink at the breaks of the power profile (a signal that
+        % switches on or off), so the grid cells that contain a break are
+        % evaluated exactly at every sample, and no interpolation crosses a
+        % break. The grid is fixed in true time, so the samples do not
+        % depend on how they are divided into chunks.
+        %
+        % @par Usage
+        % obj.setAmplitudeTolerance(tolerance)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] tolerance The largest relative amplitude error, or zero
+        %            to evaluate the power profile at every sample.
+            validateattributes(tolerance, {'numeric'}, ...
+                               {'scalar', 'real', 'nonnegative'});
+            obj.amplitude_interval = 0;
+            obj.amplitude_break_positions = [];
+            if obj.use_power_profile && tolerance > 0
+                obj.amplitude_interval = SignalGenerator.amplitudeInterval( ...
+                    obj.power_spline, tolerance);
+                obj.amplitude_break_positions = ...
+                    obj.power_spline.breaks(:) / obj.amplitude_interval;
+            end
+        end
+        
+        function setProfiler(obj, profiler, label)
+        %%
+        % @brief Time each step of getSamples() with a profiler.
+        %
+        % The reference signal generation, signal time and power profile
+        % evaluation, power scaling and Doppler rotation (which evaluates
+        % the Doppler phase) are recorded as the stages 'reference',
+        % 'signal_time', 'profiles', 'power' and 'doppler', prefixed by
+        % @c label.
+        %
+        % @par Usage
+        % obj.setProfiler(profiler, label)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] profiler A PipelineProfiler, or empty to stop timing. A
+        %            disabled profiler is not kept.
+        % @param[in] label The prefix of the stage names, such as the signal
+        %            name and PRN.
+            if isempty(profiler) || ~profiler.enabled
+                obj.profiler = [];
+                return;
+            end
+            validateattributes(label, {'char', 'string'}, {'scalartext'});
+            label = char(label);
+            obj.profiler = profiler;
+            obj.profile_stages = struct( ...
+                'reference', [label '/reference'], ...
+                'signal_time', [label '/signal_time'], ...
+                'profiles', [label '/profiles'], ...
+                'power', [label '/power'], ...
+                'doppler', [label '/doppler']);
+        end
+
+        function descriptor = getStreamDescriptor(obj)
+        %%
+        % @brief Describe this generator's output for the native composite
+        %        engine (see CompositeEngine).
+        %
+        % @par Usage
+        % descriptor = obj.getStreamDescriptor()
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] descriptor The
+        %             ReferenceSignalGenerator.getStreamDescriptor() struct,
+        %             with the additional fields @c signal_time (the current
+        %             signal time, in sec), @c carrier_phase (the carrier
+        %             phase at that signal time, in rad),
+        %             @c amplitude_interval and @c power_spline,
+        %             @c doppler_spline and @c signal_time_spline (each empty
+        %             if the profile is not used); or empty if the generator
+        %             is not supported by the engine.
+            descriptor = ...
+                obj.reference_signal_generator.getStreamDescriptor();
+            if isempty(descriptor)
+                return;
+            end
+            descriptor.signal_time = obj.signal_time;
+            descriptor.carrier_phase = obj.carrierPhaseAt(obj.signal_time);
+            descriptor.amplitude_interval = obj.amplitude_interval;
+            descriptor.power_spline = [];
+            descriptor.doppler_spline = [];
+            descriptor.signal_time_spline = [];
+            if obj.use_power_profile
+                descriptor.power_spline = obj.power_spline;
+            end
+            if obj.use_doppler_profile
+                descriptor.doppler_spline = obj.doppler_spline;
+            end
+            if obj.use_signal_time_profile
+                descriptor.signal_time_spline = obj.signal_time_spline;
             end
         end
     end
     
+    methods (Access = private)
+        function true_time = trueTime(obj, signal_time)
+        %%
+        % @brief The true time (in sec) at which a signal time (in sec) is
+        %        transmitted.
+            if obj.use_signal_time_profile
+                true_time = ppvalEval(obj.signal_time_spline_handle, ...
+                                      signal_time);
+            else
+                true_time = signal_time;
+            end
+        end
+        
+        function signal_time = signalTimeAt(obj, true_time)
+        %%
+        % @brief The signal time (in sec) transmitted at a true time (in
+        %        sec); the inverse of trueTime().
+        %
+        % The compiled inverse profile gives the signal time to within its
+        % fit, and each correction against the signal time profile shrinks
+        % the error by the profile's time dilation, a factor far below one,
+        % so a few corrections reach rounding error. With a profile, the
+        % result is limited to the signal times that getSamples() can
+        % generate, from zero to the end of the profile.
+            MAX_CORRECTIONS = 3;
+            if ~obj.use_signal_time_profile
+                signal_time = true_time;
+                return;
+            end
+            signal_time = ppvalEval(obj.signal_time_inverse_handle, true_time);
+            for correction_idx = 1:MAX_CORRECTIONS
+                residual = obj.trueTime(signal_time) - true_time;
+                signal_time = signal_time - residual;
+                if abs(residual) <= eps(true_time)
+                    break;
+                end
+            end
+            signal_time = max(min(signal_time, ...
+                                  obj.signal_time_spline.breaks(end)), 0);
+        end
+        
+        function amplitude = evaluateAmplitude(obj, time_vector)
+        %%
+        % @brief The signal amplitude, the square root of the power profile,
+        %        at a column vector of ascending true times (in sec); see
+        %        setAmplitudeTolerance().
+            interval = obj.amplitude_interval;
+            if interval <= 0
+                amplitude = sqrt(ppvalEval(obj.power_spline_handle, ...
+                                           time_vector));
+                return;
+            end
+            position = time_vector / interval;
+            points = floor(position);
+            first_point = points(1);
+            grid_amplitude = sqrt(ppvalEval(obj.power_spline_handle, ...
+                (first_point:(points(end) + 1)).' * interval));
+            grid_idx = points - first_point + 1;
+            left = grid_amplitude(grid_idx);
+            amplitude = left + (position - points) .* ...
+                        (grid_amplitude(grid_idx + 1) - left);
+            
+            % Cell k spans grid points k and k + 1, so a break at position q
+            % lies in cells floor(q) and ceil(q) - 1 (the same cell unless q
+            % is on a grid point).
+            num_cells = numel(grid_amplitude) - 1;
+            break_positions = obj.amplitude_break_positions;
+            break_cells = [floor(break_positions); ...
+                           ceil(break_positions) - 1] - first_point + 1;
+            has_break = false(num_cells, 1);
+            has_break(break_cells(break_cells >= 1 & ...
+                                  break_cells <= num_cells)) = true;
+            exact = has_break(grid_idx);
+            if any(exact)
+                amplitude(exact) = sqrt(ppvalEval(obj.power_spline_handle, ...
+                                                  time_vector(exact)));
+            end
+        end
+        
+        function phase = carrierPhaseAt(obj, signal_time)
+        %%
+        % @brief The carrier phase (in rad) of the sample at a signal time
+        %        (in sec), wrapped to [0, 2*pi).
+            phase = obj.phase_offset;
+            if obj.use_doppler_profile
+                phase = phase + 2 * pi * ppvalEval( ...
+                    obj.doppler_phase_spline_handle, obj.trueTime(signal_time));
+            end
+            phase = mod(phase, 2 * pi);
+        end
+    end
+    
     methods (Static, Access = private)
+        function interval = amplitudeInterval(power_spline, tolerance)
+        %%
+        % @brief The amplitude grid interval (in sec) that keeps the
+        %        relative error of linearly interpolating the square root of
+        %        a power profile within a tolerance (see
+        %        setAmplitudeTolerance()).
+            MAX_INTERVAL = 1e-3; % sec
+            coefs = power_spline.coefs;
+            order = size(coefs, 2);
+            widths = diff(power_spline.breaks(:));
+            offsets = [zeros(size(widths)), widths / 2, widths];
+            
+            % The power and its first two derivatives at each offset.
+            power = zeros(size(offsets));
+            slope = zeros(size(offsets));
+            curvature = zeros(size(offsets));
+            for coef_idx = 1:order
+                exponent = order - coef_idx;
+                c = coefs(:, coef_idx);
+                power = power + c .* offsets .^ exponent;
+                if exponent >= 1
+                    slope = slope + exponent * c .* ...
+                            offsets .^ (exponent - 1);
+                end
+                if exponent >= 2
+                    curvature = curvature + ...
+                        exponent * (exponent - 1) * c .* ...
+                        offsets .^ (exponent - 2);
+                end
+            end
+            
+            % The second derivative of sqrt(power), relative to sqrt(power).
+            valid = power > 0;
+            relative_curvature = abs( ...
+                curvature(valid) ./ (2 * power(valid)) - ...
+                (slope(valid) ./ (2 * power(valid))) .^ 2);
+            largest = max([relative_curvature(:); 0]);
+            interval = MAX_INTERVAL;
+            if largest > 0
+                interval = min(interval, sqrt(8 * tolerance / largest));
+            end
+        end
+        
+        function inverse_spline = invertSpline(signal_time_spline)
+        %%
+        % @brief Fit the inverse of a signal time spline, as signal time vs
+        %        true time.
+        %
+        % The inverse interpolates the spline's breaks and the true times
+        % there, which for a spline from convertToSignalTimeSpline() are the
+        % points it was fit through, swapped. The spline must increase
+        % monotonically; this is checked once here, at its breaks.
+        %
+        % @param[in] signal_time_spline The true time vs signal time spline.
+        %
+        % @param[out] inverse_spline The signal time vs true time spline.
+            signal_times = signal_time_spline.breaks;
+            true_times = ppval(signal_time_spline, signal_times);
+            if ~all(diff(true_times) > 0)
+                error(['The signal time spline must increase ' ...
+                       'monotonically.']);
+            end
+            inverse_spline = spline(true_times, signal_times);
+        end
+        
         function flag = validateSplineStructFields(pp)
         %%
         % @brief Validate a spline struct by checking for the fields present.
@@ -0,0 +1,116 @@
+classdef (Sealed = true) StreamingResampler < handle
+%%
+% @brief A stateful nearest-lower-neighbor resampler for signal streams that
+%        are generated in chunks.
+%
+% Source samples are appended block by block, and each call to resample()
+% performs the same interpolation as nonUniformResampleFast() over everything
+% appended so far. The (time, sample) history is kept in native memory and
+% only the samples spanning the most recent output block are retained, so no
+% buffers are concatenated or trimmed in MATLAB. The sample held at the end of
+% an output block carries over into the next one.
+%
+% @note
+% This class wraps a core MEX function, which must be compiled with make.m.
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+    properties (SetAccess = private)
+        finished = false; % True once the end of the stream has been marked.
+    end
+
+    properties (Access = private)
+        resampler_handle; % The uint64 handle to the native resampler.
+    end
+
+    methods (Access = public)
+        function obj = StreamingResampler()
+        %%
+        % @brief Create an empty resampler.
+        %
+        % @par Usage
+        % obj = StreamingResampler()
+        %
+        % @param[out] obj The created instance.
+            obj.resampler_handle = streamingResamplerCore('create');
+        end
+
+        function delete(obj)
+        %%
+        % @brief Release the native resampler.
+        %
+        % @param[in] obj The instance of the class.
+            if ~isempty(obj.resampler_handle)
+                streamingResamplerCore('free', obj.resampler_handle);
+            end
+        end
+
+        function append(obj, x, y)
+        %%
+        % @brief Append a block of source samples.
+        %
+        % An error is raised if the x-axis locations are not strictly
+        % increasing, including across blocks.
+        %
+        % @par Usage
+        % obj.append(x, y)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] x The x-axis of the source samples. Must be a real column
+        %            vector.
+        % @param[in] y The source samples. Must be a real or complex column
+        %            vector the same size as @c x.
+            streamingResamplerCore('append', obj.resampler_handle, x, y);
+        end
+
+        function y_i = resample(obj, x_i)
+        %%
+        % @brief Resample the appended data at ascending x-axis locations.
+        %
+        % @par Usage
+        % y_i = obj.resample(x_i)
+        %
+        % @param[in] obj The instance of the class.
+        % @param[in] x_i The x-axis of the desired resampled data. Must be a
+        %            real column vector, at or beyond the locations passed to
+        %            the previous call.
+        %
+        % @param[out] y_i The resampled data, the same size as @c x_i. Outputs
+        %             before the first appended sample are zero.
+            y_i = streamingResamplerCore('resample', obj.resampler_handle, x_i);
+        end
+
+        function finish(obj)
+        %%
+        % @brief Mark the end of the source stream. Outputs beyond the final
+        %        appended sample are zero, instead of holding that sample.
+        %
+        % @par Usage
+        % obj.finish()
+        %
+        % @param[in] obj The instance of the class.
+            streamingResamplerCore('finish', obj.resampler_handle);
+            obj.finished = true;
+        end
+
+        function t = getLastTime(obj)
+        %%
+        % @brief Get the x-axis location of the most recently appended sample.
+        %
+        % @par Usage
+        % t = obj.getLastTime()
+        %
+        % @param[in] obj The instance of the class.
+        %
+        % @param[out] t The newest x-axis location, or empty if nothing has
+        %             been appended.
+            t = streamingResamplerCore('last_time', obj.resampler_handle);
+        end
+    end
+end
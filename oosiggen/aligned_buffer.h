@@ -0,0 +1,138 @@
+/**************************************************************************//**
+ * @brief      A minimal cache-line aligned array for native signal generation
+ *             state.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_ALIGNED_BUFFER_H_
+#define OOSIGGEN_ALIGNED_BUFFER_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new> // For bad_alloc.
+
+#if defined(_MSC_VER)
+#include <malloc.h> // For _aligned_malloc().
+#endif
+
+namespace oosiggen
+{
+
+/**
+ * @brief A fixed-capacity array of trivially copyable elements whose storage
+ *        starts on a cache line boundary.
+ *
+ * Elements are not initialized on allocation. Copying is disabled; instances
+ * are owned through unique or shared pointers where they need to be shared.
+ */
+template <typename T>
+class AlignedBuffer
+{
+public:
+    static const size_t kAlignment = 64; ///< Alignment, in bytes.
+
+    AlignedBuffer() : data_(NULL), size_(0) {}
+
+    explicit AlignedBuffer(size_t size) : data_(NULL), size_(0)
+    {
+        resize(size);
+    }
+
+    ~AlignedBuffer()
+    {
+        release();
+    }
+
+    /**
+     * @brief Reallocate the buffer to hold @c size elements. Existing
+     *        contents are discarded.
+     */
+    void resize(size_t size)
+    {
+        release();
+        if (size == 0)
+        {
+            return;
+        }
+        const size_t bytes =
+            ((size * sizeof(T) + kAlignment - 1) / kAlignment) * kAlignment;
+#if defined(_MSC_VER)
+        data_ = static_cast<T*>(_aligned_malloc(bytes, kAlignment));
+#else
+        void *ptr = NULL;
+        if (posix_memalign(&ptr, kAlignment, bytes) != 0)
+        {
+            ptr = NULL;
+        }
+        data_ = static_cast<T*>(ptr);
+#endif
+        if (data_ == NULL)
+        {
+            throw std::bad_alloc();
+        }
+        size_ = size;
+    }
+
+    /**
+     * @brief Set every element to zero bytes.
+     */
+    void zero()
+    {
+        if (size_ > 0)
+        {
+            std::memset(data_, 0, size_ * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Exchange storage with another buffer.
+     */
+    void swap(AlignedBuffer &other)
+    {
+        T *const data = data_;
+        const size_t size = size_;
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = data;
+        other.size_ = size;
+    }
+
+    T *data() { return data_; }
+    const T *data() const { return data_; }
+    size_t size() const { return size_; }
+    T &operator[](size_t idx) { return data_[idx]; }
+    const T &operator[](size_t idx) const { return data_[idx]; }
+
+private:
+    AlignedBuffer(const AlignedBuffer&);
+    AlignedBuffer &operator=(const AlignedBuffer&);
+
+    void release()
+    {
+#if defined(_MSC_VER)
+        _aligned_free(data_);
+#else
+        std::free(data_);
+#endif
+        data_ = NULL;
+        size_ = 0;
+    }
+
+    T *data_; ///< The element storage.
+    size_t size_; ///< The number of elements.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_ALIGNED_BUFFER_H_
@@ -0,0 +1,394 @@
+/**************************************************************************//**
+ * @brief      Double-buffered file writer that overlaps generation with
+ *             disk I/O.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For O_DIRECT.
+#endif
+
+#include "async_file_writer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <io.h> // For _chsize_s().
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace oosiggen
+{
+
+const size_t AsyncFileWriter::kPageSize;
+
+AsyncFileWriter::AsyncFileWriter(const std::string &path, size_t block_size,
+                                 size_t num_blocks, bool direct_io)
+    : block_size_(0), current_(0), bytes_accepted_(0),
+      direct_io_(direct_io), file_offset_(0),
+#if defined(_WIN32)
+      file_(NULL),
+#else
+      fd_(-1),
+#endif
+      closing_(false)
+{
+    initialize(path, block_size, num_blocks, false, 0);
+}
+
+AsyncFileWriter::AsyncFileWriter(const std::string &path, size_t block_size,
+                                 size_t num_blocks, bool direct_io,
+                                 unsigned long long offset,
+                                 unsigned long long file_size)
+    : block_size_(0), current_(0), bytes_accepted_(0),
+      direct_io_(direct_io), file_offset_(offset),
+#if defined(_WIN32)
+      file_(NULL),
+#else
+      fd_(-1),
+#endif
+      closing_(false)
+{
+    if (offset > file_size)
+    {
+        throw std::invalid_argument("offset exceeds file_size.");
+    }
+    initialize(path, block_size, num_blocks, true, file_size);
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+void AsyncFileWriter::initialize(const std::string &path, size_t block_size,
+                                 size_t num_blocks, bool in_place,
+                                 unsigned long long file_size)
+{
+    if (block_size == 0)
+    {
+        throw std::invalid_argument("block_size must be positive.");
+    }
+    if (num_blocks < 2)
+    {
+        throw std::invalid_argument("num_blocks must be at least two.");
+    }
+    block_size_ = ((block_size + kPageSize - 1) / kPageSize) * kPageSize;
+
+    // Allocate every block up front, so that writing never allocates.
+    blocks_.reserve(num_blocks);
+    for (size_t block_idx = 0; block_idx < num_blocks; ++block_idx)
+    {
+        std::unique_ptr<Block> block(new Block());
+        block->storage.resize(block_size_ + kPageSize);
+        const uintptr_t address =
+            reinterpret_cast<uintptr_t>(block->storage.data());
+        block->data = block->storage.data() +
+            (kPageSize - address % kPageSize) % kPageSize;
+        block->size = 0;
+        blocks_.push_back(std::move(block));
+        if (block_idx > 0)
+        {
+            free_.push_back(block_idx);
+        }
+    }
+
+    openFile(path, in_place, file_size);
+    try
+    {
+        writer_ = std::thread(&AsyncFileWriter::writerLoop, this);
+    }
+    catch (...)
+    {
+        closeFile();
+        throw;
+    }
+}
+
+void AsyncFileWriter::write(const void *data, size_t num_bytes)
+{
+    if (!isOpen())
+    {
+        throw std::logic_error("The file has been closed.");
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkError();
+    }
+
+    const char *source = static_cast<const char*>(data);
+    while (num_bytes > 0)
+    {
+        Block &block = *blocks_[current_];
+        const size_t space = block_size_ - block.size;
+        const size_t count = num_bytes < space ? num_bytes : space;
+        std::memcpy(block.data + block.size, source, count);
+        block.size += count;
+        bytes_accepted_ += count;
+        source += count;
+        num_bytes -= count;
+        if (block.size == block_size_)
+        {
+            submitCurrent();
+        }
+    }
+}
+
+void AsyncFileWriter::close()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (blocks_[current_]->size > 0)
+        {
+            full_.push_back(current_);
+        }
+        closing_ = true;
+    }
+    block_full_.notify_one();
+    writer_.join();
+    closeFile();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    checkError();
+}
+
+void AsyncFileWriter::submitCurrent()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    full_.push_back(current_);
+    block_full_.notify_one();
+    while (free_.empty() && error_.empty())
+    {
+        block_free_.wait(lock);
+    }
+    checkError();
+    current_ = free_.front();
+    free_.pop_front();
+}
+
+void AsyncFileWriter::checkError() const
+{
+    if (!error_.empty())
+    {
+        throw std::runtime_error(error_);
+    }
+}
+
+void AsyncFileWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+        while (full_.empty() && !closing_)
+        {
+            block_full_.wait(lock);
+        }
+        if (full_.empty())
+        {
+            return;
+        }
+        const size_t block_idx = full_.front();
+        full_.pop_front();
+
+        // Write without holding the lock, so that the caller can keep
+        // filling blocks. After an error, drain the queue without writing.
+        if (error_.empty())
+        {
+            lock.unlock();
+            const bool written = writeBlock(*blocks_[block_idx]);
+            const int error_number = errno;
+            lock.lock();
+            if (!written)
+            {
+                error_ = std::string("Could not write to file: ") +
+                         std::strerror(error_number);
+            }
+        }
+        blocks_[block_idx]->size = 0;
+        free_.push_back(block_idx);
+        block_free_.notify_one();
+    }
+}
+
+#if defined(_WIN32)
+
+void AsyncFileWriter::openFile(const std::string &path, bool in_place,
+                               unsigned long long file_size)
+{
+    if (in_place)
+    {
+        // Open an existing file without truncating it, creating it if need
+        // be; another writer may create it first.
+        file_ = std::fopen(path.c_str(), "r+b");
+        if (file_ == NULL)
+        {
+            std::FILE *created = std::fopen(path.c_str(), "ab");
+            if (created != NULL)
+            {
+                std::fclose(created);
+            }
+            file_ = std::fopen(path.c_str(), "r+b");
+        }
+    }
+    else
+    {
+        file_ = std::fopen(path.c_str(), "wb");
+    }
+    if (file_ == NULL)
+    {
+        throw std::runtime_error("Could not open file \"" + path + "\".");
+    }
+    if (in_place &&
+        _chsize_s(_fileno(file_), static_cast<__int64>(file_size)) != 0)
+    {
+        std::fclose(file_);
+        file_ = NULL;
+        throw std::runtime_error("Could not resize file \"" + path + "\".");
+    }
+    // The blocks are already large; stdio buffering would only add a copy.
+    std::setvbuf(file_, NULL, _IONBF, 0);
+    direct_io_ = false;
+}
+
+bool AsyncFileWriter::writeBlock(const Block &block)
+{
+    if (_fseeki64(file_, static_cast<__int64>(file_offset_), SEEK_SET) != 0 ||
+        std::fwrite(block.data, 1, block.size, file_) != block.size)
+    {
+        return false;
+    }
+    file_offset_ += block.size;
+    return true;
+}
+
+void AsyncFileWriter::closeFile()
+{
+    if (file_ != NULL && std::fclose(file_) != 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_.empty())
+        {
+            error_ = "Could not close file.";
+        }
+    }
+    file_ = NULL;
+}
+
+#else
+
+void AsyncFileWriter::openFile(const std::string &path, bool in_place,
+                               unsigned long long file_size)
+{
+    const int flags = O_WRONLY | O_CREAT | (in_place ? 0 : O_TRUNC);
+#if defined(O_DIRECT)
+    if (direct_io_)
+    {
+        // Not all file systems support O_DIRECT (tmpfs, for example).
+        fd_ = ::open(path.c_str(), flags | O_DIRECT, 0666);
+    }
+#else
+    direct_io_ = false;
+#endif
+    if (fd_ < 0)
+    {
+        direct_io_ = false;
+        fd_ = ::open(path.c_str(), flags, 0666);
+    }
+    if (fd_ < 0)
+    {
+        throw std::runtime_error("Could not open file \"" + path + "\": " +
+                                 std::strerror(errno));
+    }
+    // Every writer of the file sets the same size, so the resizes of
+    // concurrent writers do not disturb one another's data.
+    if (in_place && ::ftruncate(fd_, static_cast<off_t>(file_size)) != 0)
+    {
+        const int error_number = errno;
+        ::close(fd_);
+        fd_ = -1;
+        throw std::runtime_error("Could not resize file \"" + path + "\": " +
+                                 std::strerror(error_number));
+    }
+}
+
+bool AsyncFileWriter::writeBlock(const Block &block)
+{
+#if defined(O_DIRECT)
+    // Direct I/O requires a multiple of the page size at a page-aligned
+    // offset. Only the final block can fail to be the former, and only a
+    // writer placed at an unaligned offset the latter; write those through
+    // the page cache.
+    if (direct_io_ &&
+        (block.size % kPageSize != 0 || file_offset_ % kPageSize != 0))
+    {
+        const int flags = ::fcntl(fd_, F_GETFL);
+        if (flags < 0 || ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT) < 0)
+        {
+            return false;
+        }
+        direct_io_ = false;
+    }
+#endif
+    const char *data = block.data;
+    size_t remaining = block.size;
+    while (remaining > 0)
+    {
+        const ssize_t count = ::pwrite(fd_, data, remaining,
+                                       static_cast<off_t>(file_offset_));
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += count;
+        remaining -= static_cast<size_t>(count);
+        file_offset_ += static_cast<unsigned long long>(count);
+    }
+    return true;
+}
+
+void AsyncFileWriter::closeFile()
+{
+    if (fd_ >= 0 && ::close(fd_) != 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_.empty())
+        {
+            error_ = std::string("Could not close file: ") +
+                     std::strerror(errno);
+        }
+    }
+    fd_ = -1;
+}
+
+#endif
+
+} // namespace oosiggen
@@ -0,0 +1,185 @@
+/**************************************************************************//**
+ * @brief      Double-buffered file writer that overlaps generation with
+ *             disk I/O.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_ASYNC_FILE_WRITER_H_
+#define OOSIGGEN_ASYNC_FILE_WRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aligned_buffer.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief Writes a byte stream to a file from a background thread.
+ *
+ * Data passed to write() is copied into one of a fixed set of preallocated,
+ * page-aligned blocks. Each full block is queued to a background thread,
+ * which writes it to the file while the caller fills the next one, so
+ * generation only waits on the disk when every block is in flight. Writes
+ * therefore reach the file as large, sequential, block-sized requests.
+ *
+ * The stream may also be written in place at an offset within an existing
+ * file, so that several writers, in different processes or on different
+ * nodes sharing a file system, can each fill their own range of one file.
+ * Every block is written with a positioned write, and the file is neither
+ * truncated nor appended to.
+ *
+ * On Linux, the file may optionally be opened with @c O_DIRECT, bypassing the
+ * page cache; if the file system does not support it, or the offset is not
+ * page-aligned, buffered I/O is used.
+ *
+ * An error in the background thread is reported by the next call to write()
+ * or close().
+ */
+class AsyncFileWriter
+{
+public:
+    /// The alignment of the blocks, and of their sizes (in bytes).
+    static const size_t kPageSize = 4096;
+
+    /**
+     * @brief Create (or truncate) a file for writing.
+     *
+     * @param path The file path.
+     * @param block_size The size of each block (in bytes); rounded up to a
+     *        multiple of kPageSize.
+     * @param num_blocks The number of blocks; at least two.
+     * @param direct_io True to bypass the page cache where supported.
+     */
+    AsyncFileWriter(const std::string &path, size_t block_size,
+                    size_t num_blocks, bool direct_io);
+
+    /**
+     * @brief Open (or create) a file for writing in place.
+     *
+     * The file is resized to @c file_size bytes, which every writer of the
+     * file must agree on, and the stream is written from byte @c offset.
+     *
+     * @param path The file path.
+     * @param block_size The size of each block (in bytes); rounded up to a
+     *        multiple of kPageSize.
+     * @param num_blocks The number of blocks; at least two.
+     * @param direct_io True to bypass the page cache where supported.
+     * @param offset The position of the first byte written.
+     * @param file_size The size of the whole file (in bytes).
+     */
+    AsyncFileWriter(const std::string &path, size_t block_size,
+                    size_t num_blocks, bool direct_io,
+                    unsigned long long offset, unsigned long long file_size);
+
+    /**
+     * @brief Close the file, if not already closed; errors are discarded.
+     */
+    ~AsyncFileWriter();
+
+    /**
+     * @brief Append data to the file. Returns once the data has been copied,
+     *        which is usually before it has been written.
+     */
+    void write(const void *data, size_t num_bytes);
+
+    /**
+     * @brief Write any buffered data, wait for all writes to complete and
+     *        close the file. Further writes are not allowed.
+     */
+    void close();
+
+    bool isOpen() const { return writer_.joinable(); }
+
+    /**
+     * @brief The number of bytes passed to write() so far.
+     */
+    unsigned long long bytesAccepted() const { return bytes_accepted_; }
+
+private:
+    /// A preallocated block of file data.
+    struct Block
+    {
+        AlignedBuffer<char> storage; ///< Over-allocated for page alignment.
+        char *data; ///< The page-aligned start of the block.
+        size_t size; ///< The number of bytes of data in the block.
+    };
+
+    AsyncFileWriter(const AsyncFileWriter&);
+    AsyncFileWriter &operator=(const AsyncFileWriter&);
+
+    /**
+     * @brief Queue the current block for writing, then wait for a free one.
+     */
+    void submitCurrent();
+
+    /**
+     * @brief Throw the background thread's error, if any. Requires the lock.
+     */
+    void checkError() const;
+
+    void writerLoop();
+
+    /**
+     * @brief Allocate the blocks, open the file and start the background
+     *        thread; @c in_place selects the second constructor.
+     */
+    void initialize(const std::string &path, size_t block_size,
+                    size_t num_blocks, bool in_place,
+                    unsigned long long file_size);
+
+    /**
+     * @brief Write a block to the file at the current offset; returns false
+     *        on error.
+     */
+    bool writeBlock(const Block &block);
+
+    void openFile(const std::string &path, bool in_place,
+                  unsigned long long file_size);
+    void closeFile();
+
+    std::vector<std::unique_ptr<Block> > blocks_; ///< All blocks.
+    size_t block_size_; ///< The capacity of each block (in bytes).
+    size_t current_; ///< The block being filled by the caller.
+    unsigned long long bytes_accepted_; ///< Bytes passed to write().
+    bool direct_io_; ///< True if the file was opened with O_DIRECT.
+    /// The file position of the next block; used by the background thread.
+    unsigned long long file_offset_;
+
+#if defined(_WIN32)
+    std::FILE *file_; ///< The output file.
+#else
+    int fd_; ///< The output file descriptor.
+#endif
+
+    std::thread writer_; ///< Writes full blocks to the file.
+    std::mutex mutex_; ///< Guards the fields below.
+    std::condition_variable block_full_; ///< Signals a queued block or close.
+    std::condition_variable block_free_; ///< Signals a written block.
+    std::deque<size_t> full_; ///< Blocks queued for writing, in order.
+    std::deque<size_t> free_; ///< Blocks available to fill.
+    bool closing_; ///< True once no more blocks will be queued.
+    std::string error_; ///< The background thread's error, if any.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_ASYNC_FILE_WRITER_H_
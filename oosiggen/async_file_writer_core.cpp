@@ -0,0 +1,286 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to the asynchronous file writer.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility> // For move().
+
+#include "mex.h"
+
+#include "async_file_writer.h"
+#include "mex_handle_registry.h"
+
+namespace
+{
+
+/**
+ * @brief The writers owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::AsyncFileWriter> &writers()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::AsyncFileWriter>
+        registry("asyncFileWriterCore");
+    return registry;
+}
+
+/**
+ * @brief Free all writers when the MEX file is cleared.
+ */
+void freeAllWriters()
+{
+    writers().clear();
+}
+
+/**
+ * @brief Check that an argument is a real scalar double.
+ */
+bool isRealScalar(const mxArray *array)
+{
+    return array != NULL && mxIsDouble(array) && !mxIsComplex(array) &&
+           mxGetNumberOfElements(array) == 1;
+}
+
+/**
+ * @brief Create a writer, creating or truncating its file, or opening it to
+ *        write in place.
+ */
+void createWriter(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 5 && nrhs != 7)
+    {
+        mexErrMsgTxt("create requires file_path, block_size, num_blocks and "
+                     "direct_io, and optionally offset and file_size.");
+    }
+    if (!mxIsChar(prhs[1]))
+    {
+        mexErrMsgTxt("file_path must be a character array.");
+    }
+    for (int arg_idx = 2; arg_idx < 5; ++arg_idx)
+    {
+        if (!isRealScalar(prhs[arg_idx]))
+        {
+            mexErrMsgTxt("block_size, num_blocks and direct_io must be real "
+                         "scalar doubles.");
+        }
+    }
+    const double block_size = mxGetScalar(prhs[2]);
+    const double num_blocks = mxGetScalar(prhs[3]);
+    if (!(block_size >= 1.0) || !(num_blocks >= 2.0))
+    {
+        mexErrMsgTxt("block_size must be positive and num_blocks must be at "
+                     "least two.");
+    }
+    const bool in_place = nrhs == 7;
+    double offset = 0.0;
+    double file_size = 0.0;
+    if (in_place)
+    {
+        if (!isRealScalar(prhs[5]) || !isRealScalar(prhs[6]))
+        {
+            mexErrMsgTxt("offset and file_size must be real scalar doubles.");
+        }
+        offset = mxGetScalar(prhs[5]);
+        file_size = mxGetScalar(prhs[6]);
+        if (!(offset >= 0.0) || !(file_size >= offset))
+        {
+            mexErrMsgTxt("offset must be non-negative and at most "
+                         "file_size.");
+        }
+    }
+
+    char *file_path = mxArrayToString(prhs[1]);
+    if (file_path == NULL)
+    {
+        mexErrMsgTxt("Could not read file_path.");
+    }
+    const std::string path(file_path);
+    mxFree(file_path);
+
+    std::unique_ptr<oosiggen::AsyncFileWriter> writer;
+    try
+    {
+        if (in_place)
+        {
+            writer.reset(new oosiggen::AsyncFileWriter(
+                path, static_cast<size_t>(block_size),
+                static_cast<size_t>(num_blocks), mxGetScalar(prhs[4]) != 0.0,
+                static_cast<unsigned long long>(offset),
+                static_cast<unsigned long long>(file_size)));
+        }
+        else
+        {
+            writer.reset(new oosiggen::AsyncFileWriter(
+                path, static_cast<size_t>(block_size),
+                static_cast<size_t>(num_blocks),
+                mxGetScalar(prhs[4]) != 0.0));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = writers().add(std::move(writer));
+}
+
+/**
+ * @brief Append the raw bytes of a numeric array to a writer's file.
+ */
+void writeData(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("write requires a handle and data.");
+    }
+    oosiggen::AsyncFileWriter &writer = writers().get(prhs[1]);
+    if (prhs[2] == NULL || !mxIsNumeric(prhs[2]) || mxIsComplex(prhs[2]))
+    {
+        mexErrMsgTxt("data must be a real numeric array.");
+    }
+
+    try
+    {
+        writer.write(mxGetData(prhs[2]), mxGetNumberOfElements(prhs[2]) *
+                                         mxGetElementSize(prhs[2]));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+}
+
+/**
+ * @brief Write any buffered data and close a writer's file.
+ */
+void closeWriter(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("close requires a handle.");
+    }
+    oosiggen::AsyncFileWriter &writer = writers().get(prhs[1]);
+
+    try
+    {
+        writer.close();
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = mxCreateDoubleScalar(
+        static_cast<double>(writer.bytesAccepted()));
+}
+
+/**
+ * @brief Free one or more writers, closing their files.
+ */
+void freeWriters(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    writers().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = asyncFileWriterCore('create', file_path, block_size, num_blocks, ...
+ *                         direct_io)
+ * h = asyncFileWriterCore('create', file_path, block_size, num_blocks, ...
+ *                         direct_io, offset, file_size)
+ * asyncFileWriterCore('write', h, data)
+ * num_bytes = asyncFileWriterCore('close', h)
+ * asyncFileWriterCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>prhs[1]</c>: The path of the file to create or truncate.
+ * - <c>prhs[2]</c>: The size of each buffered block (in bytes).
+ * - <c>prhs[3]</c>: The number of blocks; at least two.
+ * - <c>prhs[4]</c>: Nonzero to bypass the page cache where supported.
+ * - <c>prhs[5]</c>: Optional. The byte offset at which to write in place;
+ *   the file is then opened without truncation, or created.
+ * - <c>prhs[6]</c>: Required with <c>prhs[5]</c>. The size to give the file
+ *   (in bytes).
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the new writer.
+ *
+ * For @c 'write':
+ * - <c>prhs[1]</c>: The writer handle.
+ * - <c>prhs[2]</c>: A real numeric array, whose elements are appended to the
+ *   file in their native byte order. Errors from earlier writes are reported
+ *   here.
+ *
+ * For @c 'close':
+ * - <c>prhs[1]</c>: The writer handle.
+ * - <c>plhs[0]</c>: The total number of bytes written to the file.
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllWriters);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createWriter(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "write") == 0)
+    {
+        writeData(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "close") == 0)
+    {
+        closeWriter(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeWriters(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
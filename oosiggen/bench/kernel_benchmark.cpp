@@ -0,0 +1,479 @@
+/**************************************************************************//**
+ * @brief      Native benchmark of the ppvalFastCore and
+ *             nonUniformResampleFast kernels.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * Runs the kernels that the MEX functions wrap, without MATLAB, over a sweep
+ * of problem shapes, and reports the time per output sample and the memory
+ * throughput. Every case is first checked against a simple scalar reference,
+ * so a kernel change that alters results is reported as a failure rather
+ * than as a speedup.
+ *
+ * @par Building
+ * From the oosiggen directory (add or drop the SIMD flags to match make.m):
+ * @code
+ * g++ -std=c++11 -O2 -mavx2 -mfma -I. bench/kernel_benchmark.cpp \
+ *     -o kernel_benchmark
+ * @endcode
+ *
+ * @par Usage
+ * kernel_benchmark [--quick] [filter]
+ *
+ * - @c --quick: Run a reduced sweep, with shorter timing runs.
+ * - @c filter: Only run cases whose name contains this string, such as
+ *   @c ppval or @c "order=4".
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "non_uniform_resample_kernel.h"
+#include "ppval_kernel.h"
+
+namespace
+{
+
+/**
+ * @brief Timing settings for one sweep.
+ */
+struct TimingOptions
+{
+    double min_run_seconds; ///< Shortest timed run; the call is repeated.
+    size_t num_runs; ///< Timed runs per case; the fastest is reported.
+};
+
+/**
+ * @brief Time a kernel call, returning the fastest time per call (in sec).
+ */
+template <typename Call>
+double timeCall(const TimingOptions &options, Call call)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    // Find a repeat count that makes each run long enough to time.
+    size_t repeats = 1;
+    for (;;)
+    {
+        const Clock::time_point start = Clock::now();
+        for (size_t idx = 0; idx < repeats; ++idx)
+        {
+            call();
+        }
+        const double elapsed =
+            std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed >= options.min_run_seconds)
+        {
+            break;
+        }
+        repeats *= elapsed > 0.0 ?
+            std::max(2.0, 1.2 * options.min_run_seconds / elapsed) : 10;
+    }
+
+    double best = 0.0;
+    for (size_t run = 0; run < options.num_runs; ++run)
+    {
+        const Clock::time_point start = Clock::now();
+        for (size_t idx = 0; idx < repeats; ++idx)
+        {
+            call();
+        }
+        const double elapsed =
+            std::chrono::duration<double>(Clock::now() - start).count() /
+            static_cast<double>(repeats);
+        if (run == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Print one result row.
+ *
+ * @param name The case name.
+ * @param num_samples The output samples per call.
+ * @param num_bytes The bytes read and written per call.
+ * @param seconds The time per call (in sec).
+ * @param passed True if the outputs matched the reference.
+ */
+void report(const std::string &name, size_t num_samples, double num_bytes,
+            double seconds, bool passed)
+{
+    std::printf("%-58s %10.3f %9.2f %s\n", name.c_str(),
+                1e9 * seconds / static_cast<double>(num_samples),
+                num_bytes / seconds / 1e9, passed ? "" : "FAILED");
+}
+
+/**
+ * @brief A reference evaluation of a column-major piecewise polynomial, one
+ *        value at a time.
+ */
+double referencePpval(const std::vector<double> &breaks,
+                      const std::vector<double> &coefs, size_t order,
+                      double x)
+{
+    const size_t num_polynomials = breaks.size() - 1;
+    const size_t upper = std::upper_bound(breaks.begin() + 1,
+                                          breaks.end() - 1, x) -
+                         breaks.begin();
+    size_t bin = upper - 1;
+    if (bin > 0 && x == breaks[bin])
+    {
+        --bin; // Bins are closed on the right.
+    }
+    const double delta_x = x - breaks[bin];
+    double value = 0.0;
+    for (size_t coef_idx = 0; coef_idx < order; ++coef_idx)
+    {
+        value = delta_x * value + coefs[coef_idx * num_polynomials + bin];
+    }
+    return value;
+}
+
+/**
+ * @brief Benchmark ppvalFastCore for one problem shape.
+ *
+ * @return True if the outputs matched the reference.
+ */
+bool benchmarkPpval(const std::string &name, const TimingOptions &options,
+                    size_t num_breaks, size_t order, size_t num_values,
+                    bool sorted, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<double> breaks(num_breaks);
+    for (size_t idx = 0; idx < num_breaks; ++idx)
+    {
+        breaks[idx] = static_cast<double>(idx) + 0.5 * uniform(rng);
+    }
+    std::vector<double> coefs((num_breaks - 1) * order);
+    for (size_t idx = 0; idx < coefs.size(); ++idx)
+    {
+        coefs[idx] = uniform(rng) - 0.5;
+    }
+    std::vector<double> xx(num_values);
+    for (size_t idx = 0; idx < num_values; ++idx)
+    {
+        xx[idx] = breaks[0] + (breaks[num_breaks - 1] - breaks[0]) *
+                  uniform(rng);
+    }
+    if (sorted)
+    {
+        std::sort(xx.begin(), xx.end());
+    }
+    std::vector<double> v(num_values);
+
+    oosiggen::evaluateColumnMajorPiecewisePolynomial(
+        &breaks[0], num_breaks, &coefs[0], order, &xx[0], num_values, &v[0]);
+    bool passed = true;
+    for (size_t idx = 0; idx < num_values && passed; ++idx)
+    {
+        const double expected = referencePpval(breaks, coefs, order, xx[idx]);
+        passed = std::fabs(v[idx] - expected) <=
+                 1e-12 * (std::fabs(expected) + 1.0);
+    }
+
+    const double seconds = timeCall(options, [&]() {
+        oosiggen::evaluateColumnMajorPiecewisePolynomial(
+            &breaks[0], num_breaks, &coefs[0], order, &xx[0], num_values,
+            &v[0]);
+    });
+
+    // The query and output vectors, and the piecewise polynomial once.
+    const double num_bytes = sizeof(double) *
+        (2.0 * num_values + num_breaks + coefs.size());
+    report(name, num_values, num_bytes, seconds, passed);
+    return passed;
+}
+
+/**
+ * @brief Make a random real sample.
+ */
+void randomSample(std::uniform_real_distribution<double> &uniform,
+                  std::mt19937 &rng, double &sample)
+{
+    sample = uniform(rng) - 0.5;
+}
+
+/**
+ * @brief Make a random complex sample.
+ */
+void randomSample(std::uniform_real_distribution<double> &uniform,
+                  std::mt19937 &rng, std::complex<double> &sample)
+{
+    const double real = uniform(rng) - 0.5;
+    sample = std::complex<double>(real, uniform(rng) - 0.5);
+}
+
+/**
+ * @brief Resample real samples, as nonUniformResampleFast does.
+ */
+void resample(const std::vector<double> &x, const std::vector<double> &y,
+              const std::vector<double> &xi, std::vector<double> &yi)
+{
+    const oosiggen::RealSamples samples = {&y[0], &yi[0]};
+    oosiggen::resampleNearestLower(&x[0], x.size(), &xi[0], xi.size(),
+                                   samples);
+}
+
+/**
+ * @brief Resample interleaved complex samples, as nonUniformResampleFast
+ *        does with the R2018a API.
+ */
+void resample(const std::vector<double> &x,
+              const std::vector<std::complex<double> > &y,
+              const std::vector<double> &xi,
+              std::vector<std::complex<double> > &yi)
+{
+    const oosiggen::InterleavedComplexSamples<std::complex<double> >
+        samples = {&y[0], &yi[0]};
+    oosiggen::resampleNearestLower(&x[0], x.size(), &xi[0], xi.size(),
+                                   samples);
+}
+
+/**
+ * @brief Resample with a binary search per output, for reference.
+ */
+template <typename T>
+void referenceResample(const std::vector<double> &x, const std::vector<T> &y,
+                       const std::vector<double> &xi, std::vector<T> &yi)
+{
+    for (size_t idx = 0; idx < xi.size(); ++idx)
+    {
+        const size_t count = std::upper_bound(x.begin(), x.end(), xi[idx]) -
+                             x.begin();
+        yi[idx] = count == 0 ? T() : y[count - 1];
+    }
+}
+
+/**
+ * @brief Benchmark nonUniformResampleFast for one problem shape.
+ *
+ * The reference locations are spaced either uniformly or with random
+ * spacing, at @c ref_per_output times the density of the output locations.
+ *
+ * @return True if the outputs matched the reference.
+ */
+template <typename T>
+bool benchmarkResample(const std::string &name, const TimingOptions &options,
+                       size_t num_values, double ref_per_output,
+                       bool jittered, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const size_t x_length = static_cast<size_t>(
+        std::ceil(ref_per_output * static_cast<double>(num_values))) + 1;
+    std::vector<double> x(x_length);
+    double position = 0.0;
+    for (size_t idx = 0; idx < x_length; ++idx)
+    {
+        x[idx] = position;
+        position += (jittered ? 2.0 * uniform(rng) : 1.0) / ref_per_output;
+    }
+    std::vector<T> y(x_length);
+    for (size_t idx = 0; idx < x_length; ++idx)
+    {
+        randomSample(uniform, rng, y[idx]);
+    }
+    // Start before the first reference location, as streams do.
+    std::vector<double> xi(num_values);
+    for (size_t idx = 0; idx < num_values; ++idx)
+    {
+        xi[idx] = static_cast<double>(idx) - 0.5;
+    }
+    std::vector<T> yi(num_values), expected(num_values);
+
+    const bool is_complex = sizeof(T) != sizeof(double);
+    std::vector<double> y_r, y_i, yi_r, yi_i;
+    if (is_complex)
+    {
+        // Split copies, for the pre-R2018a MEX layout.
+        y_r.resize(x_length);
+        y_i.resize(x_length);
+        yi_r.resize(num_values);
+        yi_i.resize(num_values);
+        const double *interleaved = reinterpret_cast<const double*>(&y[0]);
+        for (size_t idx = 0; idx < x_length; ++idx)
+        {
+            y_r[idx] = interleaved[2 * idx];
+            y_i[idx] = interleaved[2 * idx + 1];
+        }
+    }
+
+    referenceResample(x, y, xi, expected);
+    resample(x, y, xi, yi);
+    bool passed = std::memcmp(&yi[0], &expected[0],
+                              num_values * sizeof(T)) == 0;
+
+    // The reference and output locations and samples.
+    const double num_bytes = (sizeof(double) + sizeof(T)) *
+        static_cast<double>(x_length + num_values);
+    const double seconds = timeCall(options, [&]() {
+        resample(x, y, xi, yi);
+    });
+    report(name, num_values, num_bytes, seconds, passed);
+
+    if (is_complex)
+    {
+        const oosiggen::SplitComplexSamples split = {
+            &y_r[0], &y_i[0], &yi_r[0], &yi_i[0]
+        };
+        oosiggen::resampleNearestLower(&x[0], x_length, &xi[0], num_values,
+                                       split);
+        const double *interleaved =
+            reinterpret_cast<const double*>(&expected[0]);
+        bool split_passed = true;
+        for (size_t idx = 0; idx < num_values && split_passed; ++idx)
+        {
+            split_passed = yi_r[idx] == interleaved[2 * idx] &&
+                           yi_i[idx] == interleaved[2 * idx + 1];
+        }
+        const double split_seconds = timeCall(options, [&]() {
+            oosiggen::resampleNearestLower(&x[0], x_length, &xi[0],
+                                           num_values, split);
+        });
+        report(name + " (split)", num_values, num_bytes,
+               split_seconds, split_passed);
+        passed = passed && split_passed;
+    }
+    return passed;
+}
+
+} // namespace
+
+/**
+ * @brief Run the benchmark sweep.
+ *
+ * @return Zero if every case matched its reference.
+ */
+int main(int argc, char *argv[])
+{
+    bool quick = false;
+    std::string filter;
+    for (int arg_idx = 1; arg_idx < argc; ++arg_idx)
+    {
+        if (std::strcmp(argv[arg_idx], "--quick") == 0)
+        {
+            quick = true;
+        }
+        else
+        {
+            filter = argv[arg_idx];
+        }
+    }
+    const TimingOptions options = {quick ? 0.01 : 0.05, quick ? 3u : 5u};
+
+    std::vector<size_t> break_counts, orders, value_counts;
+    if (quick)
+    {
+        const size_t quick_breaks[] = {64, 65536};
+        const size_t quick_orders[] = {2, 4};
+        const size_t quick_values[] = {4096, 262144};
+        break_counts.assign(quick_breaks, quick_breaks + 2);
+        orders.assign(quick_orders, quick_orders + 2);
+        value_counts.assign(quick_values, quick_values + 2);
+    }
+    else
+    {
+        const size_t full_breaks[] = {16, 1024, 65536, 1048576};
+        const size_t full_orders[] = {1, 2, 3, 4, 6};
+        const size_t full_values[] = {256, 4096, 65536, 1048576};
+        break_counts.assign(full_breaks, full_breaks + 4);
+        orders.assign(full_orders, full_orders + 5);
+        value_counts.assign(full_values, full_values + 4);
+    }
+    const double ref_ratios[] = {0.25, 1.0, 4.0};
+
+    std::mt19937 rng(1);
+    std::printf("%-58s %10s %9s\n", "case", "ns/sample", "GB/s");
+    bool passed = true;
+    for (size_t break_idx = 0; break_idx < break_counts.size(); ++break_idx)
+    {
+        for (size_t order_idx = 0; order_idx < orders.size(); ++order_idx)
+        {
+            for (size_t value_idx = 0; value_idx < value_counts.size();
+                 ++value_idx)
+            {
+                for (int sorted = 1; sorted >= 0; --sorted)
+                {
+                    char name[128];
+                    std::snprintf(name, sizeof(name),
+                                  "ppval breaks=%zu order=%zu n=%zu %s",
+                                  break_counts[break_idx], orders[order_idx],
+                                  value_counts[value_idx],
+                                  sorted ? "sorted" : "random");
+                    if (std::string(name).find(filter) == std::string::npos)
+                    {
+                        continue;
+                    }
+                    passed = benchmarkPpval(name, options,
+                                            break_counts[break_idx],
+                                            orders[order_idx],
+                                            value_counts[value_idx],
+                                            sorted != 0, rng) && passed;
+                }
+            }
+        }
+    }
+
+    for (size_t value_idx = 0; value_idx < value_counts.size(); ++value_idx)
+    {
+        for (size_t ratio_idx = 0; ratio_idx < 3; ++ratio_idx)
+        {
+            for (int jittered = 0; jittered <= 1; ++jittered)
+            {
+                for (int is_complex = 0; is_complex <= 1; ++is_complex)
+                {
+                    char name[128];
+                    std::snprintf(name, sizeof(name),
+                                  "resample ref/out=%g n=%zu %s %s",
+                                  ref_ratios[ratio_idx],
+                                  value_counts[value_idx],
+                                  jittered ? "random" : "uniform",
+                                  is_complex ? "complex" : "real");
+                    if (std::string(name).find(filter) == std::string::npos)
+                    {
+                        continue;
+                    }
+                    if (is_complex)
+                    {
+                        passed = benchmarkResample<std::complex<double> >(
+                            name, options, value_counts[value_idx],
+                            ref_ratios[ratio_idx], jittered != 0, rng) &&
+                            passed;
+                    }
+                    else
+                    {
+                        passed = benchmarkResample<double>(
+                            name, options, value_counts[value_idx],
+                            ref_ratios[ratio_idx], jittered != 0, rng) &&
+                            passed;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!passed)
+    {
+        std::printf("Some kernels did not match their references.\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**************************************************************************//**
+ * @brief      Compact storage for repeating chip sequences.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_CHIP_SOURCE_H_
+#define OOSIGGEN_CHIP_SOURCE_H_
+
+#include <cstddef>
+#include <cstring> // For memcpy().
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+namespace oosiggen
+{
+
+/**
+ * @brief A repeating chip sequence, expanded to doubles on demand.
+ *
+ * A sequence of +/-1 chips, such as any spreading code, is stored as one bit
+ * per chip, so that even long overlaid codes (the 204,600-subchip Galileo
+ * E1OS pilot occupies 25 KiB) stay cache-resident. Blocks are expanded four
+ * chips at a time from a 16-entry table, in runs that wrap around the end of
+ * the sequence, with no index vector or modular arithmetic per chip. Other
+ * sequences are stored as doubles and copied in the same runs.
+ */
+class ChipSource
+{
+public:
+    /**
+     * @param chips The chip sequence.
+     * @param num_chips The number of chips; must be positive.
+     */
+    ChipSource(const double *chips, size_t num_chips)
+        : size_(num_chips)
+    {
+        if (num_chips == 0)
+        {
+            throw std::invalid_argument("chips must not be empty.");
+        }
+
+        bool is_binary = true;
+        for (size_t idx = 0; idx < num_chips && is_binary; ++idx)
+        {
+            is_binary = chips[idx] == 1.0 || chips[idx] == -1.0;
+        }
+        if (!is_binary)
+        {
+            values_.assign(chips, chips + num_chips);
+            return;
+        }
+
+        // A set bit is a chip of -1.
+        bits_.assign((num_chips + 63) / 64, 0);
+        for (size_t idx = 0; idx < num_chips; ++idx)
+        {
+            if (chips[idx] < 0.0)
+            {
+                bits_[idx / 64] |= static_cast<uint64_t>(1) << (idx % 64);
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+
+    /**
+     * @brief True if the chips are stored as bits (all are +/-1).
+     */
+    bool isPacked() const { return values_.empty(); }
+
+    /**
+     * @brief The chip at a position.
+     */
+    double at(size_t index) const
+    {
+        if (!isPacked())
+        {
+            return values_[index];
+        }
+        return ((bits_[index / 64] >> (index % 64)) & 1) != 0 ? -1.0 : 1.0;
+    }
+
+    /**
+     * @brief Expand chips into doubles, wrapping around the end of the
+     *        sequence.
+     *
+     * @param start The position of the first chip; less than size().
+     * @param num_chips The number of chips to expand.
+     * @param out The output chips.
+     */
+    void expand(size_t start, size_t num_chips, double *out) const
+    {
+        while (num_chips > 0)
+        {
+            const size_t run = num_chips < size_ - start ?
+                               num_chips : size_ - start;
+            if (isPacked())
+            {
+                expandBits(start, run, out);
+            }
+            else
+            {
+                std::memcpy(out, &values_[start], run * sizeof(double));
+            }
+            out += run;
+            num_chips -= run;
+            start = 0;
+        }
+    }
+
+private:
+    /**
+     * @brief Expand a run of packed chips that does not wrap.
+     */
+    void expandBits(size_t start, size_t num_chips, double *out) const
+    {
+        // Each 4-bit group of the packed sequence, expanded.
+        static const double kNibbles[16][4] = {
+            { 1.0,  1.0,  1.0,  1.0}, {-1.0,  1.0,  1.0,  1.0},
+            { 1.0, -1.0,  1.0,  1.0}, {-1.0, -1.0,  1.0,  1.0},
+            { 1.0,  1.0, -1.0,  1.0}, {-1.0,  1.0, -1.0,  1.0},
+            { 1.0, -1.0, -1.0,  1.0}, {-1.0, -1.0, -1.0,  1.0},
+            { 1.0,  1.0,  1.0, -1.0}, {-1.0,  1.0,  1.0, -1.0},
+            { 1.0, -1.0,  1.0, -1.0}, {-1.0, -1.0,  1.0, -1.0},
+            { 1.0,  1.0, -1.0, -1.0}, {-1.0,  1.0, -1.0, -1.0},
+            { 1.0, -1.0, -1.0, -1.0}, {-1.0, -1.0, -1.0, -1.0}};
+
+        size_t index = start;
+        const size_t end = start + num_chips;
+        for (; index < end && index % 4 != 0; ++index)
+        {
+            *out++ = at(index);
+        }
+        for (; index + 4 <= end; index += 4)
+        {
+            const unsigned nibble =
+                static_cast<unsigned>(bits_[index / 64] >> (index % 64)) & 15;
+            std::memcpy(out, kNibbles[nibble], sizeof(kNibbles[0]));
+            out += 4;
+        }
+        for (; index < end; ++index)
+        {
+            *out++ = at(index);
+        }
+    }
+
+    std::vector<uint64_t> bits_; ///< Packed chips, when all are +/-1.
+    std::vector<double> values_; ///< The chips, otherwise.
+    size_t size_; ///< The number of chips.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_CHIP_SOURCE_H_
@@ -0,0 +1,203 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to compact repeating chip sequences.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <utility> // For move().
+
+#include "mex.h"
+
+#include "chip_source.h"
+#include "mex_handle_registry.h"
+
+namespace
+{
+
+/**
+ * @brief The chip sources owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::ChipSource> &sources()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::ChipSource>
+        registry("chipSourceCore");
+    return registry;
+}
+
+/**
+ * @brief Free all chip sources when the MEX file is cleared.
+ */
+void freeAllSources()
+{
+    sources().clear();
+}
+
+/**
+ * @brief Check that an argument is a real scalar double.
+ */
+bool isRealScalar(const mxArray *array)
+{
+    return array != NULL && mxIsDouble(array) && !mxIsComplex(array) &&
+           mxGetNumberOfElements(array) == 1;
+}
+
+/**
+ * @brief Create a chip source from a chip sequence.
+ */
+void createSource(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("create requires chips.");
+    }
+    if (!mxIsDouble(prhs[1]) || mxIsComplex(prhs[1]) || mxIsEmpty(prhs[1]))
+    {
+        mexErrMsgTxt("chips must be a non-empty real array of doubles.");
+    }
+
+    std::unique_ptr<oosiggen::ChipSource> source;
+    try
+    {
+        source.reset(new oosiggen::ChipSource(
+            static_cast<double*>(mxGetPr(prhs[1])),
+            mxGetNumberOfElements(prhs[1])));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = sources().add(std::move(source));
+}
+
+/**
+ * @brief Expand a block of chips, wrapping around the end of the sequence.
+ */
+void expandChips(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 4)
+    {
+        mexErrMsgTxt("expand requires a handle, start_index and num_chips.");
+    }
+    const oosiggen::ChipSource &source = sources().get(prhs[1]);
+    if (!isRealScalar(prhs[2]) || !isRealScalar(prhs[3]))
+    {
+        mexErrMsgTxt("start_index and num_chips must be real scalar "
+                     "doubles.");
+    }
+    const double start_index = mxGetScalar(prhs[2]);
+    const double num_chips = mxGetScalar(prhs[3]);
+    if (!(start_index >= 0.0) ||
+        !(start_index < static_cast<double>(source.size())))
+    {
+        mexErrMsgTxt("start_index exceeds the chip sequence.");
+    }
+    if (!(num_chips >= 0.0))
+    {
+        mexErrMsgTxt("num_chips must be non-negative.");
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(static_cast<mwSize>(num_chips), 1,
+                                   mxREAL);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+    source.expand(static_cast<size_t>(start_index),
+                  static_cast<size_t>(num_chips),
+                  static_cast<double*>(mxGetPr(plhs[0])));
+}
+
+/**
+ * @brief Free one or more chip sources.
+ */
+void freeSources(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    sources().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = chipSourceCore('create', chips)
+ * samples = chipSourceCore('expand', h, start_index, num_chips)
+ * chipSourceCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>prhs[1]</c>: The repeating chip sequence, a real array of doubles.
+ *   Sequences of +/-1 are stored as one bit per chip.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the new chip source.
+ *
+ * For @c 'expand':
+ * - <c>prhs[1]</c>: The chip source handle.
+ * - <c>prhs[2]</c>: The zero-indexed position of the first chip.
+ * - <c>prhs[3]</c>: The number of chips to expand.
+ * - <c>plhs[0]</c>: The chips, a column vector, continuing from the start of
+ *   the sequence after its end.
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllSources);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createSource(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "expand") == 0)
+    {
+        expandChips(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeSources(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
@@ -0,0 +1,392 @@
+/**************************************************************************//**
+ * @brief      Piecewise polynomials pre-processed for repeated fast
+ *             evaluation.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_COMPILED_SPLINE_H_
+#define OOSIGGEN_COMPILED_SPLINE_H_
+
+#include <algorithm> // For min().
+#include <cmath> // For fabs(), floor().
+#include <cstring> // For memcmp(), memcpy().
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "ppval_kernel.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief A piecewise polynomial stored for fast repeated evaluation.
+ *
+ * The coefficients are held in an aligned, row-major copy so that each
+ * polynomial occupies contiguous memory, and the fenceposts may be shared
+ * with other splines fitted on the same grid (see BreaksPool). The bin found
+ * by the last evaluation is retained, so consecutive calls with ascending
+ * x-axis locations (successive chunks of a time axis) resume the search where
+ * the previous call stopped.
+ */
+class CompiledSpline
+{
+public:
+    typedef AlignedBuffer<double> Breaks; ///< Fencepost storage.
+
+    /**
+     * @brief Create a spline with zeroed coefficients, to be filled in through
+     *        coefficients().
+     *
+     * @param breaks The fencepost locations, sorted ascending; must hold at
+     *        least two elements.
+     * @param order The polynomial order (number of coefficients per bin).
+     */
+    CompiledSpline(const std::shared_ptr<const Breaks> &breaks, size_t order)
+        : breaks_(breaks), order_(order), cursor_(0)
+    {
+        if (!breaks_ || breaks_->size() < 2)
+        {
+            throw std::invalid_argument(
+                "breaks must contain at least two fenceposts.");
+        }
+        coefs_.resize(numPolynomials() * order_);
+        coefs_.zero();
+    }
+
+    /**
+     * @brief Create a spline from a MATLAB column-major coefficient matrix.
+     *
+     * @param breaks The fencepost locations, sorted ascending.
+     * @param coefs The coefficient matrix (<c>breaks->size() - 1</c> x
+     *        @c order, highest power first).
+     * @param order The polynomial order.
+     */
+    CompiledSpline(const std::shared_ptr<const Breaks> &breaks,
+                   const double *coefs, size_t order)
+        : breaks_(breaks), order_(order), cursor_(0)
+    {
+        if (!breaks_ || breaks_->size() < 2)
+        {
+            throw std::invalid_argument(
+                "breaks must contain at least two fenceposts.");
+        }
+        coefs_.resize(numPolynomials() * order_);
+        transposeCoefficients(coefs, numPolynomials(), order_, coefs_.data());
+    }
+
+    size_t numBreaks() const { return breaks_->size(); }
+    size_t numPolynomials() const { return breaks_->size() - 1; }
+    size_t order() const { return order_; }
+    const double *breaks() const { return breaks_->data(); }
+    double firstBreak() const { return (*breaks_)[0]; }
+    double lastBreak() const { return (*breaks_)[breaks_->size() - 1]; }
+
+    /**
+     * @brief The shared fencepost storage; splines with the same storage
+     *        always have the same bins.
+     */
+    const Breaks *breaksStorage() const { return breaks_.get(); }
+
+    /**
+     * @brief The row-major coefficients (@c order values per polynomial,
+     *        highest power first).
+     */
+    double *coefficients() { return coefs_.data(); }
+    const double *coefficients() const { return coefs_.data(); }
+
+    /**
+     * @brief The coefficient layout, for use with the ppval_kernel.h
+     *        functions.
+     */
+    CoefficientLayout layout() const
+    {
+        return rowMajorLayout(coefs_.data(), order_);
+    }
+
+    /**
+     * @brief The retained search cursor (the last bin found).
+     */
+    size_t &cursor() { return cursor_; }
+
+    /**
+     * @brief Evaluate the spline at a set of x-axis locations.
+     *
+     * @param xx The x-axis locations.
+     * @param num_values The number of elements of @c xx.
+     * @param v The output values, one per element of @c xx.
+     */
+    void evaluate(const double *xx, size_t num_values, double *v)
+    {
+        evaluatePiecewisePolynomial(breaks(), numBreaks(), layout(), xx,
+                                    num_values, v, cursor_);
+    }
+
+    /**
+     * @brief Evaluate the spline at a single x-axis location.
+     */
+    double evaluate(double x)
+    {
+        const size_t bin = findBinFromCursor(breaks(), numBreaks(), x,
+                                             cursor_);
+        return evaluatePolynomial(layout(), bin, x - (*breaks_)[bin]);
+    }
+
+    /**
+     * @brief Find the x-axis location at which an increasing spline, such as
+     *        a time mapping, takes a value.
+     *
+     * Newton's method is run from @c guess, moving between bins as needed. A
+     * guess close to the solution, such as the solution for the previous
+     * value of an ascending sequence advanced by the local slope, converges
+     * in one or two iterations.
+     *
+     * @param y The value to invert.
+     * @param guess An initial estimate of the location.
+     *
+     * @return The location, limited to the first and last breaks.
+     */
+    double invert(double y, double guess)
+    {
+        const double lower = firstBreak();
+        const double upper = lastBreak();
+        double x = guess < lower ? lower : (guess > upper ? upper : guess);
+        for (size_t iteration = 0; iteration < kMaxInverseIterations;
+             ++iteration)
+        {
+            const size_t bin = findBinFromCursor(breaks(), numBreaks(), x,
+                                                 cursor_);
+            const double delta_x = x - (*breaks_)[bin];
+            const double *c = &coefs_[bin * order_];
+
+            // Horner's method for the value and slope together.
+            double value = order_ > 0 ? c[0] : 0.0;
+            double slope = 0.0;
+            for (size_t coef_idx = 1; coef_idx < order_; ++coef_idx)
+            {
+                slope = delta_x * slope + value;
+                value = delta_x * value + c[coef_idx];
+            }
+            if (!(slope > 0.0))
+            {
+                break;
+            }
+
+            double next = x - (value - y) / slope;
+            next = next < lower ? lower : (next > upper ? upper : next);
+            const double step = next - x;
+            x = next;
+            if (std::fabs(step) <= 1e-15 * (std::fabs(x) + 1.0))
+            {
+                break;
+            }
+        }
+        return x;
+    }
+
+    /**
+     * @brief Create the antiderivative of the spline, such as the phase (in
+     *        cycles) of a Doppler profile (in Hz).
+     *
+     * Each polynomial is integrated exactly, giving a spline of one order
+     * higher on the same fenceposts, zero at the first break. The constant
+     * term of each bin accumulates the integrals of the bins before it;
+     * given a @c period, it is reduced modulo the period, so the values
+     * stay small and keep their precision over arbitrarily long profiles,
+     * but are then only meaningful modulo the period.
+     *
+     * @param period The period to reduce the constants by, or zero to keep
+     *        them whole.
+     *
+     * @return The antiderivative, sharing this spline's fencepost storage.
+     */
+    std::unique_ptr<CompiledSpline> integral(double period) const
+    {
+        std::unique_ptr<CompiledSpline> result(
+            new CompiledSpline(breaks_, order_ + 1));
+        const size_t order = order_ + 1;
+        double constant = 0.0;
+        for (size_t bin = 0; bin < numPolynomials(); ++bin)
+        {
+            const double *c = &coefs_[bin * order_];
+            double *integral_c = &result->coefs_[bin * order];
+            for (size_t coef_idx = 0; coef_idx < order_; ++coef_idx)
+            {
+                integral_c[coef_idx] =
+                    c[coef_idx] / static_cast<double>(order_ - coef_idx);
+            }
+            integral_c[order_] = constant;
+
+            // The value at the end of the bin starts the next one.
+            const double width = (*breaks_)[bin + 1] - (*breaks_)[bin];
+            double value = 0.0;
+            for (size_t coef_idx = 0; coef_idx < order; ++coef_idx)
+            {
+                value = value * width + integral_c[coef_idx];
+            }
+            constant = period > 0.0 ?
+                       value - period * std::floor(value / period) : value;
+        }
+        return result;
+    }
+
+private:
+    /// The most Newton iterations run by invert().
+    static const size_t kMaxInverseIterations = 8;
+
+    CompiledSpline(const CompiledSpline&);
+    CompiledSpline &operator=(const CompiledSpline&);
+
+    std::shared_ptr<const Breaks> breaks_; ///< Fencepost locations.
+    AlignedBuffer<double> coefs_; ///< Row-major coefficients.
+    size_t order_; ///< Number of coefficients per polynomial.
+    size_t cursor_; ///< Bin found by the previous lookup.
+};
+
+/**
+ * @brief Deduplicates fencepost storage, so that splines fitted on the same
+ *        grid share one copy of their breaks.
+ *
+ * Sharing keeps the breaks resident in cache once and lets
+ * evaluateCompiledSplines() detect shared bins with a pointer comparison.
+ */
+class BreaksPool
+{
+public:
+    /**
+     * @brief Get shared storage holding a copy of the given fenceposts,
+     *        reusing existing storage with identical contents if any is still
+     *        alive.
+     */
+    std::shared_ptr<const CompiledSpline::Breaks> intern(const double *breaks,
+                                                         size_t num_breaks)
+    {
+        const unsigned long long key = hash(breaks, num_breaks);
+        std::vector<std::weak_ptr<const CompiledSpline::Breaks> > &bucket =
+            buckets_[key];
+        for (size_t idx = 0; idx < bucket.size();)
+        {
+            std::shared_ptr<const CompiledSpline::Breaks> existing =
+                bucket[idx].lock();
+            if (!existing)
+            {
+                // Drop storage whose splines have all been freed.
+                bucket.erase(bucket.begin() + idx);
+                continue;
+            }
+            if (existing->size() == num_breaks &&
+                std::memcmp(existing->data(), breaks,
+                            num_breaks * sizeof(double)) == 0)
+            {
+                return existing;
+            }
+            ++idx;
+        }
+
+        std::shared_ptr<CompiledSpline::Breaks> storage(
+            new CompiledSpline::Breaks(num_breaks));
+        std::memcpy(storage->data(), breaks, num_breaks * sizeof(double));
+        bucket.push_back(storage);
+        return storage;
+    }
+
+private:
+    /// FNV-1a hash of the fencepost bytes.
+    static unsigned long long hash(const double *breaks, size_t num_breaks)
+    {
+        const unsigned char *bytes =
+            reinterpret_cast<const unsigned char*>(breaks);
+        unsigned long long h = 14695981039346656037ULL;
+        for (size_t idx = 0; idx < num_breaks * sizeof(double); ++idx)
+        {
+            h = (h ^ bytes[idx]) * 1099511628211ULL;
+        }
+        return h;
+    }
+
+    std::map<unsigned long long,
+             std::vector<std::weak_ptr<const CompiledSpline::Breaks> > >
+        buckets_; ///< Live fencepost storage, by content hash.
+};
+
+/**
+ * @brief Evaluate several compiled splines at the same x-axis locations in a
+ *        single pass.
+ *
+ * Splines sharing fencepost storage are grouped so that the bin search is
+ * performed once per group. The search for a group starts from the cursor of
+ * its first member, and every member's cursor is updated afterwards.
+ *
+ * @param splines The splines to evaluate.
+ * @param num_splines The number of elements of @c splines.
+ * @param xx The x-axis locations.
+ * @param num_values The number of elements of @c xx.
+ * @param outputs The output vectors, one per spline, each with
+ *        @c num_values elements.
+ */
+inline void evaluateCompiledSplines(CompiledSpline *const *splines,
+                                    size_t num_splines, const double *xx,
+                                    size_t num_values, double *const *outputs)
+{
+    // Group the members by fencepost storage.
+    std::vector<std::vector<size_t> > groups;
+    for (size_t spline_idx = 0; spline_idx < num_splines; ++spline_idx)
+    {
+        size_t group_idx = 0;
+        while (group_idx < groups.size() &&
+               splines[groups[group_idx][0]]->breaksStorage() !=
+               splines[spline_idx]->breaksStorage())
+        {
+            ++group_idx;
+        }
+        if (group_idx == groups.size())
+        {
+            groups.push_back(std::vector<size_t>());
+        }
+        groups[group_idx].push_back(spline_idx);
+    }
+
+    size_t bins[kEvaluationBlockSize];
+    for (size_t group_idx = 0; group_idx < groups.size(); ++group_idx)
+    {
+        const std::vector<size_t> &members = groups[group_idx];
+        CompiledSpline &lead = *splines[members[0]];
+        size_t cursor = lead.cursor();
+        for (size_t start = 0; start < num_values;
+             start += kEvaluationBlockSize)
+        {
+            const size_t block_size = std::min(kEvaluationBlockSize,
+                                               num_values - start);
+            findBins(lead.breaks(), lead.numBreaks(), &xx[start], block_size,
+                     bins, cursor);
+            for (size_t member_idx = 0; member_idx < members.size();
+                 ++member_idx)
+            {
+                const size_t spline_idx = members[member_idx];
+                evaluateBins(lead.breaks(), splines[spline_idx]->layout(),
+                             &xx[start], bins, block_size,
+                             &outputs[spline_idx][start]);
+            }
+        }
+        for (size_t member_idx = 0; member_idx < members.size(); ++member_idx)
+        {
+            splines[members[member_idx]]->cursor() = cursor;
+        }
+    }
+}
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_COMPILED_SPLINE_H_
@@ -0,0 +1,804 @@
+/**************************************************************************//**
+ * @brief      Native composite signal engine implementation.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include "composite_engine.h"
+
+#include <algorithm> // For copy(), fill(), min().
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <utility> // For move().
+
+namespace oosiggen
+{
+
+namespace
+{
+
+const double kPi = 3.14159265358979323846;
+const double kTwoPi = 2.0 * kPi;
+
+/// The number of consecutive samples rotated at once by the FDMA rotators.
+const size_t kFdmaLanes = 4;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Add the time since @c start, and a block of samples, to a set of
+ *        statistics.
+ */
+void addElapsed(const Clock::time_point &start, size_t num_samples,
+                RenderStatistics &statistics)
+{
+    ++statistics.blocks;
+    statistics.seconds +=
+        std::chrono::duration<double>(Clock::now() - start).count();
+    statistics.samples += num_samples;
+}
+
+/**
+ * @brief Rotate a group of samples, one per lane, and add them to partial
+ *        sums; then step each lane's rotator.
+ *
+ * The arithmetic is that of ncoRotateConstant(), so the rotated samples are
+ * bit-for-bit the same.
+ */
+inline void rotateAdd(const double *real, const double *imag,
+                      size_t num_lanes, double step_real, double step_imag,
+                      double *rotator_real, double *rotator_imag,
+                      double *sum_real, double *sum_imag)
+{
+    for (size_t lane = 0; lane < num_lanes; ++lane)
+    {
+        const double r_real = rotator_real[lane];
+        const double r_imag = rotator_imag[lane];
+        const double out_real = real[lane] * r_real - imag[lane] * r_imag;
+        const double out_imag = real[lane] * r_imag + imag[lane] * r_real;
+        sum_real[lane] += out_real;
+        sum_imag[lane] += out_imag;
+        rotator_real[lane] = r_real * step_real - r_imag * step_imag;
+        rotator_imag[lane] = r_real * step_imag + r_imag * step_real;
+    }
+}
+
+} // namespace
+
+const size_t SignalStream::kBlockSize;
+const size_t SignalStream::kInversionInterval;
+const size_t CompositeEngine::kDefaultBlockSize;
+const size_t CompositeEngine::kReductionSize;
+const size_t CompositeEngine::kReductionStreams;
+
+SignalStream::SignalStream(const StreamDescriptor &descriptor,
+                           double time_offset, bool direct_synthesis)
+    : descriptor_(descriptor),
+      chips_(descriptor.chips.empty() ? NULL : &descriptor.chips[0],
+             descriptor.chips.size()),
+      time_offset_(time_offset),
+      direct_synthesis_(direct_synthesis), chip_counter_(0),
+      chip_index_(descriptor.start_index), segment_index_(0),
+      symbol_index_(0), phase_offset_(descriptor.carrier_phase),
+      start_time_(0.0), end_signal_time_(0.0),
+      inverted_true_time_(0.0),
+      inverted_signal_time_(descriptor.signal_time),
+      amplitude_point_(std::numeric_limits<double>::quiet_NaN()),
+      amplitude_left_(0.0), amplitude_right_(0.0), amplitude_exact_(false),
+      chip_values_(direct_synthesis ? 0 : kBlockSize),
+      signal_times_(kBlockSize), true_times_(kBlockSize),
+      amplitude_(kBlockSize),
+      real_(kBlockSize), imag_(kBlockSize),
+      chip_offsets_(direct_synthesis ? kBlockSize : 0)
+{
+    if (descriptor_.start_index >= chips_.size())
+    {
+        throw std::invalid_argument("start_index exceeds the chip sequence.");
+    }
+    if (!(descriptor_.chip_rate > 0.0))
+    {
+        throw std::invalid_argument("chip_rate must be positive.");
+    }
+    if (descriptor_.segment_length == 0)
+    {
+        throw std::invalid_argument("segment_length must be positive.");
+    }
+
+    // Only the compact copy of the chips is kept.
+    std::vector<double>().swap(descriptor_.chips);
+
+    // The true time of the first chip, where the carrier phase is the
+    // initial carrier phase.
+    const double start_time = descriptor_.signal_time_spline ?
+        descriptor_.signal_time_spline->evaluate(descriptor_.signal_time) :
+        descriptor_.signal_time;
+    if (descriptor_.doppler_spline)
+    {
+        doppler_phase_ = descriptor_.doppler_spline->integral(1.0);
+        phase_offset_ -= kTwoPi * doppler_phase_->evaluate(start_time);
+    }
+
+    if (direct_synthesis_)
+    {
+        start_time_ = start_time;
+        inverted_true_time_ = start_time_;
+        if (descriptor_.signal_time_spline)
+        {
+            // As when generating chips, the stream ends at the last chip
+            // before the end of the profile.
+            const double num_chips = std::ceil(
+                (descriptor_.signal_time_spline->lastBreak() -
+                 descriptor_.signal_time) * descriptor_.chip_rate);
+            end_signal_time_ = descriptor_.signal_time +
+                               (num_chips - 1.0) / descriptor_.chip_rate;
+        }
+    }
+}
+
+void SignalStream::render(const double *times, size_t num_samples,
+                          double *real, double *imag)
+{
+    if (num_samples == 0)
+    {
+        return;
+    }
+
+    if (direct_synthesis_)
+    {
+        synthesize(times, num_samples, real, imag);
+    }
+    else
+    {
+        // Generate chips until they cover the last output time.
+        const double time_max = times[num_samples - 1];
+        while (!resampler_.finished() &&
+               (resampler_.empty() || resampler_.lastTime() < time_max))
+        {
+            generateBlock();
+        }
+        resampler_.resample(times, num_samples, real, imag);
+    }
+}
+
+void SignalStream::generateBlock()
+{
+    // Signal time of each chip; computed from the chip count rather than
+    // accumulated, so it does not drift over long runs.
+    size_t count = kBlockSize;
+    const double chip_period = 1.0 / descriptor_.chip_rate;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        signal_times_[idx] = descriptor_.signal_time +
+            static_cast<double>(chip_counter_ + idx) * chip_period;
+    }
+
+    // Transform to true time via time dilation. Only chips inside the
+    // definition of the signal time profile are generated.
+    bool stream_ended = false;
+    const double *true_times = signal_times_.data();
+    if (descriptor_.signal_time_spline)
+    {
+        CompiledSpline &spline = *descriptor_.signal_time_spline;
+        const double last_break = spline.lastBreak();
+        count = static_cast<size_t>(
+            std::lower_bound(signal_times_.data(),
+                             signal_times_.data() + count, last_break) -
+            signal_times_.data());
+        stream_ended = count < kBlockSize;
+        spline.evaluate(signal_times_.data(), count, true_times_.data());
+        true_times = true_times_.data();
+    }
+    if (count == 0)
+    {
+        resampler_.finish();
+        return;
+    }
+
+    const bool use_power = static_cast<bool>(descriptor_.power_spline);
+    if (use_power)
+    {
+        evaluateAmplitude(true_times, count, amplitude_.data());
+    }
+
+    chips_.expand(chip_index_, count, chip_values_.data());
+    chip_index_ = (chip_index_ + count) % chips_.size();
+
+    const std::vector<std::complex<double> > &symbols = descriptor_.symbols;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        // Code and data modulation.
+        std::complex<double> sample(chip_values_[idx], 0.0);
+        if (symbol_index_ < symbols.size())
+        {
+            sample *= symbols[symbol_index_];
+        }
+        if (++segment_index_ == descriptor_.segment_length)
+        {
+            segment_index_ = 0;
+            ++symbol_index_;
+        }
+
+        // Amplitude modulation specified by the power profile.
+        if (use_power)
+        {
+            sample *= amplitude_[idx];
+        }
+
+        real_[idx] = sample.real();
+        imag_[idx] = sample.imag();
+    }
+
+    // Doppler shift, from the carrier phase at each chip's true time.
+    if (doppler_phase_)
+    {
+        ncoRotateSpline(phase_offset_, *doppler_phase_, true_times, count,
+                        real_.data(), imag_.data(), real_.data(),
+                        imag_.data());
+    }
+    chip_counter_ += count;
+
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        true_times_[idx] = true_times[idx] + time_offset_;
+    }
+
+    resampler_.append(true_times_.data(), real_.data(), imag_.data(), count);
+    if (stream_ended)
+    {
+        resampler_.finish();
+    }
+}
+
+void SignalStream::synthesize(const double *times, size_t num_samples,
+                              double *real, double *imag)
+{
+    CompiledSpline *signal_time_spline = descriptor_.signal_time_spline.get();
+    const std::vector<std::complex<double> > &symbols = descriptor_.symbols;
+    const bool use_power = static_cast<bool>(descriptor_.power_spline);
+    for (size_t start = 0; start < num_samples; start += kBlockSize)
+    {
+        const size_t count = std::min(kBlockSize, num_samples - start);
+        double *out_real = real + start;
+        double *out_imag = imag + start;
+
+        // The true time of each output sample, and the signal time at which
+        // it was transmitted. The profile is inverted at every
+        // kInversionInterval-th sample, each inversion starting from the
+        // previous solution advanced by the elapsed true time; the time
+        // mapping is so nearly linear over such an interval that the signal
+        // times between are interpolated to well below a picosecond.
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            true_times_[idx] = times[start + idx] - time_offset_;
+        }
+        if (signal_time_spline != NULL)
+        {
+            const double first_break = signal_time_spline->firstBreak();
+            const double last_break = signal_time_spline->lastBreak();
+            size_t previous = 0;
+            bool previous_is_inside = true;
+            for (size_t anchor = 0; anchor < count;
+                 anchor = anchor + 1 < count ?
+                          std::min(anchor + kInversionInterval, count - 1) :
+                          count)
+            {
+                const double true_time = true_times_[anchor];
+                const double signal_time = signal_time_spline->invert(
+                    true_time, inverted_signal_time_ +
+                               (true_time - inverted_true_time_));
+                inverted_true_time_ = true_time;
+                inverted_signal_time_ = signal_time;
+                signal_times_[anchor] = signal_time;
+
+                // Interpolation is only valid inside the profile. Samples
+                // between two anchors limited to the same break are limited
+                // too, and any others next to a limited anchor are inverted
+                // individually.
+                const bool is_inside = signal_time > first_break &&
+                                       signal_time < last_break;
+                const double previous_time = signal_times_[previous];
+                const double slope = anchor > previous ?
+                    (signal_time - previous_time) /
+                    static_cast<double>(anchor - previous) : 0.0;
+                for (size_t idx = previous + 1; idx < anchor; ++idx)
+                {
+                    if (is_inside && previous_is_inside)
+                    {
+                        signal_times_[idx] = previous_time +
+                            slope * static_cast<double>(idx - previous);
+                    }
+                    else if (signal_time == previous_time)
+                    {
+                        signal_times_[idx] = signal_time;
+                    }
+                    else
+                    {
+                        signal_times_[idx] = signal_time_spline->invert(
+                            true_times_[idx], signal_times_[idx - 1] +
+                            (true_times_[idx] - true_times_[idx - 1]));
+                    }
+                }
+                previous = anchor;
+                previous_is_inside = is_inside;
+            }
+        }
+        else
+        {
+            std::copy(true_times_.data(), true_times_.data() + count,
+                      signal_times_.data());
+        }
+
+        // Samples before the first chip, or transmitted after the last chip
+        // inside the signal time profile, are zero; the times ascend, so the
+        // remaining samples are contiguous.
+        size_t first = 0;
+        while (first < count && true_times_[first] < start_time_)
+        {
+            ++first;
+        }
+        size_t end = count;
+        if (signal_time_spline != NULL)
+        {
+            end = static_cast<size_t>(
+                std::upper_bound(signal_times_.data() + first,
+                                 signal_times_.data() + count,
+                                 end_signal_time_) -
+                signal_times_.data());
+        }
+        std::fill(out_real, out_real + first, 0.0);
+        std::fill(out_imag, out_imag + first, 0.0);
+        std::fill(out_real + end, out_real + count, 0.0);
+        std::fill(out_imag + end, out_imag + count, 0.0);
+        if (first == end)
+        {
+            continue;
+        }
+        const size_t valid = end - first;
+        const double *true_times = true_times_.data() + first;
+
+        // The chip of each sample, as an offset from the block's first chip.
+        const double *signal_times = signal_times_.data() + first;
+        const double first_phase =
+            (signal_times[0] - descriptor_.signal_time) *
+            descriptor_.chip_rate;
+        const double first_chip = first_phase > 0.0 ?
+                                  std::floor(first_phase) : 0.0;
+        for (size_t idx = 0; idx < valid; ++idx)
+        {
+            const double offset =
+                (signal_times[idx] - descriptor_.signal_time) *
+                descriptor_.chip_rate - first_chip;
+            chip_offsets_[idx] = offset > 0.0 ?
+                                 static_cast<uint32_t>(offset) : 0;
+        }
+
+        // Code and data modulation of the chips the block spans, which are
+        // then looked up per sample.
+        const size_t num_chips = chip_offsets_[valid - 1] + 1;
+        if (real_.size() < num_chips)
+        {
+            real_.resize(num_chips);
+            imag_.resize(num_chips);
+        }
+        seekChip(static_cast<unsigned long long>(first_chip));
+        chips_.expand(chip_index_, num_chips, real_.data());
+        size_t symbol_index = symbol_index_;
+        for (size_t chip = 0; chip < num_chips; ++symbol_index)
+        {
+            const size_t run_end = std::min(
+                num_chips, chip + descriptor_.segment_length -
+                           (chip == 0 ? segment_index_ : 0));
+            const std::complex<double> symbol =
+                symbol_index < symbols.size() ? symbols[symbol_index] :
+                                                std::complex<double>(1.0, 0.0);
+            for (; chip < run_end; ++chip)
+            {
+                imag_[chip] = real_[chip] * symbol.imag();
+                real_[chip] *= symbol.real();
+            }
+        }
+        for (size_t idx = 0; idx < valid; ++idx)
+        {
+            out_real[first + idx] = real_[chip_offsets_[idx]];
+            out_imag[first + idx] = imag_[chip_offsets_[idx]];
+        }
+
+        // Amplitude modulation specified by the power profile.
+        if (use_power)
+        {
+            evaluateAmplitude(true_times, valid, amplitude_.data());
+            for (size_t idx = 0; idx < valid; ++idx)
+            {
+                out_real[first + idx] *= amplitude_[idx];
+                out_imag[first + idx] *= amplitude_[idx];
+            }
+        }
+
+        // Doppler shift, from the carrier phase at each sample's true time.
+        if (doppler_phase_)
+        {
+            ncoRotateSpline(phase_offset_, *doppler_phase_, true_times, valid,
+                            out_real + first, out_imag + first,
+                            out_real + first, out_imag + first);
+        }
+    }
+}
+
+void SignalStream::evaluateAmplitude(const double *times,
+                                     size_t num_samples, double *amplitude)
+{
+    CompiledSpline &power = *descriptor_.power_spline;
+    const double interval = descriptor_.amplitude_interval;
+    if (!(interval > 0.0))
+    {
+        power.evaluate(times, num_samples, amplitude);
+        for (size_t idx = 0; idx < num_samples; ++idx)
+        {
+            amplitude[idx] = std::sqrt(amplitude[idx]);
+        }
+        return;
+    }
+
+    const double *breaks = power.breaks();
+    const double *breaks_end = breaks + power.numBreaks();
+    for (size_t idx = 0; idx < num_samples; ++idx)
+    {
+        const double position = times[idx] / interval;
+        const double point = std::floor(position);
+        if (point != amplitude_point_)
+        {
+            // A cell that contains a break of the profile, where the
+            // amplitude may step or kink, is evaluated exactly, as in
+            // SignalGenerator.evaluateAmplitude().
+            const double *next_break = std::lower_bound(
+                breaks, breaks_end, point,
+                [interval](double value, double cell)
+                { return value / interval < cell; });
+            const bool was_exact = amplitude_exact_;
+            amplitude_exact_ = next_break != breaks_end &&
+                               *next_break / interval <= point + 1.0;
+            if (!amplitude_exact_)
+            {
+                // Successive samples usually move on by a single grid
+                // point, whose left amplitude is then already known.
+                amplitude_left_ =
+                    point == amplitude_point_ + 1.0 && !was_exact ?
+                    amplitude_right_ :
+                    std::sqrt(power.evaluate(point * interval));
+                amplitude_right_ = std::sqrt(
+                    power.evaluate((point + 1.0) * interval));
+            }
+            amplitude_point_ = point;
+        }
+        amplitude[idx] = amplitude_exact_ ?
+            std::sqrt(power.evaluate(times[idx])) :
+            amplitude_left_ +
+            (position - point) * (amplitude_right_ - amplitude_left_);
+    }
+}
+
+void SignalStream::seekChip(unsigned long long chip)
+{
+    const size_t num_chips = chips_.size();
+    const size_t segment_length = descriptor_.segment_length;
+    if (chip < chip_counter_ || chip - chip_counter_ >= num_chips)
+    {
+        chip_index_ = static_cast<size_t>(
+            (descriptor_.start_index + chip) % num_chips);
+        segment_index_ = static_cast<size_t>(chip % segment_length);
+        symbol_index_ = static_cast<size_t>(chip / segment_length);
+        chip_counter_ = chip;
+        return;
+    }
+
+    // Successive blocks normally advance by fewer chips than the sequence
+    // holds, so the positions are stepped rather than recomputed.
+    const size_t step = static_cast<size_t>(chip - chip_counter_);
+    chip_index_ += step;
+    if (chip_index_ >= num_chips)
+    {
+        chip_index_ -= num_chips;
+    }
+    segment_index_ += step;
+    if (segment_index_ >= segment_length)
+    {
+        symbol_index_ += segment_index_ / segment_length;
+        segment_index_ %= segment_length;
+    }
+    chip_counter_ = chip;
+}
+
+CompositeEngine::CompositeEngine(double sampling_rate, double time_offset,
+                                 size_t num_threads, bool direct_synthesis)
+    : sampling_rate_(sampling_rate), time_offset_(time_offset),
+      direct_synthesis_(direct_synthesis), block_size_(kDefaultBlockSize),
+      profiling_(false), buffer_stride_(0), times_(kDefaultBlockSize),
+      pool_(num_threads)
+{
+    if (!(sampling_rate_ > 0.0))
+    {
+        throw std::invalid_argument("sampling_rate must be positive.");
+    }
+}
+
+void CompositeEngine::addStream(const StreamDescriptor &descriptor,
+                                unsigned long long first_sample)
+{
+    std::unique_ptr<SignalStream> stream(
+        new SignalStream(descriptor, time_offset_, direct_synthesis_));
+    streams_.push_back(std::move(stream));
+    fdma_cycles_.push_back(descriptor.fdma_offset / sampling_rate_);
+    fdma_phases_.push_back(descriptor.fdma_phase);
+    fdma_references_.push_back(first_sample);
+    fdma_block_phases_.push_back(0.0);
+    stream_statistics_.push_back(RenderStatistics());
+}
+
+void CompositeEngine::setBlockSize(size_t block_size)
+{
+    if (block_size == 0)
+    {
+        throw std::invalid_argument("block_size must be positive.");
+    }
+    block_size_ = block_size;
+    times_.resize(block_size_);
+    // The buffers are reallocated by the next render.
+    buffer_stride_ = 0;
+}
+
+void CompositeEngine::allocateBuffers()
+{
+    const size_t line = AlignedBuffer<double>::kAlignment / sizeof(double);
+    buffer_stride_ = ((block_size_ + line - 1) / line) * line;
+    buffer_real_.resize(streams_.size() * buffer_stride_);
+    buffer_imag_.resize(streams_.size() * buffer_stride_);
+}
+
+double CompositeEngine::fdmaPhase(size_t stream_idx,
+                                  unsigned long long sample) const
+{
+    // The phase is computed from the sample's index relative to the
+    // stream's reference, in cycles, so it is continuous across blocks and
+    // calls. A block may start before the stream's first sample, so the
+    // index may be negative.
+    const unsigned long long reference = fdma_references_[stream_idx];
+    const double sample_index = sample >= reference ?
+        static_cast<double>(sample - reference) :
+        -static_cast<double>(reference - sample);
+    return fdma_phases_[stream_idx] + kTwoPi *
+        ncoFractionalCycles(fdma_cycles_[stream_idx], sample_index);
+}
+
+void CompositeEngine::accumulate(size_t first_stream, size_t num_streams,
+                                 size_t range_start, size_t range_size,
+                                 double *sum_real, double *sum_imag) const
+{
+    const double *real[kReductionStreams];
+    const double *imag[kReductionStreams];
+    bool rotated = false;
+    for (size_t stream = 0; stream < num_streams; ++stream)
+    {
+        const size_t offset =
+            (first_stream + stream) * buffer_stride_ + range_start;
+        real[stream] = buffer_real_.data() + offset;
+        imag[stream] = buffer_imag_.data() + offset;
+        rotated = rotated || fdma_cycles_[first_stream + stream] != 0.0;
+    }
+
+    if (!rotated)
+    {
+        // Each sum is loaded and stored once per pass rather than once per
+        // stream; the additions are in the same order either way.
+        if (num_streams == kReductionStreams)
+        {
+            for (size_t idx = 0; idx < range_size; ++idx)
+            {
+                sum_real[idx] = sum_real[idx] + real[0][idx] +
+                                real[1][idx] + real[2][idx] + real[3][idx];
+                sum_imag[idx] = sum_imag[idx] + imag[0][idx] +
+                                imag[1][idx] + imag[2][idx] + imag[3][idx];
+            }
+            return;
+        }
+        for (size_t stream = 0; stream < num_streams; ++stream)
+        {
+            for (size_t idx = 0; idx < range_size; ++idx)
+            {
+                sum_real[idx] += real[stream][idx];
+                sum_imag[idx] += imag[stream][idx];
+            }
+        }
+        return;
+    }
+
+    // The rotators are those of ncoRotateConstant() over the whole block: a
+    // lane per sample of each group of kFdmaLanes, stepped by recursive
+    // multiplication and resynchronized every kNcoResyncInterval samples of
+    // the block. A range starts on a resynchronization, so every rotated
+    // sample, and hence every sum, is as if each buffer had been rotated in
+    // full before the summation.
+    double cycles[kReductionStreams];
+    double step_real[kReductionStreams];
+    double step_imag[kReductionStreams];
+    for (size_t stream = 0; stream < num_streams; ++stream)
+    {
+        cycles[stream] = fdma_cycles_[first_stream + stream];
+        const double lane_cycles =
+            cycles[stream] * static_cast<double>(kFdmaLanes);
+        const std::complex<double> lane_step = std::polar(
+            1.0, kTwoPi * (lane_cycles - std::floor(lane_cycles)));
+        step_real[stream] = lane_step.real();
+        step_imag[stream] = lane_step.imag();
+    }
+
+    double rotator_real[kReductionStreams][kFdmaLanes];
+    double rotator_imag[kReductionStreams][kFdmaLanes];
+    for (size_t start = 0; start < range_size; start += kNcoResyncInterval)
+    {
+        const size_t end = std::min(start + kNcoResyncInterval, range_size);
+        for (size_t stream = 0; stream < num_streams; ++stream)
+        {
+            if (cycles[stream] == 0.0)
+            {
+                continue;
+            }
+            const double phase = fdma_block_phases_[first_stream + stream];
+            for (size_t lane = 0; lane < kFdmaLanes; ++lane)
+            {
+                const std::complex<double> rotator = std::polar(
+                    1.0, phase + kTwoPi * ncoFractionalCycles(
+                        cycles[stream],
+                        static_cast<double>(range_start + start + lane)));
+                rotator_real[stream][lane] = rotator.real();
+                rotator_imag[stream][lane] = rotator.imag();
+            }
+        }
+
+        for (size_t base = start; base < end; base += kFdmaLanes)
+        {
+            const size_t num_lanes = std::min(kFdmaLanes, end - base);
+            double partial_real[kFdmaLanes];
+            double partial_imag[kFdmaLanes];
+            std::copy(sum_real + base, sum_real + base + num_lanes,
+                      partial_real);
+            std::copy(sum_imag + base, sum_imag + base + num_lanes,
+                      partial_imag);
+            for (size_t stream = 0; stream < num_streams; ++stream)
+            {
+                if (cycles[stream] == 0.0)
+                {
+                    for (size_t lane = 0; lane < num_lanes; ++lane)
+                    {
+                        partial_real[lane] += real[stream][base + lane];
+                        partial_imag[lane] += imag[stream][base + lane];
+                    }
+                }
+                else if (num_lanes == kFdmaLanes)
+                {
+                    rotateAdd(real[stream] + base, imag[stream] + base,
+                              kFdmaLanes, step_real[stream],
+                              step_imag[stream], rotator_real[stream],
+                              rotator_imag[stream], partial_real,
+                              partial_imag);
+                }
+                else
+                {
+                    rotateAdd(real[stream] + base, imag[stream] + base,
+                              num_lanes, step_real[stream],
+                              step_imag[stream], rotator_real[stream],
+                              rotator_imag[stream], partial_real,
+                              partial_imag);
+                }
+            }
+            std::copy(partial_real, partial_real + num_lanes,
+                      sum_real + base);
+            std::copy(partial_imag, partial_imag + num_lanes,
+                      sum_imag + base);
+        }
+    }
+}
+
+void CompositeEngine::render(unsigned long long first_sample,
+                             size_t num_samples, double *real, double *imag)
+{
+    renderSamples(first_sample, num_samples, real, imag);
+}
+
+void CompositeEngine::render(unsigned long long first_sample,
+                             size_t num_samples, float *real, float *imag)
+{
+    renderSamples(first_sample, num_samples, real, imag);
+}
+
+template <typename T>
+void CompositeEngine::renderSamples(unsigned long long first_sample,
+                                    size_t num_samples, T *real, T *imag)
+{
+    if (buffer_stride_ == 0 ||
+        buffer_real_.size() != streams_.size() * buffer_stride_)
+    {
+        allocateBuffers();
+    }
+
+    for (size_t start = 0; start < num_samples; start += block_size_)
+    {
+        const size_t block_size = std::min(block_size_, num_samples - start);
+        const unsigned long long block_first = first_sample + start;
+        for (size_t idx = 0; idx < block_size; ++idx)
+        {
+            times_[idx] = static_cast<double>(block_first + idx) /
+                          sampling_rate_;
+        }
+
+        // Render every stream into its own buffer. Each stream's statistics
+        // are only updated by the task that renders it.
+        pool_.parallelFor(streams_.size(), [&](size_t stream_idx) {
+            const Clock::time_point stream_start =
+                profiling_ ? Clock::now() : Clock::time_point();
+            streams_[stream_idx]->render(
+                times_.data(), block_size,
+                buffer_real_.data() + stream_idx * buffer_stride_,
+                buffer_imag_.data() + stream_idx * buffer_stride_);
+            if (profiling_)
+            {
+                addElapsed(stream_start, block_size,
+                           stream_statistics_[stream_idx]);
+            }
+        });
+
+        // Sum the buffers in stream order, in double precision, applying
+        // each stream's FDMA offset as it is added, and store each range once
+        // in the output precision.
+        const Clock::time_point sum_start =
+            profiling_ ? Clock::now() : Clock::time_point();
+        for (size_t stream_idx = 0; stream_idx < streams_.size();
+             ++stream_idx)
+        {
+            fdma_block_phases_[stream_idx] = fdmaPhase(stream_idx,
+                                                       block_first);
+        }
+        T *out_real = real + start;
+        T *out_imag = imag + start;
+        const size_t num_ranges =
+            (block_size + kReductionSize - 1) / kReductionSize;
+        pool_.parallelFor(num_ranges, [&](size_t range_idx) {
+            const size_t range_start = range_idx * kReductionSize;
+            const size_t range_size = std::min(kReductionSize,
+                                               block_size - range_start);
+            double sum_real[kReductionSize];
+            double sum_imag[kReductionSize];
+            std::fill(sum_real, sum_real + range_size, 0.0);
+            std::fill(sum_imag, sum_imag + range_size, 0.0);
+            for (size_t stream_idx = 0; stream_idx < streams_.size();
+                 stream_idx += kReductionStreams)
+            {
+                accumulate(stream_idx,
+                           std::min(kReductionStreams,
+                                    streams_.size() - stream_idx),
+                           range_start, range_size, sum_real, sum_imag);
+            }
+            std::copy(sum_real, sum_real + range_size,
+                      out_real + range_start);
+            std::copy(sum_imag, sum_imag + range_size,
+                      out_imag + range_start);
+        });
+        if (profiling_)
+        {
+            addElapsed(sum_start, block_size, sum_statistics_);
+        }
+    }
+}
+
+} // namespace oosiggen
@@ -0,0 +1,396 @@
+/**************************************************************************//**
+ * @brief      Native composite signal engine, which renders the sum of many
+ *             chip-sequence signal streams onto a common sample grid.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_COMPOSITE_ENGINE_H_
+#define OOSIGGEN_COMPOSITE_ENGINE_H_
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "chip_source.h"
+#include "compiled_spline.h"
+#include "nco.h"
+#include "streaming_resampler.h"
+#include "thread_pool.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief Everything needed to generate one signal stream natively; the
+ *        counterpart of a SignalGenerator wrapping a ReferenceSignalGenerator
+ *        with a RepeatingSampleGenerator and (optionally) a
+ *        FixedSetSymbolGenerator.
+ */
+struct StreamDescriptor
+{
+    StreamDescriptor()
+        : start_index(0), chip_rate(0.0), segment_length(0),
+          signal_time(0.0), carrier_phase(0.0), fdma_offset(0.0),
+          fdma_phase(0.0), amplitude_interval(0.0)
+    {
+    }
+
+    std::vector<double> chips; ///< The repeating chip (or subchip) sequence.
+    size_t start_index; ///< Zero-indexed position of the first chip.
+    double chip_rate; ///< The chip rate (in chips/sec).
+    /// The number of chips modulated by each data symbol.
+    size_t segment_length;
+    /// The data symbols; once exhausted, a symbol of one is used.
+    std::vector<std::complex<double> > symbols;
+    /// Power profile vs true time (as linear power vs sec); may be null.
+    std::shared_ptr<CompiledSpline> power_spline;
+    /// Doppler profile vs true time (in Hz vs sec); may be null.
+    std::shared_ptr<CompiledSpline> doppler_spline;
+    /// True time vs signal time (in sec vs sec); may be null.
+    std::shared_ptr<CompiledSpline> signal_time_spline;
+    double signal_time; ///< The signal time of the first chip (in sec).
+    double carrier_phase; ///< The initial carrier phase (in rad).
+    double fdma_offset; ///< The FDMA frequency offset (in Hz).
+    double fdma_phase; ///< The initial FDMA carrier phase (in rad).
+    /// The true-time spacing of the grid on which the amplitude is evaluated
+    /// and then linearly interpolated (in sec), or zero to evaluate the power
+    /// profile at every sample.
+    double amplitude_interval;
+};
+
+/**
+ * @brief Generates one signal stream and resamples it onto the output grid.
+ *
+ * By default, chips are generated in blocks at the stream's own rate, with
+ * the time dilation, power and Doppler profiles evaluated per chip exactly as
+ * in SignalGenerator.getSamples(), and are then resampled by nearest-lower-
+ * neighbor interpolation.
+ *
+ * With direct synthesis, each output sample's signal time is instead found
+ * by inverting the signal time profile (see CompiledSpline::invert()), and
+ * its code phase indexes a table of the modulated chips that the block
+ * spans, so the stream is produced in a single pass at the output rate with
+ * no chip-rate time axis, resampler or search. The power and Doppler
+ * profiles are then evaluated at the output sample times rather than held
+ * from the start of each chip, so the result differs from the default mode
+ * by that sub-chip detail only.
+ *
+ * In both modes the Doppler phase is evaluated from the antiderivative of
+ * the Doppler profile (see CompiledSpline::integral()), computed when the
+ * stream is created, so it is exact at every sample however long the run,
+ * and the rotation is generated by the NCO kernels of nco.h. The FDMA offset
+ * is applied afterwards by the CompositeEngine, from its stream table.
+ *
+ * A stream only touches its own state, so different streams may be rendered
+ * concurrently.
+ */
+class SignalStream
+{
+public:
+    /**
+     * @param descriptor The stream description; its FDMA fields are not
+     *        used.
+     * @param time_offset An offset added to every true time (in sec); used
+     *        to compensate for the downsampling filter delay.
+     * @param direct_synthesis If true, synthesize the stream directly at the
+     *        output rate rather than resampling chip-rate blocks.
+     */
+    SignalStream(const StreamDescriptor &descriptor, double time_offset,
+                 bool direct_synthesis);
+
+    /**
+     * @brief Render the stream, before any FDMA offset, for a range of
+     *        output samples.
+     *
+     * @param times The output sample times (in sec).
+     * @param num_samples The number of elements of @c times.
+     * @param real The real parts of the output samples.
+     * @param imag The imaginary parts of the output samples.
+     */
+    void render(const double *times, size_t num_samples, double *real,
+                double *imag);
+
+private:
+    /// The number of chips generated at a time.
+    static const size_t kBlockSize = 4096;
+    /// With direct synthesis, the output samples per spline inversion.
+    static const size_t kInversionInterval = 64;
+
+    /**
+     * @brief Generate the next block of chips into the resampler; finishes
+     *        the resampler once the signal time profile has been exceeded.
+     */
+    void generateBlock();
+
+    /**
+     * @brief Synthesize the stream at a set of output sample times.
+     */
+    void synthesize(const double *times, size_t num_samples, double *real,
+                    double *imag);
+
+    /**
+     * @brief Move the code and data symbol positions to a chip count.
+     */
+    void seekChip(unsigned long long chip);
+
+    /**
+     * @brief Compute the signal amplitude, the square root of the power
+     *        profile, at a set of ascending true times.
+     *
+     * Given an amplitude interval, the amplitude is evaluated only at
+     * multiples of the interval and linearly interpolated between them,
+     * except in the grid cells that contain a break of the power profile,
+     * which are evaluated exactly. The grid is fixed in true time, so the
+     * result does not depend on how the stream is divided into blocks.
+     */
+    void evaluateAmplitude(const double *times, size_t num_samples,
+                           double *amplitude);
+
+    StreamDescriptor descriptor_; ///< The stream description, less chips.
+    ChipSource chips_; ///< The packed chip sequence.
+    double time_offset_; ///< Offset added to every true time (in sec).
+    bool direct_synthesis_; ///< True to synthesize at the output rate.
+    StreamingResampler resampler_; ///< The generated chips.
+    /// Number of chips generated; with direct synthesis, the current chip.
+    unsigned long long chip_counter_;
+    size_t chip_index_; ///< Position within the chip sequence.
+    size_t segment_index_; ///< Chip position within the current symbol.
+    size_t symbol_index_; ///< Index of the current data symbol.
+    /// The Doppler carrier phase vs true time (in cycles vs sec), modulo one
+    /// cycle; empty if the Doppler profile is not used.
+    std::unique_ptr<CompiledSpline> doppler_phase_;
+    /// The carrier phase at a true time is this plus 2*pi times the value of
+    /// doppler_phase_ (in rad).
+    double phase_offset_;
+    /// With direct synthesis, the true time of the first chip (in sec).
+    double start_time_;
+    /// With direct synthesis, the signal time of the last chip (in sec).
+    double end_signal_time_;
+    /// With direct synthesis, the true time of the last sample (in sec).
+    double inverted_true_time_;
+    /// With direct synthesis, the signal time of the last sample (in sec).
+    double inverted_signal_time_;
+    /// The index of the amplitude grid point at or before the last sample,
+    /// or NaN before the first; with the amplitude at it and the next point.
+    double amplitude_point_;
+    double amplitude_left_;
+    double amplitude_right_;
+    /// True if that grid cell contains a break of the power profile.
+    bool amplitude_exact_;
+
+    // Per-block scratch.
+    AlignedBuffer<double> chip_values_;
+    AlignedBuffer<double> signal_times_;
+    AlignedBuffer<double> true_times_;
+    AlignedBuffer<double> amplitude_;
+    /// The samples; with direct synthesis, the modulated chips.
+    AlignedBuffer<double> real_;
+    AlignedBuffer<double> imag_;
+    /// With direct synthesis, each sample's chip, from the block's first.
+    AlignedBuffer<uint32_t> chip_offsets_;
+};
+
+/**
+ * @brief The cumulative cost of one part of CompositeEngine::render().
+ */
+struct RenderStatistics
+{
+    RenderStatistics() : blocks(0), seconds(0.0), samples(0) {}
+
+    unsigned long long blocks; ///< The number of blocks rendered.
+    double seconds; ///< Cumulative time (in sec).
+    unsigned long long samples; ///< Cumulative output samples.
+};
+
+/**
+ * @brief Sums a set of signal streams onto a uniform output grid.
+ *
+ * This is the native counterpart of the per-signal loop in
+ * CompositeSignalGenerator.getSamples(): output sample @c n is at time
+ * <c>n / sampling_rate</c>, and each stream's FDMA offset is applied as a
+ * carrier rotation that is continuous from one render call to the next.
+ *
+ * The output is produced a block at a time. The streams of a block are
+ * rendered in parallel, each into its own buffer, and the buffers are then
+ * summed in stream order, in parallel over sample ranges. Every output sample
+ * is therefore the same sum in the same order however the work is scheduled,
+ * and the output is bit-for-bit independent of the number of threads.
+ *
+ * The per-stream state that every block touches is kept in a table of
+ * arrays indexed by stream, rather than in each stream's object: the FDMA
+ * offsets and phases, and the block buffers, which are planes of one
+ * allocation a fixed stride apart. The summation reads the buffers of
+ * several streams at once from computed addresses, applies each one's FDMA
+ * rotation as it goes, and holds each partial sum in a register across them.
+ * The rotation is thus applied to a run of samples of four streams per pass,
+ * with the samples of each stream in the vector lanes, and never stored.
+ *
+ * The code phase, the symbols and the Doppler carrier are generated per
+ * stream, by the stream's own object: each stream has its own spline pieces,
+ * chip sequence and symbol positions, so lanes across streams would need a
+ * gather per coefficient, while the per-sample kernels already fill the
+ * vector lanes along the sample axis.
+ *
+ * Streams are rendered, and their sum accumulated, in double precision, with
+ * times and phases in double precision throughout; the sum may be stored in
+ * single precision, which halves the memory traffic of the output and of
+ * every later stage that reads it.
+ */
+class CompositeEngine
+{
+public:
+    /**
+     * @param sampling_rate The output sampling rate (in samples/sec).
+     * @param time_offset An offset added to every stream's true time (in
+     *        sec).
+     * @param num_threads The number of threads to render with.
+     * @param direct_synthesis If true, synthesize every stream directly at
+     *        the output rate (see SignalStream).
+     */
+    CompositeEngine(double sampling_rate, double time_offset,
+                    size_t num_threads, bool direct_synthesis);
+
+    /**
+     * @brief Add a stream; its FDMA phase is referenced to output sample
+     *        @c first_sample.
+     */
+    void addStream(const StreamDescriptor &descriptor,
+                   unsigned long long first_sample);
+
+    size_t numStreams() const { return streams_.size(); }
+    size_t numThreads() const { return pool_.numThreads(); }
+    bool directSynthesis() const { return direct_synthesis_; }
+    size_t blockSize() const { return block_size_; }
+
+    /**
+     * @brief Set the number of output samples rendered per stream at a time.
+     *
+     * Each stream renders a block into its own buffer, and the buffers are
+     * then summed, so a block size small enough for the buffers of all
+     * streams to stay in cache avoids a round trip through memory. The
+     * output depends on the block size only through rounding.
+     *
+     * @throws std::invalid_argument if @c block_size is zero.
+     */
+    void setBlockSize(size_t block_size);
+
+    /**
+     * @brief Enable or disable timing of each stream and of the summation.
+     *
+     * Timing reads the clock twice per stream per block. Disabling it keeps
+     * the statistics gathered so far.
+     */
+    void setProfiling(bool profiling) { profiling_ = profiling; }
+    bool profiling() const { return profiling_; }
+
+    /**
+     * @brief The time spent rendering each stream while profiling, in the
+     *        order the streams were added.
+     */
+    const std::vector<RenderStatistics> &streamStatistics() const
+    {
+        return stream_statistics_;
+    }
+
+    /**
+     * @brief The time spent summing the stream buffers while profiling.
+     */
+    const RenderStatistics &sumStatistics() const { return sum_statistics_; }
+
+    /**
+     * @brief Render the sum of all streams.
+     *
+     * @param first_sample The index of the first output sample.
+     * @param num_samples The number of output samples.
+     * @param real The real parts of the summed output, overwritten.
+     * @param imag The imaginary parts of the summed output, overwritten.
+     */
+    void render(unsigned long long first_sample, size_t num_samples,
+                double *real, double *imag);
+
+    /**
+     * @brief Render the sum of all streams in single precision.
+     *
+     * @copydetails render(unsigned long long, size_t, double*, double*)
+     */
+    void render(unsigned long long first_sample, size_t num_samples,
+                float *real, float *imag);
+
+private:
+    /// The default number of output samples rendered per stream at a time.
+    static const size_t kDefaultBlockSize = 16384;
+    /// The number of output samples per reduction task; a multiple of
+    /// kNcoResyncInterval, so each task resynchronizes the FDMA rotators.
+    static const size_t kReductionSize = 2048;
+    /// The number of stream buffers added per pass of the reduction.
+    static const size_t kReductionStreams = 4;
+
+    CompositeEngine(const CompositeEngine&);
+    CompositeEngine &operator=(const CompositeEngine&);
+
+    /**
+     * @brief Size the stream buffers for the current streams and block size.
+     */
+    void allocateBuffers();
+
+    /**
+     * @brief The FDMA carrier phase of a stream at an output sample (in rad).
+     */
+    double fdmaPhase(size_t stream_idx, unsigned long long sample) const;
+
+    /**
+     * @brief Add streams' buffers, each rotated by its FDMA offset, in
+     *        stream order, to a range of partial sums.
+     */
+    void accumulate(size_t first_stream, size_t num_streams,
+                    size_t range_start, size_t range_size, double *sum_real,
+                    double *sum_imag) const;
+
+    template <typename T>
+    void renderSamples(unsigned long long first_sample, size_t num_samples,
+                       T *real, T *imag);
+
+    double sampling_rate_; ///< Output sampling rate (in samples/sec).
+    double time_offset_; ///< Offset added to every true time (in sec).
+    bool direct_synthesis_; ///< True to synthesize at the output rate.
+    size_t block_size_; ///< Output samples rendered per stream at a time.
+    bool profiling_; ///< True to time the streams and the summation.
+    std::vector<std::unique_ptr<SignalStream> > streams_; ///< The streams.
+
+    // The stream table, indexed by stream.
+    /// The FDMA offset (in cycles/sample).
+    std::vector<double> fdma_cycles_;
+    /// The FDMA carrier phase at the reference sample (in rad).
+    std::vector<double> fdma_phases_;
+    /// The output sample the FDMA carrier phase is referenced to.
+    std::vector<unsigned long long> fdma_references_;
+    /// The FDMA carrier phase at the current block's first sample (in rad).
+    std::vector<double> fdma_block_phases_;
+    /// The distance between successive streams' buffers (in samples); the
+    /// block size rounded up to whole cache lines.
+    size_t buffer_stride_;
+    AlignedBuffer<double> buffer_real_; ///< Each stream's block output.
+    AlignedBuffer<double> buffer_imag_;
+    /// The time spent on each stream, while profiling.
+    std::vector<RenderStatistics> stream_statistics_;
+    RenderStatistics sum_statistics_; ///< The time spent summing.
+    AlignedBuffer<double> times_; ///< Output sample times for the block.
+    ThreadPool pool_; ///< Renders the streams.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_COMPOSITE_ENGINE_H_
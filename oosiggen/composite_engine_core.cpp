@@ -0,0 +1,593 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to the native composite signal engine.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility> // For move().
+#include <vector>
+
+#include "mex.h"
+
+#include "compiled_spline.h"
+#include "composite_engine.h"
+#include "mex_handle_registry.h"
+
+namespace
+{
+
+/**
+ * @brief The engines owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::CompositeEngine> &engines()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::CompositeEngine>
+        registry("compositeEngineCore");
+    return registry;
+}
+
+/**
+ * @brief The fencepost storage shared between the streams' splines.
+ */
+oosiggen::BreaksPool &breaksPool()
+{
+    static oosiggen::BreaksPool pool;
+    return pool;
+}
+
+/**
+ * @brief Free all engines when the MEX file is cleared.
+ */
+void freeAllEngines()
+{
+    engines().clear();
+}
+
+/**
+ * @brief Raise a MATLAB error naming a descriptor field.
+ */
+void fieldError(const char *field, const char *message)
+{
+    const std::string text = std::string("descriptor.") + field + " " +
+                             message;
+    mexErrMsgTxt(text.c_str());
+}
+
+/**
+ * @brief Get a required field of the stream descriptor.
+ */
+const mxArray *getField(const mxArray *descriptor, const char *field)
+{
+    const mxArray *value = mxGetField(descriptor, 0, field);
+    if (value == NULL)
+    {
+        fieldError(field, "is missing.");
+    }
+    return value;
+}
+
+/**
+ * @brief Get a real scalar field of the stream descriptor.
+ */
+double getScalarField(const mxArray *descriptor, const char *field)
+{
+    const mxArray *value = getField(descriptor, field);
+    if (!mxIsDouble(value) || mxIsComplex(value) ||
+        mxGetNumberOfElements(value) != 1)
+    {
+        fieldError(field, "must be a real scalar double.");
+    }
+    return mxGetScalar(value);
+}
+
+/**
+ * @brief Compile a spline struct field of the stream descriptor; an empty
+ *        field means the profile is not used.
+ */
+std::shared_ptr<oosiggen::CompiledSpline> getSplineField(
+    const mxArray *descriptor, const char *field)
+{
+    const mxArray *pp = getField(descriptor, field);
+    if (mxIsEmpty(pp))
+    {
+        return std::shared_ptr<oosiggen::CompiledSpline>();
+    }
+    if (!mxIsStruct(pp) || mxGetNumberOfElements(pp) != 1)
+    {
+        fieldError(field, "must be a spline struct or empty.");
+    }
+
+    const mxArray *breaks = mxGetField(pp, 0, "breaks");
+    const mxArray *coefs = mxGetField(pp, 0, "coefs");
+    if (breaks == NULL || coefs == NULL)
+    {
+        fieldError(field, "must have breaks and coefs fields.");
+    }
+    const size_t num_breaks = mxGetN(breaks);
+    if (!mxIsDouble(breaks) || mxIsComplex(breaks) ||
+        mxGetNumberOfElements(breaks) != num_breaks || num_breaks < 2)
+    {
+        fieldError(field, "breaks must be a real row array of doubles with "
+                   "at least two fenceposts.");
+    }
+    const size_t num_polynomials = mxGetM(coefs);
+    const size_t order = mxGetN(coefs);
+    if (!mxIsDouble(coefs) || mxIsComplex(coefs) ||
+        num_polynomials != num_breaks - 1)
+    {
+        fieldError(field, "coefs must be a real matrix of doubles with one "
+                   "row per polynomial.");
+    }
+
+    const double *break_values = static_cast<double*>(mxGetPr(breaks));
+    for (size_t break_idx = 1; break_idx < num_breaks; ++break_idx)
+    {
+        if (!(break_values[break_idx] >= break_values[break_idx - 1]))
+        {
+            fieldError(field, "breaks must be sorted in ascending order.");
+        }
+    }
+    return std::make_shared<oosiggen::CompiledSpline>(
+        breaksPool().intern(break_values, num_breaks),
+        static_cast<double*>(mxGetPr(coefs)), order);
+}
+
+/**
+ * @brief Build a native stream descriptor from its MATLAB struct (see
+ *        SignalGenerator.getStreamDescriptor()).
+ */
+oosiggen::StreamDescriptor parseDescriptor(const mxArray *descriptor)
+{
+    if (descriptor == NULL || !mxIsStruct(descriptor) ||
+        mxGetNumberOfElements(descriptor) != 1)
+    {
+        mexErrMsgTxt("descriptor must be a scalar struct.");
+    }
+    oosiggen::StreamDescriptor result;
+
+    const mxArray *chips = getField(descriptor, "chips");
+    if (!mxIsDouble(chips) || mxIsComplex(chips) || mxIsEmpty(chips))
+    {
+        fieldError("chips", "must be a non-empty real array of doubles.");
+    }
+    const double *chip_values = static_cast<double*>(mxGetPr(chips));
+    result.chips.assign(chip_values,
+                        chip_values + mxGetNumberOfElements(chips));
+
+    const mxArray *symbols = getField(descriptor, "symbols");
+    if (!mxIsDouble(symbols))
+    {
+        fieldError("symbols", "must be an array of doubles.");
+    }
+    const size_t num_symbols = mxGetNumberOfElements(symbols);
+    const double *symbols_r = static_cast<double*>(mxGetPr(symbols));
+    const double *symbols_i = mxIsComplex(symbols) ?
+        static_cast<double*>(mxGetPi(symbols)) : NULL;
+    result.symbols.resize(num_symbols);
+    for (size_t idx = 0; idx < num_symbols; ++idx)
+    {
+        result.symbols[idx] = std::complex<double>(
+            symbols_r[idx], symbols_i == NULL ? 0.0 : symbols_i[idx]);
+    }
+
+    const double start_index = getScalarField(descriptor, "start_index");
+    const double segment_length = getScalarField(descriptor,
+                                                 "segment_length");
+    if (!(start_index >= 0.0))
+    {
+        fieldError("start_index", "must be non-negative.");
+    }
+    if (!(segment_length >= 1.0))
+    {
+        fieldError("segment_length", "must be positive.");
+    }
+    result.start_index = static_cast<size_t>(start_index);
+    result.segment_length = static_cast<size_t>(segment_length);
+    result.chip_rate = getScalarField(descriptor, "chip_rate");
+    result.signal_time = getScalarField(descriptor, "signal_time");
+    result.carrier_phase = getScalarField(descriptor, "carrier_phase");
+    result.amplitude_interval = getScalarField(descriptor,
+                                               "amplitude_interval");
+    if (!(result.amplitude_interval >= 0.0))
+    {
+        fieldError("amplitude_interval", "must be non-negative.");
+    }
+
+    result.power_spline = getSplineField(descriptor, "power_spline");
+    result.doppler_spline = getSplineField(descriptor, "doppler_spline");
+    result.signal_time_spline = getSplineField(descriptor,
+                                               "signal_time_spline");
+    return result;
+}
+
+/**
+ * @brief Create an engine with no streams.
+ */
+void createEngine(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 4 && nrhs != 5)
+    {
+        mexErrMsgTxt("create requires sampling_rate, time_offset and "
+                     "num_threads, and optionally direct_synthesis.");
+    }
+    for (int arg_idx = 1; arg_idx < 4; ++arg_idx)
+    {
+        if (!mxIsDouble(prhs[arg_idx]) || mxIsComplex(prhs[arg_idx]) ||
+            mxGetNumberOfElements(prhs[arg_idx]) != 1)
+        {
+            mexErrMsgTxt("sampling_rate, time_offset and num_threads must be "
+                         "real scalar doubles.");
+        }
+    }
+    const double num_threads = mxGetScalar(prhs[3]);
+    if (!(num_threads >= 1.0))
+    {
+        mexErrMsgTxt("num_threads must be at least one.");
+    }
+    bool direct_synthesis = false;
+    if (nrhs == 5)
+    {
+        if (!mxIsDouble(prhs[4]) || mxIsComplex(prhs[4]) ||
+            mxGetNumberOfElements(prhs[4]) != 1)
+        {
+            mexErrMsgTxt("direct_synthesis must be a real scalar double.");
+        }
+        direct_synthesis = mxGetScalar(prhs[4]) != 0.0;
+    }
+
+    std::unique_ptr<oosiggen::CompositeEngine> engine;
+    try
+    {
+        engine.reset(new oosiggen::CompositeEngine(
+            mxGetScalar(prhs[1]), mxGetScalar(prhs[2]),
+            static_cast<size_t>(num_threads), direct_synthesis));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = engines().add(std::move(engine));
+}
+
+/**
+ * @brief Add a stream to an engine.
+ */
+void addStream(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 6)
+    {
+        mexErrMsgTxt("add_stream requires a handle, descriptor, fdma_offset, "
+                     "fdma_phase and first_sample.");
+    }
+    oosiggen::CompositeEngine &engine = engines().get(prhs[1]);
+    for (int arg_idx = 3; arg_idx < 6; ++arg_idx)
+    {
+        if (!mxIsDouble(prhs[arg_idx]) || mxIsComplex(prhs[arg_idx]) ||
+            mxGetNumberOfElements(prhs[arg_idx]) != 1)
+        {
+            mexErrMsgTxt("fdma_offset, fdma_phase and first_sample must be "
+                         "real scalar doubles.");
+        }
+    }
+
+    // Parsing compiles the descriptor's splines, which may throw.
+    try
+    {
+        oosiggen::StreamDescriptor descriptor = parseDescriptor(prhs[2]);
+        descriptor.fdma_offset = mxGetScalar(prhs[3]);
+        descriptor.fdma_phase = mxGetScalar(prhs[4]);
+        engine.addStream(descriptor, static_cast<unsigned long long>(
+                                         mxGetScalar(prhs[5])));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+}
+
+/**
+ * @brief Render the summed streams for a range of output samples.
+ */
+void renderSamples(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 4 && nrhs != 5)
+    {
+        mexErrMsgTxt("render requires a handle, first_sample and "
+                     "num_samples, and optionally single_precision.");
+    }
+    oosiggen::CompositeEngine &engine = engines().get(prhs[1]);
+    for (int arg_idx = 2; arg_idx < 4; ++arg_idx)
+    {
+        if (!mxIsNumeric(prhs[arg_idx]) || mxIsComplex(prhs[arg_idx]) ||
+            mxGetNumberOfElements(prhs[arg_idx]) != 1 ||
+            !(mxGetScalar(prhs[arg_idx]) >= 0.0))
+        {
+            mexErrMsgTxt("first_sample and num_samples must be non-negative "
+                         "real scalars.");
+        }
+    }
+    const unsigned long long first_sample =
+        static_cast<unsigned long long>(mxGetScalar(prhs[2]));
+    const size_t num_samples = static_cast<size_t>(mxGetScalar(prhs[3]));
+    bool single_precision = false;
+    if (nrhs == 5)
+    {
+        if (!mxIsDouble(prhs[4]) || mxIsComplex(prhs[4]) ||
+            mxGetNumberOfElements(prhs[4]) != 1)
+        {
+            mexErrMsgTxt("single_precision must be a real scalar double.");
+        }
+        single_precision = mxGetScalar(prhs[4]) != 0.0;
+    }
+
+    plhs[0] = mxCreateNumericMatrix(
+        static_cast<mwSize>(num_samples), 1,
+        single_precision ? mxSINGLE_CLASS : mxDOUBLE_CLASS, mxCOMPLEX);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+    try
+    {
+        if (single_precision)
+        {
+            engine.render(first_sample, num_samples,
+                          static_cast<float*>(mxGetData(plhs[0])),
+                          static_cast<float*>(mxGetImagData(plhs[0])));
+        }
+        else
+        {
+            engine.render(first_sample, num_samples,
+                          static_cast<double*>(mxGetPr(plhs[0])),
+                          static_cast<double*>(mxGetPi(plhs[0])));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+}
+
+/**
+ * @brief Set the number of output samples an engine renders per stream at a
+ *        time.
+ */
+void setBlockSize(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("set_block_size requires a handle and block_size.");
+    }
+    oosiggen::CompositeEngine &engine = engines().get(prhs[1]);
+    if (!mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        mxGetNumberOfElements(prhs[2]) != 1 || !(mxGetScalar(prhs[2]) >= 1.0))
+    {
+        mexErrMsgTxt("block_size must be a real scalar double of at least "
+                     "one.");
+    }
+    try
+    {
+        engine.setBlockSize(static_cast<size_t>(mxGetScalar(prhs[2])));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+}
+
+/**
+ * @brief Enable or disable an engine's per-stream timing.
+ */
+void setProfiling(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("set_profiling requires a handle and profiling.");
+    }
+    oosiggen::CompositeEngine &engine = engines().get(prhs[1]);
+    if (!mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        mxGetNumberOfElements(prhs[2]) != 1)
+    {
+        mexErrMsgTxt("profiling must be a real scalar double.");
+    }
+    engine.setProfiling(mxGetScalar(prhs[2]) != 0.0);
+}
+
+/**
+ * @brief Get an engine's timing statistics.
+ */
+void getStatistics(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("statistics requires a handle.");
+    }
+    const oosiggen::CompositeEngine &engine = engines().get(prhs[1]);
+    const std::vector<oosiggen::RenderStatistics> &streams =
+        engine.streamStatistics();
+
+    const mwSize num_streams = static_cast<mwSize>(streams.size());
+    mxArray *stream_blocks = mxCreateDoubleMatrix(num_streams, 1, mxREAL);
+    mxArray *stream_seconds = mxCreateDoubleMatrix(num_streams, 1, mxREAL);
+    mxArray *stream_samples = mxCreateDoubleMatrix(num_streams, 1, mxREAL);
+    const char *field_names[] = {"stream_blocks", "stream_seconds",
+                                 "stream_samples", "sum_blocks",
+                                 "sum_seconds", "sum_samples"};
+    plhs[0] = mxCreateStructMatrix(1, 1, 6, field_names);
+    if (stream_blocks == NULL || stream_seconds == NULL ||
+        stream_samples == NULL || plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output struct.");
+    }
+    double *blocks = static_cast<double*>(mxGetPr(stream_blocks));
+    double *seconds = static_cast<double*>(mxGetPr(stream_seconds));
+    double *samples = static_cast<double*>(mxGetPr(stream_samples));
+    for (size_t stream_idx = 0; stream_idx < streams.size(); ++stream_idx)
+    {
+        blocks[stream_idx] = static_cast<double>(streams[stream_idx].blocks);
+        seconds[stream_idx] = streams[stream_idx].seconds;
+        samples[stream_idx] =
+            static_cast<double>(streams[stream_idx].samples);
+    }
+    const oosiggen::RenderStatistics &sum = engine.sumStatistics();
+    mxSetField(plhs[0], 0, "stream_blocks", stream_blocks);
+    mxSetField(plhs[0], 0, "stream_seconds", stream_seconds);
+    mxSetField(plhs[0], 0, "stream_samples", stream_samples);
+    mxSetField(plhs[0], 0, "sum_blocks",
+               mxCreateDoubleScalar(static_cast<double>(sum.blocks)));
+    mxSetField(plhs[0], 0, "sum_seconds", mxCreateDoubleScalar(sum.seconds));
+    mxSetField(plhs[0], 0, "sum_samples",
+               mxCreateDoubleScalar(static_cast<double>(sum.samples)));
+}
+
+/**
+ * @brief Free one or more engines.
+ */
+void freeEngines(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    engines().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = compositeEngineCore('create', sampling_rate, time_offset, num_threads)
+ * h = compositeEngineCore('create', sampling_rate, time_offset, num_threads,
+ *                         direct_synthesis)
+ * compositeEngineCore('add_stream', h, descriptor, fdma_offset, fdma_phase,
+ *                     first_sample)
+ * samples = compositeEngineCore('render', h, first_sample, num_samples)
+ * samples = compositeEngineCore('render', h, first_sample, num_samples,
+ *                               single_precision)
+ * compositeEngineCore('set_block_size', h, block_size)
+ * compositeEngineCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>prhs[1]</c>: The output sampling rate (in samples/sec).
+ * - <c>prhs[2]</c>: An offset added to every stream's true time (in sec).
+ * - <c>prhs[3]</c>: The number of threads to render with. The output does
+ *   not depend on this value.
+ * - <c>prhs[4]</c>: (Optional) True to synthesize every stream directly at
+ *   the output rate from its inverted signal time profile, rather than
+ *   resampling chip-rate blocks. Defaults to false.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the new engine.
+ *
+ * For @c 'add_stream':
+ * - <c>prhs[1]</c>: The engine handle.
+ * - <c>prhs[2]</c>: The stream descriptor struct, from
+ *   SignalGenerator.getStreamDescriptor().
+ * - <c>prhs[3]</c>: The FDMA offset (in Hz).
+ * - <c>prhs[4]</c>: The initial FDMA carrier phase (in rad).
+ * - <c>prhs[5]</c>: The output sample index at which the FDMA carrier phase
+ *   is <c>prhs[4]</c>.
+ *
+ * For @c 'render':
+ * - <c>prhs[1]</c>: The engine handle.
+ * - <c>prhs[2]</c>: The zero-indexed first output sample; sample @c n is at
+ *   time <c>n / sampling_rate</c>. Successive calls must not go backwards.
+ * - <c>prhs[3]</c>: The number of output samples.
+ * - <c>prhs[4]</c>: (Optional) True to return the sum in single precision;
+ *   it is accumulated in double precision either way. Defaults to false.
+ * - <c>plhs[0]</c>: The complex column vector sum of all streams.
+ *
+ * For @c 'set_block_size':
+ * - <c>prhs[1]</c>: The engine handle.
+ * - <c>prhs[2]</c>: The number of output samples rendered per stream at a
+ *   time. The output depends on this value only through rounding.
+ *
+ * For @c 'set_profiling':
+ * - <c>prhs[1]</c>: The engine handle.
+ * - <c>prhs[2]</c>: True to time each stream and the summation.
+ *
+ * For @c 'statistics':
+ * - <c>prhs[1]</c>: The engine handle.
+ * - <c>plhs[0]</c>: A struct of the work done while profiling, with fields
+ *   @c stream_blocks, @c stream_seconds and @c stream_samples (column
+ *   vectors, one element per stream in the order added) and
+ *   @c sum_blocks, @c sum_seconds and @c sum_samples (scalars, for summing
+ *   the streams).
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllEngines);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createEngine(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "add_stream") == 0)
+    {
+        addStream(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "render") == 0)
+    {
+        renderSamples(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "set_block_size") == 0)
+    {
+        setBlockSize(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "set_profiling") == 0)
+    {
+        setProfiling(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "statistics") == 0)
+    {
+        getStatistics(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeEngines(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
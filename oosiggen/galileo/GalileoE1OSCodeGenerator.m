@@ -29,6 +29,22 @@ classdef GalileoE1OSCodeGenerator < RepeatingSampleGenerator
         %
         % @param[out] obj The created object.
         
+            samples = CodeTableRegistry.getSequence( ...
+                sprintf('e1os_code_table.mat/%c/%d', lower(component), prn), ...
+                @() GalileoE1OSCodeGenerator.buildSamples(prn, component));
+            CHIPPING_RATE = 2 * 1.023e6; % BOC conversion has the effect of doubling chipping rate
+            obj = obj@RepeatingSampleGenerator(samples, 1, CHIPPING_RATE, true);
+
+            obj.prn = prn;
+        end
+    end
+
+    methods (Static = true, Access = private)
+        function samples = buildSamples(prn, component)
+        %%
+        % @brief Build the BOC(1,1) sample sequence for a PRN and component.
+        %        Called once per PRN and component through CodeTableRegistry.
+
             % pre-generated struct array with elements prn, b_code, c_code.  b_code and c_code are
             % 4092-element arrays containing the 1/0-valued PRN sequences for the data and pilot
             % components, respectively, for E1C/B
@@ -38,7 +54,7 @@ classdef GalileoE1OSCodeGenerator < RepeatingSampleGenerator
                 error(['Cannot find E1OS PRN code table ' code_table_filename '\n'])
             end
 
-            code_table = load(code_table_filename);
+            code_table = CodeTableRegistry.getTable(code_table_filename);
             code_idx = find([code_table.e1_code_table.prn]==prn,1);
             if isempty(code_idx)
                 error([ ...
@@ -46,9 +62,9 @@ classdef GalileoE1OSCodeGenerator < RepeatingSampleGenerator
                     code_table_filename '\n']);
             end
             
-            if component == 'b'
+            if lower(component) == 'b'
                 chips = code_table.e1_code_table(code_idx).b_code;
-            elseif component == 'c'
+            elseif lower(component) == 'c'
                 chips = code_table.e1_code_table(code_idx).c_code;
                 secondary_code = code_table.e1_overlay_code;
                 % Apply the pilot overlay code 
@@ -60,10 +76,6 @@ classdef GalileoE1OSCodeGenerator < RepeatingSampleGenerator
 
             % Compute BOC(1,1) samples from chips, scale [0/1] to [-1/1].
             samples = (binToBOC(chips', 1, 1)') * 2 - 1;
-            CHIPPING_RATE = 2 * 1.023e6; % BOC conversion has the effect of doubling chipping rate
-            obj = obj@RepeatingSampleGenerator(samples, 1, CHIPPING_RATE, true);
-
-            obj.prn = prn;
         end
     end
 end
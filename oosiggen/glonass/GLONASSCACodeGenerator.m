@@ -27,8 +27,8 @@ classdef GLONASSCACodeGenerator < RepeatingSampleGenerator
                 error(['Cannot find L1OF code table ' code_table '\n'])
             end
             
-            load(code_table)
-            chips = l1of_code_table.code;
+            table = CodeTableRegistry.getTable(code_table);
+            chips = table.l1of_code_table.code;
                         
             CHIPPING_RATE = 511e3;
             obj = obj@RepeatingSampleGenerator(chips, 1, CHIPPING_RATE, true);
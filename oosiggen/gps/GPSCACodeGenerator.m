@@ -27,6 +27,23 @@ classdef GPSCACodeGenerator < RepeatingSampleGenerator
             %
             % @param[out] obj The created object.
             
+            chips = CodeTableRegistry.getSequence( ...
+                sprintf('ca_code_table.mat/%d', prn), ...
+                @() GPSCACodeGenerator.buildChips(prn));
+            
+            CHIPPING_RATE = 1.023e6;
+            obj = obj@RepeatingSampleGenerator(chips, 1, CHIPPING_RATE, true);
+            
+            obj.prn = prn;
+        end
+    end
+    
+    methods (Static = true, Access = private)
+        function chips = buildChips(prn)
+            %%
+            % @brief Build the chip sequence for a PRN. Called once per PRN
+            %        through CodeTableRegistry.
+            
             % pre-generated struct array with elements "prn" and "code".  The "code" arrays are 
             % 1023-element arrays containing the +/-1-valued PRN sequences for the GPS L1 C/A code            
             code_table = 'ca_code_table.mat';
@@ -35,18 +52,13 @@ classdef GPSCACodeGenerator < RepeatingSampleGenerator
                 error(['Cannot find CA PRN code table ' code_table '\n'])
             end
             
-            load(code_table)
-            code_idx = find([ca_code_table.prn]==prn,1);
+            table = CodeTableRegistry.getTable(code_table);
+            code_idx = find([table.ca_code_table.prn]==prn,1);
             if isempty(code_idx)
                 error(['Code sequence for PRN ' prn ' not present in table ' code_table '\n']);
             end
             
-            chips = (ca_code_table(code_idx).code) * 2 - 1;
-            
-            CHIPPING_RATE = 1.023e6;
-            obj = obj@RepeatingSampleGenerator(chips, 1, CHIPPING_RATE, true);
-            
-            obj.prn = prn;
+            chips = (table.ca_code_table(code_idx).code) * 2 - 1;
         end
     end
 end
@@ -29,6 +29,23 @@ classdef GPSL1CCodeGenerator < RepeatingSampleGenerator
         %
         % @param[out] obj The created object.
         
+            samples = CodeTableRegistry.getSequence( ...
+                sprintf('l1c_code_table.mat/%c/%d', lower(component), prn), ...
+                @() GPSL1CCodeGenerator.buildSamples(prn, component));
+            CHIPPING_RATE = 1.023e6;
+            SUB_CHIP_RATE = CHIPPING_RATE * 2;
+            obj = obj@RepeatingSampleGenerator(samples, 1, SUB_CHIP_RATE, true);
+
+            obj.prn = prn;
+        end
+    end
+
+    methods (Static = true, Access = private)
+        function samples = buildSamples(prn, component)
+        %%
+        % @brief Build the BOC(1,1) sample sequence for a PRN and component.
+        %        Called once per PRN and component through CodeTableRegistry.
+
             % pre-generated struct array with elements prn, d_code, p_code.  d_code and p_code are
             % 10230-element arrays containing the 1/0-valued PRN sequences for the data and pilot
             % components, respectively, for L1C
@@ -38,17 +55,17 @@ classdef GPSL1CCodeGenerator < RepeatingSampleGenerator
                 error(['Cannot find L1C PRN code table ' code_table '\n'])
             end
 
-            load(code_table)
-            code_idx = find([l1c_code_table.prn]==prn,1);
+            table = CodeTableRegistry.getTable(code_table);
+            code_idx = find([table.l1c_code_table.prn]==prn,1);
             if isempty(code_idx)
                 error(['Code sequence for PRN ' prn ' not present in table ' code_table '\n']);
             end
             
             if lower(component) == 'd'
-                chips = l1c_code_table(code_idx).d_code;
+                chips = table.l1c_code_table(code_idx).d_code;
             elseif lower(component) == 'p'
-                chips = l1c_code_table(code_idx).p_code;
-                secondary_code = l1c_overlay_table(code_idx).p_overlay;
+                chips = table.l1c_code_table(code_idx).p_code;
+                secondary_code = table.l1c_overlay_table(code_idx).p_overlay;
                 % Apply the piot overlay code 
                 upsampled_secondary_code = kron(secondary_code, ones(numel(chips), 1));
                 chips = bitxor(repmat(chips, numel(secondary_code), 1), upsampled_secondary_code);
@@ -58,11 +75,6 @@ classdef GPSL1CCodeGenerator < RepeatingSampleGenerator
 
             % Compute BOC(1,1) samples from chips, scale [0/1] to [-1/1].
             samples = (binToBOC(chips', 1, 1)') * 2 - 1;
-            CHIPPING_RATE = 1.023e6;
-            SUB_CHIP_RATE = CHIPPING_RATE * 2;
-            obj = obj@RepeatingSampleGenerator(samples, 1, SUB_CHIP_RATE, true);
-
-            obj.prn = prn;
         end
     end
 end
@@ -31,6 +31,23 @@ classdef GPSL5CodeGenerator < RepeatingSampleGenerator
         %
         % @param[out] obj The created object.
         
+            modulated_chips = CodeTableRegistry.getSequence( ...
+                sprintf('l5_code_table.mat/%c/%d', lower(component), prn), ...
+                @() GPSL5CodeGenerator.buildChips(prn, component));
+            
+            CHIPPING_RATE = 10.23e6;
+            obj = obj@RepeatingSampleGenerator(modulated_chips, 1, CHIPPING_RATE, true);
+
+            obj.prn = prn;
+        end
+    end
+
+    methods (Static = true, Access = private)
+        function modulated_chips = buildChips(prn, component)
+        %%
+        % @brief Build the modulated chip sequence for a PRN and component.
+        %        Called once per PRN and component through CodeTableRegistry.
+
             % pre-generated struct array with elements prn, i_code, q_code. i_code and q_code are
             % 10230-element arrays containing the 1/0-valued PRN sequences for the data and pilot
             % components, respectively, for L5
@@ -40,30 +57,25 @@ classdef GPSL5CodeGenerator < RepeatingSampleGenerator
                 error(['Cannot find L5 PRN code table ' code_table '\n'])
             end
 
-            load(code_table)
-            code_idx = find([l5_code_table.prn]==prn,1);
+            table = CodeTableRegistry.getTable(code_table);
+            code_idx = find([table.l5_code_table.prn]==prn,1);
             if isempty(code_idx)
                 error(['Code sequence for PRN ' prn ' not present in table ' code_table '\n']);
             end
             if lower(component) == 'i'
-                chips = l5_code_table(code_idx).i_code;  
-                secondary_code = nh_i(:);
+                chips = table.l5_code_table(code_idx).i_code;  
+                secondary_code = table.nh_i(:);
             elseif lower(component) == 'q'
-                chips = l5_code_table(code_idx).q_code;
-                secondary_code = nh_q(:);
+                chips = table.l5_code_table(code_idx).q_code;
+                secondary_code = table.nh_q(:);
             else
                 error('Component must be either I or Q')
             end
             
-            CHIPPING_RATE = 10.23e6;
-            
             % Apply the Neuman-Hofman secondary code and convert to +/- 1
             upsampled_secondary_code = kron(secondary_code, ones(numel(chips), 1));
             modulated_chips = bitxor(repmat(chips, numel(secondary_code), 1), ...
                               upsampled_secondary_code) * 2 - 1;
-            obj = obj@RepeatingSampleGenerator(modulated_chips, 1, CHIPPING_RATE, true);
-
-            obj.prn = prn;
         end
     end
 end
@@ -0,0 +1,149 @@
+/**************************************************************************//**
+ * @brief      Fused noise generation and quantization stage implementation.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include "iq_output_stage.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "philox.h"
+#include "ppval_kernel.h"
+
+namespace oosiggen
+{
+
+namespace
+{
+
+/**
+ * @brief Round to nearest (ties away from zero) and saturate, as MATLAB's
+ *        int16() does; NaN becomes zero.
+ */
+inline int16_t convertSample(double value, int16_t*)
+{
+    if (!(value == value))
+    {
+        return 0;
+    }
+    const double rounded = std::round(value);
+    if (rounded >= 32767.0)
+    {
+        return 32767;
+    }
+    if (rounded <= -32768.0)
+    {
+        return -32768;
+    }
+    return static_cast<int16_t>(rounded);
+}
+
+/**
+ * @brief Convert to single precision, as MATLAB's single() does.
+ */
+inline float convertSample(double value, float*)
+{
+    return static_cast<float>(value);
+}
+
+} // namespace
+
+const size_t IqOutputStage::kTaskSize;
+const size_t IqOutputStage::kBlockSize;
+
+IqOutputStage::IqOutputStage(
+    const std::shared_ptr<CompiledSpline> &noise_density,
+    double sampling_rate, double scale_factor, uint64_t seed,
+    size_t num_threads)
+    : noise_density_(noise_density), noise_scale_(sampling_rate / 2.0),
+      scale_factor_(scale_factor), seed_(seed), sample_counter_(0),
+      pool_(num_threads)
+{
+    if (!noise_density_)
+    {
+        throw std::invalid_argument("A noise density spline is required.");
+    }
+    if (!(sampling_rate > 0.0))
+    {
+        throw std::invalid_argument("sampling_rate must be positive.");
+    }
+}
+
+void IqOutputStage::process(const double *times, size_t num_samples,
+                            const double *real, const double *imag,
+                            size_t stride, int16_t *output)
+{
+    processSamples(times, num_samples, real, imag, stride, output);
+}
+
+void IqOutputStage::process(const double *times, size_t num_samples,
+                            const double *real, const double *imag,
+                            size_t stride, float *output)
+{
+    processSamples(times, num_samples, real, imag, stride, output);
+}
+
+template <typename T>
+void IqOutputStage::processSamples(const double *times, size_t num_samples,
+                                   const double *real, const double *imag,
+                                   size_t stride, T *output)
+{
+    const CompiledSpline &spline = *noise_density_;
+    const CoefficientLayout layout = spline.layout();
+    const unsigned long long first_sample = sample_counter_;
+    const size_t num_tasks = (num_samples + kTaskSize - 1) / kTaskSize;
+
+    // The spline is only read, and each task keeps its own search cursor, so
+    // the tasks are independent.
+    pool_.parallelFor(num_tasks, [&](size_t task_idx) {
+        const size_t task_start = task_idx * kTaskSize;
+        const size_t task_end = num_samples - task_start < kTaskSize ?
+                                num_samples : task_start + kTaskSize;
+        size_t cursor = 0;
+        double power[kBlockSize];
+        double noise_i[kBlockSize];
+        double noise_q[kBlockSize];
+        for (size_t start = task_start; start < task_end; start += kBlockSize)
+        {
+            const size_t count = task_end - start < kBlockSize ?
+                                 task_end - start : kBlockSize;
+            evaluatePiecewisePolynomial(spline.breaks(), spline.numBreaks(),
+                                        layout, times + start, count, power,
+                                        cursor);
+            philoxGaussianPairs(seed_, first_sample + start, count, noise_i,
+                                noise_q);
+
+            for (size_t idx = 0; idx < count; ++idx)
+            {
+                const size_t sample_idx = start + idx;
+                const double noise_std = power[idx] > 0.0 ?
+                    std::sqrt(power[idx] * noise_scale_) : 0.0;
+
+                const double sample_i = real[sample_idx * stride];
+                const double sample_q =
+                    imag == NULL ? 0.0 : imag[sample_idx * stride];
+                output[2 * sample_idx] = convertSample(
+                    (sample_i + noise_std * noise_i[idx]) * scale_factor_,
+                    output);
+                output[2 * sample_idx + 1] = convertSample(
+                    (sample_q + noise_std * noise_q[idx]) * scale_factor_,
+                    output);
+            }
+        }
+    });
+
+    sample_counter_ += num_samples;
+}
+
+} // namespace oosiggen
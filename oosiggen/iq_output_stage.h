@@ -0,0 +1,126 @@
+/**************************************************************************//**
+ * @brief      Fused noise generation and quantization stage for IQ output.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_IQ_OUTPUT_STAGE_H_
+#define OOSIGGEN_IQ_OUTPUT_STAGE_H_
+
+#include <cstddef>
+#include <memory>
+#include <stdint.h>
+
+#include "compiled_spline.h"
+#include "thread_pool.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief Adds thermal noise to composite samples, scales them and writes
+ *        them as interleaved I/Q.
+ *
+ * This is the native counterpart of the output loop of generate_iq.m: for
+ * each sample,
+ * <c>noise = sqrt(noise_density(t) * sampling_rate / 2) * (g_i + 1i*g_q)</c>
+ * with standard normal @c g_i and @c g_q, and the output is
+ * <c>(sample + noise) * scale_factor</c>, interleaved as I, Q, I, Q, ....
+ * Integer output is rounded to nearest (ties away from zero) and saturated,
+ * as MATLAB's int16() does.
+ *
+ * The noise density spline lookup, noise generation, scaling and
+ * quantization are fused into one pass per block of samples, and blocks are
+ * processed in parallel. The normal variates for each sample are drawn from
+ * a Philox generator (see philox.h) keyed by the seed and counted by the
+ * sample's index from the start of the run, so the output depends only on
+ * the seed, however the run is divided into chunks and threads.
+ */
+class IqOutputStage
+{
+public:
+    /**
+     * @param noise_density The noise power spectral density vs time (in
+     *        W/Hz vs sec). Negative values are treated as zero.
+     * @param sampling_rate The sampling rate (in samples/sec).
+     * @param scale_factor The factor applied to the noisy samples.
+     * @param seed The noise generator seed.
+     * @param num_threads The number of threads to process with.
+     */
+    IqOutputStage(const std::shared_ptr<CompiledSpline> &noise_density,
+                  double sampling_rate, double scale_factor, uint64_t seed,
+                  size_t num_threads);
+
+    /**
+     * @brief The index, from the start of the run, of the next sample.
+     */
+    unsigned long long sampleCounter() const { return sample_counter_; }
+
+    /**
+     * @brief Set the index of the next sample, so that a run may start or
+     *        resume anywhere with the noise of a run from the start.
+     */
+    void seek(unsigned long long sample_index)
+    {
+        sample_counter_ = sample_index;
+    }
+
+    /**
+     * @brief Process the next block of samples into 16-bit integer I/Q.
+     *
+     * @param times The time of each sample (in sec).
+     * @param num_samples The number of samples.
+     * @param real The real parts of the samples.
+     * @param imag The imaginary parts of the samples; NULL for real samples.
+     * @param stride The distance between consecutive elements of @c real and
+     *        of @c imag; 1 for split arrays, or 2 for interleaved complex
+     *        data.
+     * @param output The interleaved I/Q output (<c>2 * num_samples</c>
+     *        elements).
+     */
+    void process(const double *times, size_t num_samples, const double *real,
+                 const double *imag, size_t stride, int16_t *output);
+
+    /**
+     * @brief Process the next block of samples into single-precision I/Q.
+     *
+     * @copydetails process(const double*, size_t, const double*,
+     *              const double*, size_t, int16_t*)
+     */
+    void process(const double *times, size_t num_samples, const double *real,
+                 const double *imag, size_t stride, float *output);
+
+private:
+    /// The number of samples per parallel task.
+    static const size_t kTaskSize = 16384;
+    /// The number of samples per pass within a task.
+    static const size_t kBlockSize = 512;
+
+    IqOutputStage(const IqOutputStage&);
+    IqOutputStage &operator=(const IqOutputStage&);
+
+    template <typename T>
+    void processSamples(const double *times, size_t num_samples,
+                        const double *real, const double *imag, size_t stride,
+                        T *output);
+
+    std::shared_ptr<CompiledSpline> noise_density_; ///< Noise PSD vs time.
+    double noise_scale_; ///< <c>sampling_rate / 2</c>.
+    double scale_factor_; ///< The output scale factor.
+    uint64_t seed_; ///< The noise generator key.
+    unsigned long long sample_counter_; ///< Index of the next sample.
+    ThreadPool pool_; ///< Processes blocks of samples.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_IQ_OUTPUT_STAGE_H_
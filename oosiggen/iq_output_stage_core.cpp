@@ -0,0 +1,373 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to the fused IQ output stage.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <utility> // For move().
+
+#include "mex.h"
+
+#include "compiled_spline.h"
+#include "iq_output_stage.h"
+#include "mex_handle_registry.h"
+
+namespace
+{
+
+/**
+ * @brief An output stage and the data type it produces.
+ */
+struct OutputStage
+{
+    std::unique_ptr<oosiggen::IqOutputStage> stage;
+    bool integer_output; ///< True for int16 output, false for single.
+};
+
+/**
+ * @brief The output stages owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<OutputStage> &stages()
+{
+    static oosiggen::MexHandleRegistry<OutputStage>
+        registry("iqOutputStageCore");
+    return registry;
+}
+
+/**
+ * @brief The fencepost storage of the noise density splines.
+ */
+oosiggen::BreaksPool &breaksPool()
+{
+    static oosiggen::BreaksPool pool;
+    return pool;
+}
+
+/**
+ * @brief Free all output stages when the MEX file is cleared.
+ */
+void freeAllStages()
+{
+    stages().clear();
+}
+
+/**
+ * @brief Check that an argument is a real scalar double.
+ */
+bool isRealScalar(const mxArray *array)
+{
+    return array != NULL && mxIsDouble(array) && !mxIsComplex(array) &&
+           mxGetNumberOfElements(array) == 1;
+}
+
+/**
+ * @brief Compile the noise density spline from its breaks and coefficients.
+ */
+std::shared_ptr<oosiggen::CompiledSpline> compileNoiseDensity(
+    const mxArray *breaks_array, const mxArray *coefs_array)
+{
+    const size_t num_breaks = mxGetN(breaks_array);
+    if (breaks_array == NULL || !mxIsDouble(breaks_array) ||
+        mxIsComplex(breaks_array) ||
+        (mxGetNumberOfElements(breaks_array) != num_breaks))
+    {
+        mexErrMsgTxt("breaks must be a real row array of doubles.");
+    }
+    if (num_breaks < 2)
+    {
+        mexErrMsgTxt("breaks must contain at least two fenceposts.");
+    }
+
+    const size_t num_polynomials = mxGetM(coefs_array);
+    const size_t order = mxGetN(coefs_array);
+    if (coefs_array == NULL || !mxIsDouble(coefs_array) ||
+        mxIsComplex(coefs_array) ||
+        (mxGetNumberOfElements(coefs_array) != num_polynomials * order))
+    {
+        mexErrMsgTxt("coefs must be a real matrix of doubles.");
+    }
+    if (num_polynomials != num_breaks - 1)
+    {
+        mexErrMsgTxt("Number of polynomials is not consistent with number "
+                     "of breaks.");
+    }
+
+    const double *breaks = static_cast<double*>(mxGetPr(breaks_array));
+    for (size_t break_idx = 1; break_idx < num_breaks; ++break_idx)
+    {
+        if (!(breaks[break_idx] >= breaks[break_idx - 1]))
+        {
+            mexErrMsgTxt("breaks must be sorted in ascending order.");
+        }
+    }
+    return std::make_shared<oosiggen::CompiledSpline>(
+        breaksPool().intern(breaks, num_breaks),
+        static_cast<double*>(mxGetPr(coefs_array)), order);
+}
+
+/**
+ * @brief Create an output stage.
+ */
+void createStage(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 8)
+    {
+        mexErrMsgTxt("create requires breaks, coefs, sampling_rate, "
+                     "scale_factor, seed, data_type and num_threads.");
+    }
+    for (int arg_idx = 3; arg_idx < 8; ++arg_idx)
+    {
+        if (arg_idx != 6 && !isRealScalar(prhs[arg_idx]))
+        {
+            mexErrMsgTxt("sampling_rate, scale_factor, seed and num_threads "
+                         "must be real scalar doubles.");
+        }
+    }
+    const double seed = mxGetScalar(prhs[5]);
+    if (!(seed >= 0.0) || seed != static_cast<double>(
+            static_cast<uint64_t>(seed)))
+    {
+        mexErrMsgTxt("seed must be a non-negative integer.");
+    }
+    const double num_threads = mxGetScalar(prhs[7]);
+    if (!(num_threads >= 1.0))
+    {
+        mexErrMsgTxt("num_threads must be at least one.");
+    }
+
+    char data_type[8];
+    if (!mxIsChar(prhs[6]) ||
+        mxGetString(prhs[6], data_type, sizeof(data_type)) != 0 ||
+        (std::strcmp(data_type, "int16") != 0 &&
+         std::strcmp(data_type, "single") != 0))
+    {
+        mexErrMsgTxt("data_type must be 'int16' or 'single'.");
+    }
+
+    std::unique_ptr<OutputStage> stage(new OutputStage());
+    stage->integer_output = std::strcmp(data_type, "int16") == 0;
+    try
+    {
+        stage->stage.reset(new oosiggen::IqOutputStage(
+            compileNoiseDensity(prhs[1], prhs[2]), mxGetScalar(prhs[3]),
+            mxGetScalar(prhs[4]), static_cast<uint64_t>(seed),
+            static_cast<size_t>(num_threads)));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = stages().add(std::move(stage));
+}
+
+/**
+ * @brief Add noise to, scale and quantize a block of samples.
+ */
+void processSamples(int nlhs, mxArray *plhs[], int nrhs,
+                    const mxArray *prhs[])
+{
+    if (nrhs != 4)
+    {
+        mexErrMsgTxt("process requires a handle, time_vector and samples.");
+    }
+    OutputStage &stage = stages().get(prhs[1]);
+
+    const size_t num_samples = mxGetM(prhs[2]);
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        (mxGetNumberOfElements(prhs[2]) != num_samples))
+    {
+        mexErrMsgTxt("time_vector must be a real column array of doubles.");
+    }
+    if (prhs[3] == NULL || !mxIsDouble(prhs[3]) ||
+        mxGetNumberOfElements(prhs[3]) != num_samples ||
+        mxGetM(prhs[3]) != num_samples)
+    {
+        mexErrMsgTxt("samples must be a column array of doubles the length "
+                     "of time_vector.");
+    }
+
+    // Access the samples in place, whatever their complex storage format.
+    const double *real;
+    const double *imag = NULL;
+    size_t stride = 1;
+#if MX_HAS_INTERLEAVED_COMPLEX
+    if (mxIsComplex(prhs[3]))
+    {
+        const double *data =
+            reinterpret_cast<const double*>(mxGetComplexDoubles(prhs[3]));
+        real = data;
+        imag = data + 1;
+        stride = 2;
+    }
+    else
+    {
+        real = mxGetDoubles(prhs[3]);
+    }
+#else
+    real = static_cast<double*>(mxGetPr(prhs[3]));
+    if (mxIsComplex(prhs[3]))
+    {
+        imag = static_cast<double*>(mxGetPi(prhs[3]));
+    }
+#endif
+
+    plhs[0] = mxCreateNumericMatrix(
+        1, static_cast<mwSize>(2 * num_samples),
+        stage.integer_output ? mxINT16_CLASS : mxSINGLE_CLASS, mxREAL);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+
+    const double *times = static_cast<double*>(mxGetPr(prhs[2]));
+    try
+    {
+        if (stage.integer_output)
+        {
+            stage.stage->process(times, num_samples, real, imag, stride,
+                                 static_cast<int16_t*>(mxGetData(plhs[0])));
+        }
+        else
+        {
+            stage.stage->process(times, num_samples, real, imag, stride,
+                                 static_cast<float*>(mxGetData(plhs[0])));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+}
+
+/**
+ * @brief Set the index of an output stage's next sample.
+ */
+void seekStage(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("seek requires a handle and sample_index.");
+    }
+    OutputStage &stage = stages().get(prhs[1]);
+    if (!mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        mxGetNumberOfElements(prhs[2]) != 1 || !(mxGetScalar(prhs[2]) >= 0.0))
+    {
+        mexErrMsgTxt("sample_index must be a non-negative real scalar "
+                     "double.");
+    }
+    stage.stage->seek(static_cast<unsigned long long>(mxGetScalar(prhs[2])));
+}
+
+/**
+ * @brief Free one or more output stages.
+ */
+void freeStages(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    stages().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = iqOutputStageCore('create', breaks, coefs, sampling_rate, ...
+ *                       scale_factor, seed, data_type, num_threads)
+ * data_iq = iqOutputStageCore('process', h, time_vector, samples)
+ * iqOutputStageCore('seek', h, sample_index)
+ * iqOutputStageCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>prhs[1]</c>: The noise density spline fenceposts, a real row vector.
+ * - <c>prhs[2]</c>: The noise density spline coefficients, one row per
+ *   polynomial, highest power first (as for a ppval() struct).
+ * - <c>prhs[3]</c>: The sampling rate (in samples/sec).
+ * - <c>prhs[4]</c>: The factor applied to the noisy samples.
+ * - <c>prhs[5]</c>: The noise generator seed, a non-negative integer.
+ * - <c>prhs[6]</c>: The output data type, @c 'int16' or @c 'single'.
+ * - <c>prhs[7]</c>: The number of threads to process with. The output does
+ *   not depend on this value.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the new output stage.
+ *
+ * For @c 'process':
+ * - <c>prhs[1]</c>: The output stage handle.
+ * - <c>prhs[2]</c>: The time of each sample (in sec), a real column vector.
+ * - <c>prhs[3]</c>: The next block of samples, a real or complex column
+ *   vector the length of <c>prhs[2]</c>.
+ * - <c>plhs[0]</c>: The interleaved I/Q row vector, of the output data type.
+ *
+ * For @c 'seek':
+ * - <c>prhs[1]</c>: The output stage handle.
+ * - <c>prhs[2]</c>: The zero-indexed sample, from the start of the run, that
+ *   the next call to @c 'process' starts at.
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllStages);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createStage(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "process") == 0)
+    {
+        processSamples(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "seek") == 0)
+    {
+        seekStage(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeStages(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
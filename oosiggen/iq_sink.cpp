@@ -0,0 +1,208 @@
+/**************************************************************************//**
+ * @brief      Destinations for a live stream of IQ samples.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include "iq_sink.h"
+
+#include <cerrno>
+#include <cstdlib> // For strtoul().
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace oosiggen
+{
+
+namespace
+{
+
+/// The socket send buffer requested, to absorb bursts of paced packets.
+const int kSendBufferBytes = 4 << 20;
+
+#if defined(_WIN32)
+const unsigned long long kNoSocket =
+    static_cast<unsigned long long>(INVALID_SOCKET);
+#else
+const int kNoSocket = -1;
+#endif
+
+} // namespace
+
+const size_t UdpSink::kDefaultPacketBytes;
+
+UdpSink::UdpSink(const std::string &host, unsigned short port,
+                 size_t max_packet_bytes)
+    : socket_(kNoSocket), max_packet_bytes_(max_packet_bytes)
+{
+    if (max_packet_bytes == 0 || max_packet_bytes > 65507)
+    {
+        throw std::invalid_argument("UDP packets must hold 1 to 65507 "
+                                    "bytes.");
+    }
+#if defined(_WIN32)
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+    {
+        throw std::runtime_error("Could not initialize Winsock.");
+    }
+#endif
+
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo *addresses = NULL;
+    const std::string service = std::to_string(port);
+    const int status = ::getaddrinfo(host.c_str(), service.c_str(), &hints,
+                                     &addresses);
+    if (status != 0)
+    {
+#if defined(_WIN32)
+        WSACleanup();
+#endif
+        throw std::runtime_error("Could not resolve \"" + host + "\": " +
+                                 gai_strerror(status));
+    }
+
+    // Connecting fixes the destination, so each packet is a plain send().
+    for (struct addrinfo *address = addresses;
+         address != NULL && socket_ == kNoSocket; address = address->ai_next)
+    {
+        socket_ = ::socket(address->ai_family, address->ai_socktype,
+                           address->ai_protocol);
+        if (socket_ == kNoSocket)
+        {
+            continue;
+        }
+        if (::connect(socket_, address->ai_addr,
+                      static_cast<int>(address->ai_addrlen)) != 0)
+        {
+#if defined(_WIN32)
+            ::closesocket(socket_);
+#else
+            ::close(socket_);
+#endif
+            socket_ = kNoSocket;
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (socket_ == kNoSocket)
+    {
+#if defined(_WIN32)
+        WSACleanup();
+#endif
+        throw std::runtime_error("Could not open a UDP socket to \"" +
+                                 host + "\".");
+    }
+    // A smaller buffer than requested only makes drops more likely.
+    ::setsockopt(socket_, SOL_SOCKET, SO_SNDBUF,
+                 reinterpret_cast<const char*>(&kSendBufferBytes),
+                 sizeof(kSendBufferBytes));
+}
+
+UdpSink::~UdpSink()
+{
+#if defined(_WIN32)
+    ::closesocket(socket_);
+    WSACleanup();
+#else
+    ::close(socket_);
+#endif
+}
+
+void UdpSink::send(const char *data, size_t num_bytes)
+{
+    for (;;)
+    {
+#if defined(_WIN32)
+        if (::send(socket_, data, static_cast<int>(num_bytes), 0) >= 0)
+        {
+            return;
+        }
+        // A receiver that is not yet listening is not an error.
+        const int error_number = WSAGetLastError();
+        if (error_number == WSAECONNRESET)
+        {
+            return;
+        }
+        throw std::runtime_error("Could not send a UDP packet (Winsock "
+                                 "error " + std::to_string(error_number) +
+                                 ").");
+#else
+        if (::send(socket_, data, num_bytes, 0) >= 0)
+        {
+            return;
+        }
+        // A receiver that is not yet listening is not an error, and a full
+        // interface queue only delays the packet.
+        if (errno == ECONNREFUSED)
+        {
+            return;
+        }
+        if (errno != EINTR && errno != ENOBUFS)
+        {
+            throw std::runtime_error(
+                std::string("Could not send a UDP packet: ") +
+                std::strerror(errno));
+        }
+#endif
+    }
+}
+
+std::unique_ptr<IqSink> createIqSink(const std::string &destination,
+                                     size_t max_packet_bytes)
+{
+    const std::string udp_scheme("udp://");
+    if (destination.compare(0, udp_scheme.size(), udp_scheme) == 0)
+    {
+        const std::string address = destination.substr(udp_scheme.size());
+        const size_t colon = address.rfind(':');
+        if (colon == std::string::npos || colon == 0 ||
+            colon + 1 == address.size())
+        {
+            throw std::invalid_argument("A UDP destination must be "
+                                        "udp://host:port.");
+        }
+        std::string host = address.substr(0, colon);
+        if (host.size() > 2 && host[0] == '[' && host[host.size() - 1] == ']')
+        {
+            host = host.substr(1, host.size() - 2);
+        }
+        const std::string port_text = address.substr(colon + 1);
+        char *end = NULL;
+        const unsigned long port = std::strtoul(port_text.c_str(), &end, 10);
+        if (*end != '\0' || port == 0 || port > 65535)
+        {
+            throw std::invalid_argument("Invalid UDP port \"" + port_text +
+                                        "\".");
+        }
+        return std::unique_ptr<IqSink>(new UdpSink(
+            host, static_cast<unsigned short>(port),
+            max_packet_bytes > 0 ? max_packet_bytes :
+                                   UdpSink::kDefaultPacketBytes));
+    }
+    throw std::invalid_argument("Unsupported destination \"" + destination +
+                                "\"; only udp://host:port is supported.");
+}
+
+} // namespace oosiggen
@@ -0,0 +1,109 @@
+/**************************************************************************//**
+ * @brief      Destinations for a live stream of IQ samples.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_IQ_SINK_H_
+#define OOSIGGEN_IQ_SINK_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace oosiggen
+{
+
+/**
+ * @brief A destination for packets of interleaved IQ samples, such as a
+ *        network socket or an SDR transmit stream.
+ *
+ * A sink only transfers bytes; the RealtimeStreamer that owns it paces the
+ * packets at the sample rate and calls it from its own transmit thread. A
+ * new kind of destination is supported by implementing send() and
+ * registering it in createIqSink().
+ */
+class IqSink
+{
+public:
+    virtual ~IqSink() {}
+
+    /**
+     * @brief Send one packet. Throws on an error that ends the stream.
+     *
+     * @param data The packet bytes: whole interleaved IQ samples.
+     * @param num_bytes The packet size; at most maxPacketBytes().
+     */
+    virtual void send(const char *data, size_t num_bytes) = 0;
+
+    /**
+     * @brief The largest packet that send() accepts (in bytes).
+     */
+    virtual size_t maxPacketBytes() const = 0;
+};
+
+/**
+ * @brief Sends each packet as one UDP datagram to a fixed address.
+ *
+ * Datagrams carry no header, so the receiver sees the same byte stream as an
+ * IQ file, split into packets; a lost datagram is a gap in the stream.
+ */
+class UdpSink : public IqSink
+{
+public:
+    /// The largest payload that fits an Ethernet frame unfragmented.
+    static const size_t kDefaultPacketBytes = 1472;
+
+    /**
+     * @brief Open a socket to send to a host and port.
+     *
+     * @param host The destination host name or IPv4/IPv6 address.
+     * @param port The destination UDP port.
+     * @param max_packet_bytes The largest datagram payload to send.
+     */
+    UdpSink(const std::string &host, unsigned short port,
+            size_t max_packet_bytes);
+
+    ~UdpSink();
+
+    void send(const char *data, size_t num_bytes);
+
+    size_t maxPacketBytes() const { return max_packet_bytes_; }
+
+private:
+    UdpSink(const UdpSink&);
+    UdpSink &operator=(const UdpSink&);
+
+#if defined(_WIN32)
+    unsigned long long socket_; ///< The socket (a Winsock SOCKET).
+#else
+    int socket_; ///< The socket descriptor.
+#endif
+    size_t max_packet_bytes_; ///< The largest payload sent.
+};
+
+/**
+ * @brief Create a sink from a destination string.
+ *
+ * The destination takes the form <c>udp://host:port</c>, with the host of
+ * an IPv6 address in brackets.
+ *
+ * @param destination The destination string.
+ * @param max_packet_bytes The largest packet to send, or 0 for the sink's
+ *        default.
+ */
+std::unique_ptr<IqSink> createIqSink(const std::string &destination,
+                                     size_t max_packet_bytes);
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_IQ_SINK_H_
@@ -1,7 +1,77 @@
+% Enable the vectorized (AVX2 + FMA) kernels on x86-64 platforms. Set
+% simd_flags to {} to build portable binaries for older processors; the
+% kernels fall back to scalar code.
+switch computer('arch')
+    case 'win64'
+        simd_flags = {'COMPFLAGS=$COMPFLAGS /arch:AVX2'};
+    case {'glnxa64', 'maci64'}
+        simd_flags = {'CXXFLAGS=$CXXFLAGS -mavx2 -mfma'};
+    otherwise
+        simd_flags = {};
+end
+
+% Use the interleaved complex API (MATLAB R2018a and later) where available,
+% so complex data is passed without converting to split real/imag arrays.
+if verLessThan('matlab', '9.4')
+    complex_api_flags = {};
+else
+    complex_api_flags = {'-R2018a'};
+end
 
 disp('Compiling nonUniformResampleFast...');
-mex('-output', 'nonUniformResampleFast', '-DMEX', ...
+mex('-output', 'nonUniformResampleFast', '-DMEX', complex_api_flags{:}, ...
     'non_uniform_resample_fast.cpp');
 
 disp('Compiling ppvalFastCore...');
-mex('-output', 'ppvalFastCore', '-DMEX', 'ppval_fast_core.cpp');
+mex('-output', 'ppvalFastCore', '-DMEX', simd_flags{:}, ...
+    'ppval_fast_core.cpp');
+
+disp('Compiling ppvalFastMultiCore...');
+mex('-output', 'ppvalFastMultiCore', '-DMEX', simd_flags{:}, ...
+    'ppval_fast_multi_core.cpp');
+
+disp('Compiling ppvalSplineCore...');
+mex('-output', 'ppvalSplineCore', '-DMEX', simd_flags{:}, ...
+    'ppval_spline_core.cpp', 'piecewise_polynomial_file.cpp');
+
+disp('Compiling readPiecewisePolynomialFast...');
+mex('-output', 'readPiecewisePolynomialFast', '-DMEX', ...
+    'read_piecewise_polynomial_fast.cpp', 'piecewise_polynomial_file.cpp');
+
+disp('Compiling streamingResamplerCore...');
+mex('-output', 'streamingResamplerCore', '-DMEX', ...
+    'streaming_resampler_core.cpp');
+
+disp('Compiling ncoRotate...');
+mex('-output', 'ncoRotate', '-DMEX', simd_flags{:}, 'nco_rotate.cpp');
+
+disp('Compiling polyphaseDecimatorCore...');
+mex('-output', 'polyphaseDecimatorCore', '-DMEX', simd_flags{:}, ...
+    'polyphase_decimator_core.cpp');
+
+disp('Compiling iqOutputStageCore...');
+mex('-output', 'iqOutputStageCore', '-DMEX', complex_api_flags{:}, ...
+    simd_flags{:}, 'iq_output_stage_core.cpp', 'iq_output_stage.cpp');
+
+disp('Compiling chipSourceCore...');
+mex('-output', 'chipSourceCore', '-DMEX', 'chip_source_core.cpp');
+
+disp('Compiling compositeEngineCore...');
+mex('-output', 'compositeEngineCore', '-DMEX', simd_flags{:}, ...
+    'composite_engine_core.cpp', 'composite_engine.cpp');
+
+disp('Compiling asyncFileWriterCore...');
+mex('-output', 'asyncFileWriterCore', '-DMEX', ...
+    'async_file_writer_core.cpp', 'async_file_writer.cpp');
+
+% Sockets are in a separate library on Windows.
+if ispc
+    socket_libs = {'-lws2_32'};
+else
+    socket_libs = {};
+end
+
+disp('Compiling realtimeStreamerCore...');
+mex('-output', 'realtimeStreamerCore', '-DMEX', ...
+    'realtime_streamer_core.cpp', 'realtime_streamer.cpp', 'iq_sink.cpp', ...
+    socket_libs{:});
@@ -0,0 +1,175 @@
+/**************************************************************************//**
+ * @brief      Registry mapping MATLAB-visible integer handles to native
+ *             objects that persist between MEX calls.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_MEX_HANDLE_REGISTRY_H_
+#define OOSIGGEN_MEX_HANDLE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility> // For move().
+
+#include "mex.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief Owns native objects on behalf of MATLAB code, which refers to them
+ *        through @c uint64 scalar handles.
+ *
+ * Handles are never reused within a MATLAB session, so a stale handle is
+ * reported as an error rather than silently referring to a newer object. The
+ * MEX file is locked while any object is registered so that
+ * <c>clear mex</c> cannot unload the code that owns them.
+ *
+ * A MEX function should hold one registry per object type as a function-local
+ * static, and free everything from a mexAtExit() callback.
+ */
+template <typename T>
+class MexHandleRegistry
+{
+public:
+    /**
+     * @brief Create a registry.
+     *
+     * @param type_name The name of the object type, used in error messages.
+     */
+    explicit MexHandleRegistry(const char *type_name)
+        : type_name_(type_name), next_handle_(1)
+    {
+    }
+
+    ~MexHandleRegistry()
+    {
+        // The MEX file is being unloaded, so it is no longer locked.
+        objects_.clear();
+    }
+
+    /**
+     * @brief Take ownership of an object.
+     *
+     * @return A new @c uint64 scalar handle referring to the object.
+     */
+    mxArray *add(std::unique_ptr<T> object)
+    {
+        const unsigned long long handle = next_handle_++;
+        if (objects_.empty())
+        {
+            mexLock();
+        }
+        objects_[handle] = std::move(object);
+
+        mxArray *handle_array = mxCreateNumericMatrix(1, 1, mxUINT64_CLASS,
+                                                      mxREAL);
+        if (handle_array == NULL)
+        {
+            mexErrMsgTxt("Could not allocate output array.");
+        }
+        *static_cast<unsigned long long*>(mxGetData(handle_array)) = handle;
+        return handle_array;
+    }
+
+    /**
+     * @brief Look up the object referred to by a single handle; raises a
+     *        MATLAB error if the handle is invalid.
+     */
+    T &get(const mxArray *handle_array)
+    {
+        if (handle_array == NULL || !mxIsUint64(handle_array) ||
+            mxGetNumberOfElements(handle_array) != 1)
+        {
+            error("handle must be a uint64 scalar.");
+        }
+        return get(*static_cast<unsigned long long*>(
+            mxGetData(handle_array)));
+    }
+
+    /**
+     * @brief Look up the object referred to by a raw handle value; raises a
+     *        MATLAB error if the handle is invalid.
+     */
+    T &get(unsigned long long handle)
+    {
+        typename ObjectMap::iterator it = objects_.find(handle);
+        if (it == objects_.end())
+        {
+            error("invalid or already freed handle.");
+        }
+        return *it->second;
+    }
+
+    /**
+     * @brief Free the objects referred to by an array of handles. Freeing an
+     *        unknown handle raises a MATLAB error.
+     */
+    void remove(const mxArray *handle_array)
+    {
+        if (handle_array == NULL || !mxIsUint64(handle_array))
+        {
+            error("handle must be a uint64 array.");
+        }
+        const unsigned long long *handles =
+            static_cast<unsigned long long*>(mxGetData(handle_array));
+        const size_t num_handles = mxGetNumberOfElements(handle_array);
+        for (size_t idx = 0; idx < num_handles; ++idx)
+        {
+            get(handles[idx]); // Validate all before freeing any.
+        }
+        for (size_t idx = 0; idx < num_handles; ++idx)
+        {
+            objects_.erase(handles[idx]);
+        }
+        if (num_handles > 0 && objects_.empty())
+        {
+            mexUnlock();
+        }
+    }
+
+    /**
+     * @brief Free all registered objects.
+     */
+    void clear()
+    {
+        if (!objects_.empty())
+        {
+            objects_.clear();
+            mexUnlock();
+        }
+    }
+
+    /**
+     * @brief The number of registered objects.
+     */
+    size_t size() const { return objects_.size(); }
+
+private:
+    typedef std::map<unsigned long long, std::unique_ptr<T> > ObjectMap;
+
+    void error(const char *message) const
+    {
+        const std::string text = type_name_ + ": " + message;
+        mexErrMsgTxt(text.c_str());
+    }
+
+    std::string type_name_; ///< Object type name for error messages.
+    unsigned long long next_handle_; ///< The next handle to issue.
+    ObjectMap objects_; ///< The registered objects, by handle.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_MEX_HANDLE_REGISTRY_H_
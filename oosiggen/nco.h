@@ -0,0 +1,339 @@
+/**************************************************************************//**
+ * @brief      Numerically controlled oscillator (NCO) kernels that apply a
+ *             carrier rotation to a block of samples in place.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_NCO_H_
+#define OOSIGGEN_NCO_H_
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+#include "compiled_spline.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief The number of samples between resynchronizations of a recursive
+ *        rotator to its exactly computed phase.
+ *
+ * Every recursive step rounds the rotator by about one unit in the last
+ * place, so resynchronizing bounds both the magnitude and the phase error to
+ * roughly this many ulps, without any separate renormalization.
+ */
+const size_t kNcoResyncInterval = 256;
+
+/**
+ * @brief Wrap a phase to the interval [0, 2*pi), as MATLAB's mod() does.
+ */
+inline double ncoWrapPhase(double phase)
+{
+    const double two_pi = 6.28318530717958647692;
+    phase = std::fmod(phase, two_pi);
+    return phase < 0.0 ? phase + two_pi : phase;
+}
+
+/**
+ * @brief The fractional part of <c>cycles * count</c>, without the rounding
+ *        error of the (possibly large) product.
+ */
+inline double ncoFractionalCycles(double cycles, double count)
+{
+    const double product = cycles * count;
+    const double error = std::fma(cycles, count, -product);
+    return (product - std::floor(product)) + error;
+}
+
+/**
+ * @brief Compute <c>exp(1i * angle)</c>, cheaply when @c angle is small.
+ *
+ * Angles up to 1/8 rad use truncated Taylor series, accurate to well under
+ * one ulp; larger angles fall back to std::polar().
+ */
+inline std::complex<double> ncoStep(double angle)
+{
+    if (!(std::fabs(angle) <= 0.125))
+    {
+        return std::polar(1.0, angle);
+    }
+    const double a2 = angle * angle;
+    const double c = 1.0 + a2 * (-1.0 / 2.0 + a2 * (1.0 / 24.0 +
+                     a2 * (-1.0 / 720.0 + a2 * (1.0 / 40320.0))));
+    const double s = angle * (1.0 + a2 * (-1.0 / 6.0 + a2 * (1.0 / 120.0 +
+                     a2 * (-1.0 / 5040.0 + a2 * (1.0 / 362880.0)))));
+    return std::complex<double>(c, s);
+}
+
+/**
+ * @brief Rotate samples by a carrier of constant frequency.
+ *
+ * Sample @c k is multiplied by <c>exp(1i * (phase + 2*pi*cycles*k))</c>.
+ * The rotator is generated by recursive complex multiplication in four
+ * independent lanes, so consecutive steps do not wait on one another, and
+ * each lane is resynchronized to its exact phase every kNcoResyncInterval
+ * samples. The exact phase is computed in cycles, with the integer part
+ * discarded, so it stays accurate for long blocks.
+ *
+ * @param phase The carrier phase of sample zero (in rad).
+ * @param cycles The carrier frequency (in cycles/sample).
+ * @param num_samples The number of samples.
+ * @param in_real The real parts of the input samples.
+ * @param in_imag The imaginary parts of the input samples; NULL for real
+ *        input.
+ * @param out_real The real parts of the rotated samples; may be @c in_real.
+ * @param out_imag The imaginary parts of the rotated samples; may be
+ *        @c in_imag.
+ *
+ * @return The carrier phase of the last sample (in rad), wrapped to
+ *         [0, 2*pi).
+ */
+inline double ncoRotateConstant(double phase, double cycles,
+                                size_t num_samples, const double *in_real,
+                                const double *in_imag, double *out_real,
+                                double *out_imag)
+{
+    const double two_pi = 6.28318530717958647692;
+    const size_t kLanes = 4;
+    const double lane_cycles = cycles * static_cast<double>(kLanes);
+    const std::complex<double> lane_step =
+        std::polar(1.0, two_pi * (lane_cycles - std::floor(lane_cycles)));
+
+    double rotator_real[kLanes];
+    double rotator_imag[kLanes];
+    for (size_t start = 0; start < num_samples; start += kNcoResyncInterval)
+    {
+        const size_t end = start + kNcoResyncInterval < num_samples ?
+                           start + kNcoResyncInterval : num_samples;
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            const std::complex<double> rotator = std::polar(
+                1.0, phase + two_pi * ncoFractionalCycles(
+                    cycles, static_cast<double>(start + lane)));
+            rotator_real[lane] = rotator.real();
+            rotator_imag[lane] = rotator.imag();
+        }
+
+        for (size_t base = start; base < end; base += kLanes)
+        {
+            const size_t num_lanes = end - base < kLanes ? end - base : kLanes;
+            for (size_t lane = 0; lane < num_lanes; ++lane)
+            {
+                const size_t idx = base + lane;
+                const double x_real = in_real[idx];
+                const double x_imag = in_imag == NULL ? 0.0 : in_imag[idx];
+                out_real[idx] = x_real * rotator_real[lane] -
+                                x_imag * rotator_imag[lane];
+                out_imag[idx] = x_real * rotator_imag[lane] +
+                                x_imag * rotator_real[lane];
+
+                const double r_real = rotator_real[lane];
+                const double r_imag = rotator_imag[lane];
+                rotator_real[lane] = r_real * lane_step.real() -
+                                     r_imag * lane_step.imag();
+                rotator_imag[lane] = r_real * lane_step.imag() +
+                                     r_imag * lane_step.real();
+            }
+        }
+    }
+
+    if (num_samples == 0)
+    {
+        return ncoWrapPhase(phase);
+    }
+    return ncoWrapPhase(phase + two_pi * ncoFractionalCycles(
+        cycles, static_cast<double>(num_samples - 1)));
+}
+
+/**
+ * @brief Rotate samples by a carrier whose frequency varies per sample.
+ *
+ * The carrier phase is the trapezoidal integral of @c frequency over
+ * @c times, exactly as <c>phase + 2*pi*cumtrapz(times, frequency)</c>. The
+ * phase is accumulated in double precision, and the rotator follows it by
+ * recursive complex multiplication, using the small-angle step of ncoStep(),
+ * resynchronized to the accumulated (and wrapped) phase every
+ * kNcoResyncInterval samples.
+ *
+ * @param phase The carrier phase of sample zero (in rad).
+ * @param frequency The carrier frequency at each sample (in Hz).
+ * @param times The time of each sample (in sec).
+ * @param num_samples The number of samples.
+ * @param in_real The real parts of the input samples.
+ * @param in_imag The imaginary parts of the input samples; NULL for real
+ *        input.
+ * @param out_real The real parts of the rotated samples; may be @c in_real.
+ * @param out_imag The imaginary parts of the rotated samples; may be
+ *        @c in_imag.
+ *
+ * @return The carrier phase of the last sample (in rad), wrapped to
+ *         [0, 2*pi).
+ */
+inline double ncoRotateIntegrated(double phase, const double *frequency,
+                                  const double *times, size_t num_samples,
+                                  const double *in_real,
+                                  const double *in_imag, double *out_real,
+                                  double *out_imag)
+{
+    const double pi = 3.14159265358979323846;
+    const double two_pi = 2.0 * pi;
+    std::complex<double> rotator;
+    for (size_t idx = 0; idx < num_samples; ++idx)
+    {
+        if (idx == 0)
+        {
+            rotator = std::polar(1.0, phase);
+        }
+        else
+        {
+            const double step = pi * (frequency[idx - 1] + frequency[idx]) *
+                                (times[idx] - times[idx - 1]);
+            phase += step;
+            if (idx % kNcoResyncInterval == 0)
+            {
+                // Wrapping the accumulated phase keeps its rounding error
+                // from growing with the elapsed phase.
+                phase = std::fmod(phase, two_pi);
+                rotator = std::polar(1.0, phase);
+            }
+            else
+            {
+                // Written out, as std::complex multiplication checks for
+                // infinities and NaNs.
+                const std::complex<double> delta = ncoStep(step);
+                rotator = std::complex<double>(
+                    rotator.real() * delta.real() -
+                    rotator.imag() * delta.imag(),
+                    rotator.real() * delta.imag() +
+                    rotator.imag() * delta.real());
+            }
+        }
+
+        const double x_real = in_real[idx];
+        const double x_imag = in_imag == NULL ? 0.0 : in_imag[idx];
+        out_real[idx] = x_real * rotator.real() - x_imag * rotator.imag();
+        out_imag[idx] = x_real * rotator.imag() + x_imag * rotator.real();
+    }
+    return ncoWrapPhase(phase);
+}
+
+/**
+ * @brief Rotate samples by a carrier whose phase is given per sample.
+ *
+ * Sample @c k is multiplied by <c>exp(1i * (phase + 2*pi*cycles[k]))</c>.
+ * The rotator is exact at sample zero and then follows the phase by
+ * recursive complex multiplication, using the small-angle step of ncoStep().
+ * Each step is the difference of consecutive phases less its nearest
+ * integer, so @c cycles may be reduced modulo one cycle anywhere, provided
+ * the carrier advances by less than half a cycle per sample. Callers
+ * rotating long blocks pass kNcoResyncInterval samples at a time, so that
+ * every such run starts from an exactly computed rotator.
+ *
+ * @param phase The carrier phase offset (in rad).
+ * @param cycles The carrier phase of each sample, less @c phase (in cycles).
+ * @param num_samples The number of samples.
+ * @param in_real The real parts of the input samples.
+ * @param in_imag The imaginary parts of the input samples; NULL for real
+ *        input.
+ * @param out_real The real parts of the rotated samples; may be @c in_real.
+ * @param out_imag The imaginary parts of the rotated samples; may be
+ *        @c in_imag.
+ *
+ * @return The carrier phase of the last sample (in rad), wrapped to
+ *         [0, 2*pi).
+ */
+inline double ncoRotatePhases(double phase, const double *cycles,
+                              size_t num_samples, const double *in_real,
+                              const double *in_imag, double *out_real,
+                              double *out_imag)
+{
+    const double two_pi = 6.28318530717958647692;
+    if (num_samples == 0)
+    {
+        return ncoWrapPhase(phase);
+    }
+    std::complex<double> rotator = std::polar(
+        1.0, phase + two_pi * (cycles[0] - std::floor(cycles[0])));
+    for (size_t idx = 0; idx < num_samples; ++idx)
+    {
+        if (idx > 0)
+        {
+            double step = cycles[idx] - cycles[idx - 1];
+            step -= std::floor(step + 0.5);
+
+            // Written out, as std::complex multiplication checks for
+            // infinities and NaNs.
+            const std::complex<double> delta = ncoStep(two_pi * step);
+            rotator = std::complex<double>(
+                rotator.real() * delta.real() - rotator.imag() * delta.imag(),
+                rotator.real() * delta.imag() + rotator.imag() * delta.real());
+        }
+
+        const double x_real = in_real[idx];
+        const double x_imag = in_imag == NULL ? 0.0 : in_imag[idx];
+        out_real[idx] = x_real * rotator.real() - x_imag * rotator.imag();
+        out_imag[idx] = x_real * rotator.imag() + x_imag * rotator.real();
+    }
+    const double last = cycles[num_samples - 1];
+    return ncoWrapPhase(phase + two_pi * (last - std::floor(last)));
+}
+
+/**
+ * @brief Rotate samples by a carrier whose phase is a spline of time, such
+ *        as the integral of a Doppler profile (see CompiledSpline::integral()).
+ *
+ * The phase spline is evaluated kNcoResyncInterval samples at a time into a
+ * small buffer, and each run is rotated by ncoRotatePhases(), so neither the
+ * frequency nor the phase of the whole block is formed, and the phase has no
+ * integration error to accumulate.
+ *
+ * @param phase The carrier phase offset (in rad).
+ * @param cycles The carrier phase, less @c phase, vs time (in cycles vs
+ *        sec). Its search cursor is advanced.
+ * @param times The time of each sample (in sec), ascending.
+ * @param num_samples The number of samples.
+ * @param in_real The real parts of the input samples.
+ * @param in_imag The imaginary parts of the input samples; NULL for real
+ *        input.
+ * @param out_real The real parts of the rotated samples; may be @c in_real.
+ * @param out_imag The imaginary parts of the rotated samples; may be
+ *        @c in_imag.
+ *
+ * @return The carrier phase of the last sample (in rad), wrapped to
+ *         [0, 2*pi).
+ */
+inline double ncoRotateSpline(double phase, CompiledSpline &cycles,
+                              const double *times, size_t num_samples,
+                              const double *in_real, const double *in_imag,
+                              double *out_real, double *out_imag)
+{
+    double run_cycles[kNcoResyncInterval];
+    double last_phase = ncoWrapPhase(phase);
+    for (size_t start = 0; start < num_samples; start += kNcoResyncInterval)
+    {
+        const size_t count = num_samples - start < kNcoResyncInterval ?
+                             num_samples - start : kNcoResyncInterval;
+        cycles.evaluate(times + start, count, run_cycles);
+        last_phase = ncoRotatePhases(
+            phase, run_cycles, count, in_real + start,
+            in_imag == NULL ? NULL : in_imag + start, out_real + start,
+            out_imag + start);
+    }
+    return last_phase;
+}
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_NCO_H_
@@ -0,0 +1,46 @@
+%%
+% @brief Rotates samples by a carrier using a numerically controlled
+%        oscillator (NCO).
+%
+% This is a single pass replacement for
+% <c>x .* exp(1i * carrier_phases)</c>. The rotator is generated by
+% recursive complex multiplication, resynchronized to its exact phase every
+% few hundred samples, rather than by evaluating exp() for every sample, and
+% no phase vector is formed.
+%
+% With a scalar @c cycles, the carrier has constant frequency, and sample
+% @c k (zero-indexed) is rotated by <c>phase + 2*pi*cycles*k</c>. With a
+% vector @c frequency and @c time_vector, the carrier phase is the
+% trapezoidal integral of the frequency, and sample @c k is rotated by
+% <c>phase + 2*pi*cumtrapz(time_vector(1:k+1), frequency(1:k+1))</c>.
+%
+% @note
+% This is a MATLAB stub to provide "help" support; this function is implemented
+% as a MEX function that must be compiled with make.m. See the library
+% documentation for more information about this process.
+%
+% @par Usage
+% [y, last_phase] = ncoRotate(x, phase, cycles)
+% [y, last_phase] = ncoRotate(x, phase, frequency, time_vector)
+%
+% @param[in] x The samples to rotate. Must be a real or complex column
+%            vector.
+% @param[in] phase The carrier phase of the first sample (in rad).
+% @param[in] cycles The constant carrier frequency (in cycles/sample).
+% @param[in] frequency The carrier frequency at each sample (in Hz). Must be
+%            a real column vector the length of @c x.
+% @param[in] time_vector The time of each sample (in sec). Must be a real
+%            column vector the length of @c x.
+%
+% @param[out] y The complex column vector of rotated samples.
+% @param[out] last_phase The carrier phase of the last sample (in rad),
+%             wrapped to [0, 2*pi).
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
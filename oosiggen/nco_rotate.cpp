@@ -0,0 +1,131 @@
+/**************************************************************************//**
+ * @brief      Carrier rotation of a block of samples by a numerically
+ *             controlled oscillator.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include "mex.h"
+
+#include "nco.h"
+
+namespace
+{
+
+/**
+ * @brief Check that an argument is a real column array of doubles.
+ */
+bool isRealColumn(const mxArray *array)
+{
+    return array != NULL && mxIsDouble(array) && !mxIsComplex(array) &&
+           mxGetNumberOfElements(array) == mxGetM(array);
+}
+
+/**
+ * @brief Check that an argument is a real scalar double.
+ */
+bool isRealScalar(const mxArray *array)
+{
+    return array != NULL && mxIsDouble(array) && !mxIsComplex(array) &&
+           mxGetNumberOfElements(array) == 1;
+}
+
+} // namespace
+
+/**
+ * @brief MEX gateway function.
+ *
+ * @par Usage
+ * [y, last_phase] = ncoRotate(x, phase, cycles)
+ * [y, last_phase] = ncoRotate(x, phase, frequency, time_vector)
+ *
+ * - <c>prhs[0]</c>: The samples to rotate, a real or complex column array.
+ * - <c>prhs[1]</c>: The carrier phase of the first sample (in rad).
+ * - <c>prhs[2]</c>: Either the constant carrier frequency (in
+ *   cycles/sample), or the carrier frequency at each sample (in Hz).
+ * - <c>prhs[3]</c>: The time of each sample (in sec), when the frequency is
+ *   given per sample.
+ * - <c>plhs[0]</c>: The complex column array of rotated samples.
+ * - <c>plhs[1]</c>: The carrier phase of the last sample (in rad), wrapped
+ *   to [0, 2*pi).
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 3 && nrhs != 4)
+    {
+        mexErrMsgTxt("Incorrect number of input arguments (three or four "
+                     "required).");
+    }
+    if (nlhs > 2)
+    {
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    const mxArray *x = prhs[0];
+    const size_t num_samples = mxGetM(x);
+    if (x == NULL || !mxIsDouble(x) ||
+        mxGetNumberOfElements(x) != num_samples)
+    {
+        mexErrMsgTxt("x must be a column array of doubles.");
+    }
+    if (!isRealScalar(prhs[1]))
+    {
+        mexErrMsgTxt("phase must be a real scalar double.");
+    }
+    const double phase = mxGetScalar(prhs[1]);
+
+    plhs[0] = mxCreateDoubleMatrix(static_cast<mwSize>(num_samples), 1,
+                                   mxCOMPLEX);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+    const double *in_real = static_cast<double*>(mxGetPr(x));
+    const double *in_imag = mxIsComplex(x) ?
+        static_cast<double*>(mxGetPi(x)) : NULL;
+    double *out_real = static_cast<double*>(mxGetPr(plhs[0]));
+    double *out_imag = static_cast<double*>(mxGetPi(plhs[0]));
+
+    double last_phase;
+    if (nrhs == 3)
+    {
+        if (!isRealScalar(prhs[2]))
+        {
+            mexErrMsgTxt("cycles must be a real scalar double.");
+        }
+        last_phase = oosiggen::ncoRotateConstant(
+            phase, mxGetScalar(prhs[2]), num_samples, in_real, in_imag,
+            out_real, out_imag);
+    }
+    else
+    {
+        if (!isRealColumn(prhs[2]) || mxGetM(prhs[2]) != num_samples)
+        {
+            mexErrMsgTxt("frequency must be a real column array of doubles "
+                         "the length of x.");
+        }
+        if (!isRealColumn(prhs[3]) || mxGetM(prhs[3]) != num_samples)
+        {
+            mexErrMsgTxt("time_vector must be a real column array of doubles "
+                         "the length of x.");
+        }
+        last_phase = oosiggen::ncoRotateIntegrated(
+            phase, static_cast<double*>(mxGetPr(prhs[2])),
+            static_cast<double*>(mxGetPr(prhs[3])), num_samples, in_real,
+            in_imag, out_real, out_imag);
+    }
+
+    if (nlhs > 1)
+    {
+        plhs[1] = mxCreateDoubleScalar(last_phase);
+    }
+}
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "mex.h"
 
+#include "non_uniform_resample_kernel.h"
+
 /**
  * @brief The standard MEX gateway function.
  *
@@ -76,74 +78,41 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     }
 
     // Create pointers to input data.
-    double *x = static_cast<double*>(mxGetPr(prhs[0]));
-    double *y_r = static_cast<double*>(mxGetPr(prhs[1]));
-    double *y_i = NULL;
-    if (is_complex)
-    {
-        y_i = static_cast<double*>(mxGetPi(prhs[1]));
-    }
-    
-    else 
-    {
-        y_i = (double*)mxMalloc(x_length * sizeof(double));
-    }
-    double *xi = static_cast<double*>(mxGetPr(prhs[2]));
+    const double *x = static_cast<double*>(mxGetPr(prhs[0]));
+    const double *xi = static_cast<double*>(mxGetPr(prhs[2]));
 
-    // Allocate output matrix, get real/imag pointers.
+    // Allocate output matrix.
     plhs[0] = mxCreateDoubleMatrix(static_cast<mwSize>(xi_length), 1,
                                    is_complex ? mxCOMPLEX : mxREAL);
     if (plhs[0] == NULL)
     {
         mexErrMsgTxt("Could not allocate output array.");
     }
-    double *yi_r = static_cast<double*>(mxGetPr(plhs[0]));
-    double *yi_i = NULL;
-    if (is_complex)
-    {
-        yi_i = static_cast<double*>(mxGetPi(plhs[0]));
-    }
-    else
-    {
-       yi_i = (double*)mxMalloc(xi_length * sizeof(double));
-    }   
 
-    // Resample.
-    size_t ref_idx = 0;
-    for (size_t resamp_idx = 0; resamp_idx < xi_length; ++resamp_idx)
+    // Resample, touching only the lanes that the data actually has.
+    if (!is_complex)
     {
-        // Find the sample to copy for the current output (corresponds to the
-        // largest x position value that is less than or equal to the current
-        // sample position xi).
-        //
-        // This loop will exit when the first point has been reached that fails
-        // the criteria, so the ref_idx will need to be decremented by one. If
-        // the loop exits with ref_idx = 0, that means no points meet the
-        // criteria.
-        while(ref_idx < x_length && x[ref_idx] <= xi[resamp_idx])
-        {
-            ref_idx++;
-        }
-
-        // If there is no reference sample behind the current resample point,
-        // set output to zero.
-        if (ref_idx == 0)
-        {
-            yi_r[resamp_idx] = 0.0;
-            yi_i[resamp_idx] = 0.0;
-            continue;
-        }
-
-        ref_idx--;
-
-        // Copy the sample into the output vector.
-        yi_r[resamp_idx] = y_r[ref_idx];
-        yi_i[resamp_idx] = y_i[ref_idx];
+        const oosiggen::RealSamples samples = {
+            static_cast<double*>(mxGetPr(prhs[1])),
+            static_cast<double*>(mxGetPr(plhs[0]))
+        };
+        oosiggen::resampleNearestLower(x, x_length, xi, xi_length, samples);
     }
-    if(!is_complex)
+    else
     {
-        mxFree(yi_i);
-        mxFree(y_i);
+#if MX_HAS_INTERLEAVED_COMPLEX
+        const oosiggen::InterleavedComplexSamples<mxComplexDouble> samples = {
+            mxGetComplexDoubles(prhs[1]),
+            mxGetComplexDoubles(plhs[0])
+        };
+#else
+        const oosiggen::SplitComplexSamples samples = {
+            static_cast<double*>(mxGetPr(prhs[1])),
+            static_cast<double*>(mxGetPi(prhs[1])),
+            static_cast<double*>(mxGetPr(plhs[0])),
+            static_cast<double*>(mxGetPi(plhs[0]))
+        };
+#endif
+        oosiggen::resampleNearestLower(x, x_length, xi, xi_length, samples);
     }
 }
-
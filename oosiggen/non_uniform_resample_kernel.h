@@ -0,0 +1,132 @@
+/**************************************************************************//**
+ * @brief      Nearest-lower-neighbor resampling kernel, shared by the
+ *             nonUniformResampleFast MEX function and native benchmarks.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_NON_UNIFORM_RESAMPLE_KERNEL_H_
+#define OOSIGGEN_NON_UNIFORM_RESAMPLE_KERNEL_H_
+
+#include <cstddef>
+
+namespace oosiggen
+{
+
+/**
+ * @brief Sample access for a real array of doubles.
+ */
+struct RealSamples
+{
+    const double *y;
+    double *yi;
+
+    void copy(size_t resamp_idx, size_t ref_idx) const
+    {
+        yi[resamp_idx] = y[ref_idx];
+    }
+    void zero(size_t resamp_idx) const
+    {
+        yi[resamp_idx] = 0.0;
+    }
+};
+
+/**
+ * @brief Sample access for an interleaved complex array, such as of
+ *        @c mxComplexDouble or <c>std::complex<double></c>.
+ */
+template <typename Complex>
+struct InterleavedComplexSamples
+{
+    const Complex *y;
+    Complex *yi;
+
+    void copy(size_t resamp_idx, size_t ref_idx) const
+    {
+        yi[resamp_idx] = y[ref_idx];
+    }
+    void zero(size_t resamp_idx) const
+    {
+        yi[resamp_idx] = Complex();
+    }
+};
+
+/**
+ * @brief Sample access for a split (separate real and imaginary) complex
+ *        array of doubles.
+ */
+struct SplitComplexSamples
+{
+    const double *y_r;
+    const double *y_i;
+    double *yi_r;
+    double *yi_i;
+
+    void copy(size_t resamp_idx, size_t ref_idx) const
+    {
+        yi_r[resamp_idx] = y_r[ref_idx];
+        yi_i[resamp_idx] = y_i[ref_idx];
+    }
+    void zero(size_t resamp_idx) const
+    {
+        yi_r[resamp_idx] = 0.0;
+        yi_i[resamp_idx] = 0.0;
+    }
+};
+
+/**
+ * @brief Resample a reference function at the desired locations, taking
+ *        the sample at the largest reference location at or before each one.
+ *
+ * @param x The reference x-axis locations, sorted ascending.
+ * @param x_length The number of elements of @c x.
+ * @param xi The desired x-axis locations, sorted ascending.
+ * @param xi_length The number of elements of @c xi.
+ * @param samples The reference and output sample arrays. Outputs before the
+ *        first reference location are zero.
+ */
+template <typename Samples>
+void resampleNearestLower(const double *x, size_t x_length, const double *xi,
+                          size_t xi_length, const Samples &samples)
+{
+    size_t ref_idx = 0;
+    for (size_t resamp_idx = 0; resamp_idx < xi_length; ++resamp_idx)
+    {
+        // Find the sample to copy for the current output (corresponds to the
+        // largest x position value that is less than or equal to the current
+        // sample position xi).
+        //
+        // This loop will exit when the first point has been reached that fails
+        // the criteria, so the ref_idx will need to be decremented by one. If
+        // the loop exits with ref_idx = 0, that means no points meet the
+        // criteria.
+        while (ref_idx < x_length && x[ref_idx] <= xi[resamp_idx])
+        {
+            ref_idx++;
+        }
+
+        // If there is no reference sample behind the current resample point,
+        // set output to zero.
+        if (ref_idx == 0)
+        {
+            samples.zero(resamp_idx);
+            continue;
+        }
+
+        // Copy the sample into the output vector.
+        samples.copy(resamp_idx, ref_idx - 1);
+    }
+}
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_NON_UNIFORM_RESAMPLE_KERNEL_H_
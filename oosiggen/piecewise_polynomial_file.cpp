@@ -0,0 +1,242 @@
+/**************************************************************************//**
+ * @brief      Memory-mapped reader for binary piecewise polynomial files.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include "piecewise_polynomial_file.h"
+
+#include <cstring> // For memcpy(), memset().
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace oosiggen
+{
+
+namespace
+{
+
+const size_t kNumBreaksOffset = 16; ///< Byte offset of the break count.
+const size_t kHeaderSize = 20; ///< Byte offset of the first break.
+
+} // namespace
+
+const uint32_t PiecewisePolynomialFile::kMagicWord;
+
+#if defined(_WIN32)
+
+PiecewisePolynomialFile::PiecewisePolynomialFile(const std::string &path)
+    : data_(NULL), size_(0), num_breaks_(0), order_(0)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) ||
+        file_size.QuadPart < static_cast<LONGLONG>(kHeaderSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Invalid piecewise polynomial file, too "
+                                 "short for its header: " + path);
+    }
+    size_ = static_cast<size_t>(file_size.QuadPart);
+
+    // The view keeps the file mapped once the handles are closed.
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0,
+                                        NULL);
+    if (mapping != NULL)
+    {
+        data_ = static_cast<const unsigned char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (data_ == NULL)
+    {
+        throw std::runtime_error("Could not map file: " + path);
+    }
+
+    try
+    {
+        validate(path);
+    }
+    catch (...)
+    {
+        UnmapViewOfFile(data_);
+        throw;
+    }
+}
+
+PiecewisePolynomialFile::~PiecewisePolynomialFile()
+{
+    UnmapViewOfFile(data_);
+}
+
+#else
+
+PiecewisePolynomialFile::PiecewisePolynomialFile(const std::string &path)
+    : data_(NULL), size_(0), num_breaks_(0), order_(0)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 ||
+        file_stat.st_size < static_cast<off_t>(kHeaderSize))
+    {
+        ::close(fd);
+        throw std::runtime_error("Invalid piecewise polynomial file, too "
+                                 "short for its header: " + path);
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+
+    // The mapping keeps the file open once the descriptor is closed.
+    void *const mapping = ::mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("Could not map file: " + path);
+    }
+    data_ = static_cast<const unsigned char*>(mapping);
+
+    try
+    {
+        validate(path);
+    }
+    catch (...)
+    {
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+        throw;
+    }
+}
+
+PiecewisePolynomialFile::~PiecewisePolynomialFile()
+{
+    ::munmap(const_cast<unsigned char*>(data_), size_);
+}
+
+#endif
+
+void PiecewisePolynomialFile::validate(const std::string &path)
+{
+    if (readValue<uint32_t>(0) != kMagicWord)
+    {
+        throw std::runtime_error("Invalid piecewise polynomial file, magic "
+                                 "word did not match: " + path);
+    }
+    const int32_t num_breaks = readValue<int32_t>(kNumBreaksOffset);
+    if (num_breaks < 2)
+    {
+        throw std::runtime_error("Invalid piecewise polynomial file, fewer "
+                                 "than two breaks: " + path);
+    }
+    num_breaks_ = static_cast<size_t>(num_breaks);
+
+    // Sizes are checked in 64 bits, so that no extent can wrap around.
+    const uint64_t lookup_table_start =
+        kHeaderSize + 8 * static_cast<uint64_t>(num_breaks_);
+    const uint64_t records_start =
+        lookup_table_start + 4 * static_cast<uint64_t>(numPolynomials());
+    if (records_start > size_)
+    {
+        throw std::runtime_error("Invalid piecewise polynomial file, "
+                                 "truncated breaks or lookup table: " + path);
+    }
+
+    // Each record must lie within the file, after the previous record.
+    uint64_t previous_end = records_start;
+    order_ = 1;
+    for (size_t poly_idx = 0; poly_idx < numPolynomials(); ++poly_idx)
+    {
+        const uint64_t offset = readValue<uint32_t>(
+            static_cast<size_t>(lookup_table_start) + 4 * poly_idx);
+        if (offset < previous_end || offset + 4 > size_)
+        {
+            throw std::runtime_error("Invalid piecewise polynomial file, "
+                                     "bad lookup table entry: " + path);
+        }
+        const int32_t count = readValue<int32_t>(static_cast<size_t>(offset));
+        const uint64_t end = offset + 4 + 8 * static_cast<uint64_t>(
+            count < 0 ? 0 : count);
+        if (count < 0 || end > size_)
+        {
+            throw std::runtime_error("Invalid piecewise polynomial file, "
+                                     "truncated polynomial: " + path);
+        }
+        if (static_cast<size_t>(count) > order_)
+        {
+            order_ = static_cast<size_t>(count);
+        }
+        previous_end = end;
+    }
+}
+
+template <typename T>
+T PiecewisePolynomialFile::readValue(size_t offset) const
+{
+    T value;
+    std::memcpy(&value, data_ + offset, sizeof(T));
+    return value;
+}
+
+void PiecewisePolynomialFile::readBreaks(double *breaks) const
+{
+    std::memcpy(breaks, data_ + kHeaderSize, num_breaks_ * sizeof(double));
+}
+
+void PiecewisePolynomialFile::readCoefficients(double *coefs,
+                                               size_t row_stride,
+                                               size_t column_stride) const
+{
+    const size_t lookup_table_start = kHeaderSize + 8 * num_breaks_;
+    for (size_t poly_idx = 0; poly_idx < numPolynomials(); ++poly_idx)
+    {
+        const size_t offset = readValue<uint32_t>(lookup_table_start +
+                                                  4 * poly_idx);
+        const size_t count = static_cast<size_t>(readValue<int32_t>(offset));
+        const size_t padding = order_ - count;
+        double *const row = coefs + poly_idx * row_stride;
+        const unsigned char *const values = data_ + offset + 4;
+        if (column_stride == 1)
+        {
+            std::memset(row, 0, padding * sizeof(double));
+            std::memcpy(row + padding, values, count * sizeof(double));
+            continue;
+        }
+        for (size_t col_idx = 0; col_idx < padding; ++col_idx)
+        {
+            row[col_idx * column_stride] = 0.0;
+        }
+        for (size_t coef_idx = 0; coef_idx < count; ++coef_idx)
+        {
+            std::memcpy(&row[(padding + coef_idx) * column_stride],
+                        values + coef_idx * sizeof(double), sizeof(double));
+        }
+    }
+}
+
+} // namespace oosiggen
@@ -0,0 +1,104 @@
+/**************************************************************************//**
+ * @brief      Memory-mapped reader for binary piecewise polynomial files.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_PIECEWISE_POLYNOMIAL_FILE_H_
+#define OOSIGGEN_PIECEWISE_POLYNOMIAL_FILE_H_
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+
+namespace oosiggen
+{
+
+/**
+ * @brief A read-only view of a binary piecewise polynomial (.mgpp) file.
+ *
+ * The file is little-endian and laid out as:
+ * - A 20-byte header: the magic word 0x70537750 (uint32), 12 bytes that are
+ *   not interpreted, and the number of breaks @c N (int32, at least two).
+ * - @c N breaks (double).
+ * - A lookup table of <c>N - 1</c> absolute byte offsets (uint32), one per
+ *   polynomial record.
+ * - The polynomial records, each a coefficient count @c K (int32) followed
+ *   by @c K coefficients (double), highest power first.
+ *
+ * The file is memory-mapped, and the header, lookup table and every record
+ * extent are validated when it is opened, so the accessors below cannot read
+ * outside the file. Polynomials with fewer coefficients than the highest
+ * count in the file are padded with leading zeros, as for a spline() struct.
+ */
+class PiecewisePolynomialFile
+{
+public:
+    static const uint32_t kMagicWord = 0x70537750u; ///< The file signature.
+
+    /**
+     * @brief Map and validate a file; throws std::runtime_error if it cannot
+     *        be mapped or is malformed.
+     */
+    explicit PiecewisePolynomialFile(const std::string &path);
+
+    ~PiecewisePolynomialFile();
+
+    size_t numBreaks() const { return num_breaks_; }
+    size_t numPolynomials() const { return num_breaks_ - 1; }
+
+    /**
+     * @brief The polynomial order: the highest coefficient count, and at
+     *        least one.
+     */
+    size_t order() const { return order_; }
+
+    /**
+     * @brief Copy the breaks to @c breaks, which holds numBreaks() values.
+     */
+    void readBreaks(double *breaks) const;
+
+    /**
+     * @brief Copy the numPolynomials() x order() coefficient matrix, with
+     *        element (i, j) stored at <c>coefs[i * row_stride + j *
+     *        column_stride]</c>.
+     *
+     * Use <c>(order(), 1)</c> for row-major storage, as in CompiledSpline,
+     * or <c>(1, numPolynomials())</c> for a MATLAB column-major matrix.
+     */
+    void readCoefficients(double *coefs, size_t row_stride,
+                          size_t column_stride) const;
+
+private:
+    PiecewisePolynomialFile(const PiecewisePolynomialFile&);
+    PiecewisePolynomialFile &operator=(const PiecewisePolynomialFile&);
+
+    /**
+     * @brief Check the header, lookup table and record extents.
+     */
+    void validate(const std::string &path);
+
+    /**
+     * @brief Read a (possibly unaligned) value at a byte offset.
+     */
+    template <typename T>
+    T readValue(size_t offset) const;
+
+    const unsigned char *data_; ///< The mapped file contents.
+    size_t size_; ///< The file size (in bytes).
+    size_t num_breaks_; ///< The number of breaks.
+    size_t order_; ///< The highest coefficient count.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_PIECEWISE_POLYNOMIAL_FILE_H_
@@ -0,0 +1,282 @@
+/**************************************************************************//**
+ * @brief      Stateful decimating FIR filter for signal streams that are
+ *             generated in chunks.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_POLYPHASE_DECIMATOR_H_
+#define OOSIGGEN_POLYPHASE_DECIMATOR_H_
+
+#include <algorithm> // For copy(), fill().
+#include <cstddef>
+#include <stdexcept>
+
+#include "aligned_buffer.h"
+
+// Vectorized kernels require AVX2 with FMA (MSVC's /arch:AVX2 implies FMA
+// but does not define __FMA__) or AVX-512.
+#if defined(__AVX512F__) || \
+    (defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER)))
+#define OOSIGGEN_DECIMATOR_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace oosiggen
+{
+
+/**
+ * @brief An FIR filter followed by downsampling, evaluated only at the
+ *        retained outputs.
+ *
+ * The output is that of <c>y = filter(b, 1, x)</c> followed by
+ * <c>y(1:factor:end)</c> over the whole stream, with a zero initial state.
+ * Each retained output is the inner product of the taps with the most recent
+ * inputs, which is the sum of the polyphase branch outputs of a polyphase
+ * decimator; the other <c>factor - 1</c> of every @c factor outputs are never
+ * computed. The filter history and the position within the decimation cycle
+ * carry over from one call to the next, so chunks of any length give the
+ * same result as a single call.
+ *
+ * Real and complex input share the taps; once any complex input has been
+ * processed, the stream is complex.
+ */
+class PolyphaseDecimator
+{
+public:
+    /**
+     * @brief Create a decimator with a zero initial state.
+     *
+     * @param taps The FIR filter coefficients, as for MATLAB's filter().
+     * @param num_taps The number of coefficients; must be at least one.
+     * @param factor The downsampling factor; must be at least one.
+     */
+    PolyphaseDecimator(const double *taps, size_t num_taps, size_t factor)
+        : num_taps_(num_taps), factor_(factor), skip_(0),
+          is_complex_(false)
+    {
+        if (num_taps_ == 0)
+        {
+            throw std::invalid_argument("At least one tap is required.");
+        }
+        if (factor_ == 0)
+        {
+            throw std::invalid_argument("factor must be at least one.");
+        }
+
+        // The taps are stored reversed, so each output is a dot product with
+        // a contiguous window of the input.
+        taps_.resize(num_taps_);
+        for (size_t idx = 0; idx < num_taps_; ++idx)
+        {
+            taps_[idx] = taps[num_taps_ - 1 - idx];
+        }
+        work_real_.resize(num_taps_ - 1 + kBlockSize);
+        work_imag_.resize(num_taps_ - 1 + kBlockSize);
+        // The imaginary history stays zero until the first complex input.
+        work_real_.zero();
+        work_imag_.zero();
+    }
+
+    size_t numTaps() const { return num_taps_; }
+    size_t factor() const { return factor_; }
+    bool isComplex() const { return is_complex_; }
+
+    /**
+     * @brief The position (zero-indexed) within the next input block of the
+     *        first input sample that produces an output.
+     */
+    size_t nextOutputOffset() const { return skip_; }
+
+    /**
+     * @brief The number of outputs that processing @c num_inputs more input
+     *        samples will produce.
+     */
+    size_t numOutputs(size_t num_inputs) const
+    {
+        return num_inputs > skip_ ? (num_inputs - skip_ - 1) / factor_ + 1 : 0;
+    }
+
+    /**
+     * @brief Filter and decimate a block of input samples.
+     *
+     * The input may be in single or double precision; it is converted as it
+     * is appended to the filter history, and filtered in double precision.
+     *
+     * @param in_real The real parts of the input samples.
+     * @param in_imag The imaginary parts of the input samples; NULL for real
+     *        input.
+     * @param num_inputs The number of input samples.
+     * @param out_real The real parts of the outputs; numOutputs() elements.
+     * @param out_imag The imaginary parts of the outputs; ignored (and may be
+     *        NULL) while the stream is real.
+     *
+     * @return The number of outputs written.
+     */
+    template <typename T>
+    size_t process(const T *in_real, const T *in_imag, size_t num_inputs,
+                   double *out_real, double *out_imag)
+    {
+        if (in_imag != NULL)
+        {
+            is_complex_ = true;
+        }
+
+        const size_t history = num_taps_ - 1;
+        size_t num_outputs = 0;
+        for (size_t start = 0; start < num_inputs; start += kBlockSize)
+        {
+            const size_t block_size = num_inputs - start < kBlockSize ?
+                                      num_inputs - start : kBlockSize;
+
+            // Append the block to the filter history.
+            std::copy(in_real + start, in_real + start + block_size,
+                      work_real_.data() + history);
+            if (in_imag != NULL)
+            {
+                std::copy(in_imag + start, in_imag + start + block_size,
+                          work_imag_.data() + history);
+            }
+            else if (is_complex_)
+            {
+                std::fill(work_imag_.data() + history,
+                          work_imag_.data() + history + block_size, 0.0);
+            }
+
+            // Evaluate the retained outputs. The output for input j uses
+            // the window of num_taps_ work samples starting at j.
+            size_t idx = skip_;
+            if (is_complex_)
+            {
+                for (; idx < block_size; idx += factor_)
+                {
+                    dotComplex(work_real_.data() + idx,
+                               work_imag_.data() + idx,
+                               out_real[num_outputs], out_imag[num_outputs]);
+                    ++num_outputs;
+                }
+            }
+            else
+            {
+                for (; idx < block_size; idx += factor_)
+                {
+                    out_real[num_outputs++] = dot(work_real_.data() + idx);
+                }
+            }
+            skip_ = idx - block_size;
+
+            // Keep the most recent inputs as the history for the next block.
+            std::copy(work_real_.data() + block_size,
+                      work_real_.data() + block_size + history,
+                      work_real_.data());
+            if (is_complex_)
+            {
+                std::copy(work_imag_.data() + block_size,
+                          work_imag_.data() + block_size + history,
+                          work_imag_.data());
+            }
+        }
+        return num_outputs;
+    }
+
+private:
+    /// The number of input samples filtered at a time.
+    static const size_t kBlockSize = 4096;
+
+    PolyphaseDecimator(const PolyphaseDecimator&);
+    PolyphaseDecimator &operator=(const PolyphaseDecimator&);
+
+    /**
+     * @brief The dot product of the (reversed) taps with a window of real
+     *        samples.
+     */
+    double dot(const double *x) const
+    {
+        const double *taps = taps_.data();
+        size_t idx = 0;
+        double sum = 0.0;
+#if defined(OOSIGGEN_DECIMATOR_SIMD)
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        for (; idx + 8 <= num_taps_; idx += 8)
+        {
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(&taps[idx]),
+                                   _mm256_loadu_pd(&x[idx]), acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(&taps[idx + 4]),
+                                   _mm256_loadu_pd(&x[idx + 4]), acc1);
+        }
+        sum = horizontalSum(_mm256_add_pd(acc0, acc1));
+#endif
+        for (; idx < num_taps_; ++idx)
+        {
+            sum += taps[idx] * x[idx];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief The dot product of the (reversed) taps with a window of complex
+     *        samples.
+     */
+    void dotComplex(const double *x_real, const double *x_imag,
+                    double &sum_real, double &sum_imag) const
+    {
+        const double *taps = taps_.data();
+        size_t idx = 0;
+        sum_real = 0.0;
+        sum_imag = 0.0;
+#if defined(OOSIGGEN_DECIMATOR_SIMD)
+        __m256d acc_real = _mm256_setzero_pd();
+        __m256d acc_imag = _mm256_setzero_pd();
+        for (; idx + 4 <= num_taps_; idx += 4)
+        {
+            const __m256d tap = _mm256_loadu_pd(&taps[idx]);
+            acc_real = _mm256_fmadd_pd(tap, _mm256_loadu_pd(&x_real[idx]),
+                                       acc_real);
+            acc_imag = _mm256_fmadd_pd(tap, _mm256_loadu_pd(&x_imag[idx]),
+                                       acc_imag);
+        }
+        sum_real = horizontalSum(acc_real);
+        sum_imag = horizontalSum(acc_imag);
+#endif
+        for (; idx < num_taps_; ++idx)
+        {
+            sum_real += taps[idx] * x_real[idx];
+            sum_imag += taps[idx] * x_imag[idx];
+        }
+    }
+
+#if defined(OOSIGGEN_DECIMATOR_SIMD)
+    static double horizontalSum(__m256d v)
+    {
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v),
+                                        _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+#endif
+
+    size_t num_taps_; ///< The number of filter coefficients.
+    size_t factor_; ///< The downsampling factor.
+    /// Input samples to skip, at the start of the next block, before the
+    /// next output.
+    size_t skip_;
+    bool is_complex_; ///< True once any complex input has been processed.
+    AlignedBuffer<double> taps_; ///< The filter coefficients, reversed.
+    /// The filter history (num_taps_ - 1 samples) followed by the current
+    /// input block.
+    AlignedBuffer<double> work_real_;
+    AlignedBuffer<double> work_imag_;
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_POLYPHASE_DECIMATOR_H_
@@ -0,0 +1,220 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to stateful decimating FIR filters.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <utility> // For move().
+
+#include "mex.h"
+
+#include "mex_handle_registry.h"
+#include "polyphase_decimator.h"
+
+namespace
+{
+
+/**
+ * @brief The decimators owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::PolyphaseDecimator> &decimators()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::PolyphaseDecimator>
+        registry("polyphaseDecimatorCore");
+    return registry;
+}
+
+/**
+ * @brief Free all decimators when the MEX file is cleared.
+ */
+void freeAllDecimators()
+{
+    decimators().clear();
+}
+
+/**
+ * @brief Create a decimator with a zero initial state.
+ */
+void createDecimator(int nlhs, mxArray *plhs[], int nrhs,
+                     const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("create requires b and factor.");
+    }
+    if (prhs[1] == NULL || !mxIsDouble(prhs[1]) || mxIsComplex(prhs[1]) ||
+        mxIsEmpty(prhs[1]))
+    {
+        mexErrMsgTxt("b must be a non-empty real array of doubles.");
+    }
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        mxGetNumberOfElements(prhs[2]) != 1 || !(mxGetScalar(prhs[2]) >= 1.0))
+    {
+        mexErrMsgTxt("factor must be a positive real scalar double.");
+    }
+
+    std::unique_ptr<oosiggen::PolyphaseDecimator> decimator(
+        new oosiggen::PolyphaseDecimator(
+            static_cast<double*>(mxGetPr(prhs[1])),
+            mxGetNumberOfElements(prhs[1]),
+            static_cast<size_t>(mxGetScalar(prhs[2]))));
+    plhs[0] = decimators().add(std::move(decimator));
+}
+
+/**
+ * @brief Filter and decimate a block of samples.
+ */
+void processSamples(int nlhs, mxArray *plhs[], int nrhs,
+                    const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("process requires a handle and x.");
+    }
+    oosiggen::PolyphaseDecimator &decimator = decimators().get(prhs[1]);
+
+    const size_t x_length = mxGetM(prhs[2]);
+    const bool is_single = prhs[2] != NULL && mxIsSingle(prhs[2]);
+    if (prhs[2] == NULL || !(mxIsDouble(prhs[2]) || is_single) ||
+        (mxGetNumberOfElements(prhs[2]) != x_length))
+    {
+        mexErrMsgTxt("x must be a column array of doubles or singles.");
+    }
+
+    // The offset is that of the first retained input of this block.
+    const size_t offset = decimator.nextOutputOffset();
+    const size_t y_length = decimator.numOutputs(x_length);
+    const bool is_complex = mxIsComplex(prhs[2]) || decimator.isComplex();
+    plhs[0] = mxCreateDoubleMatrix(static_cast<mwSize>(y_length), 1,
+                                   is_complex ? mxCOMPLEX : mxREAL);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+    double *y_r = static_cast<double*>(mxGetPr(plhs[0]));
+    double *y_i = NULL;
+    if (is_complex)
+    {
+        y_i = static_cast<double*>(mxGetPi(plhs[0]));
+    }
+
+    if (is_single)
+    {
+        const float *x_i = mxIsComplex(prhs[2]) ?
+            static_cast<float*>(mxGetImagData(prhs[2])) : NULL;
+        decimator.process(static_cast<float*>(mxGetData(prhs[2])), x_i,
+                          x_length, y_r, y_i);
+    }
+    else
+    {
+        const double *x_i = mxIsComplex(prhs[2]) ?
+            static_cast<double*>(mxGetPi(prhs[2])) : NULL;
+        decimator.process(static_cast<double*>(mxGetPr(prhs[2])), x_i,
+                          x_length, y_r, y_i);
+    }
+
+    if (nlhs > 1)
+    {
+        plhs[1] = mxCreateDoubleScalar(static_cast<double>(offset));
+    }
+}
+
+/**
+ * @brief Free one or more decimators.
+ */
+void freeDecimators(int nlhs, mxArray *plhs[], int nrhs,
+                    const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    decimators().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = polyphaseDecimatorCore('create', b, factor)
+ * [y, offset] = polyphaseDecimatorCore('process', h, x)
+ * polyphaseDecimatorCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>prhs[1]</c>: The FIR filter coefficients, @c b, as for filter().
+ * - <c>prhs[2]</c>: The downsampling factor.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to a new decimator, with a zero
+ *   initial state.
+ *
+ * For @c 'process':
+ * - <c>prhs[1]</c>: The decimator handle.
+ * - <c>prhs[2]</c>: The next block of input samples, @c x. Must be a real or
+ *   complex column vector of doubles or singles; the output is double either
+ *   way.
+ * - <c>plhs[0]</c>: The filtered and decimated output, @c y; complex if any
+ *   complex input has been processed.
+ * - <c>plhs[1]</c>: The zero-indexed position within @c x of the input
+ *   sample that produced <c>y(1)</c>.
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllDecimators);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createDecimator(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "process") == 0)
+    {
+        processSamples(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeDecimators(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
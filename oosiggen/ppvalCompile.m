@@ -0,0 +1,35 @@
+function h = ppvalCompile(pp)
+%%
+% @brief Compile a piecewise polynomial for repeated fast evaluation.
+%
+% The breaks and coefficients are validated and copied once into native
+% storage laid out for fast evaluation, and a handle to that copy is returned.
+% Evaluating through the handle with ppvalEval() avoids re-validating and
+% re-reading the struct on every call, and resumes the bin search from where
+% the previous evaluation stopped, which makes consecutive chunks of an
+% ascending time axis cheap. Splines compiled from identical breaks share one
+% copy of them.
+%
+% @note
+% Compiled splines hold native memory until they are released with
+% ppvalFree(). This is a MATLAB wrapper around a core MEX function, which must
+% be compiled with make.m.
+%
+% @param[in] pp The piecewise polynomial struct, obtained via the spline() or
+%            interp1() functions. The breaks must be sorted ascending.
+%
+% @param[out] h A uint64 handle to the compiled spline.
+%
+% @par Usage
+% h = ppvalCompile(pp)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No. 
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer 
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+h = ppvalSplineCore('compile', pp.breaks, pp.coefs);
@@ -0,0 +1,34 @@
+function varargout = ppvalEval(h, xx)
+%%
+% @brief Evaluate one or more compiled piecewise polynomials.
+%
+% When several handles are given, all splines are evaluated in a single pass
+% over @c xx, and splines that were compiled from identical breaks share the
+% bin search (see ppvalFastMulti()).
+%
+% @note
+% This is a MATLAB wrapper around a core MEX function, which must be compiled
+% with make.m.
+%
+% @param[in] h A uint64 handle, or array of handles, from ppvalCompile().
+% @param[in] xx The x-axis locations to evaluate values at. Must be a column
+%            vector or scalar.
+%
+% @param[out] varargout The values of each spline evaluated at the @c xx
+%             locations, in the same order as @c h. Each will be the same
+%             size as @c xx.
+%
+% @par Usage
+% v = ppvalEval(h, xx)
+% [v_1, ..., v_N] = ppvalEval([h_1, ..., h_N], xx)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No. 
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer 
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+[varargout{1:max(nargout, 1)}] = ppvalSplineCore('eval', h, xx);
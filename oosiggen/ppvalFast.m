@@ -5,8 +5,10 @@ function v = ppvalFast(pp, xx)
 %
 % ppval() creates a histogram with histc() as part of its implementation, which
 % can lead to very large memory allocations. This is a wrapper around a MEX
-% function that makes use of a binary search to locate the appropriate bin
-% (polynomial coefficient set).
+% function that makes use of a galloping search, starting from the bin of the
+% previous x-axis location, to locate the appropriate bin (polynomial
+% coefficient set). This is amortized constant time per location when @c xx
+% is sorted ascending, as time axes are.
 %
 % @note
 % This is a MATLAB wrapper around a core MEX function, which must must be
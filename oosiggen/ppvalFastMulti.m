@@ -0,0 +1,39 @@
+function varargout = ppvalFastMulti(pps, xx)
+%%
+% @brief Evaluate several piecewise polynomials at the same x-axis locations
+%        in a single pass.
+%
+% This is equivalent to calling ppvalFast() once for each element of @c pps,
+% but the x-axis locations are only traversed once, and piecewise polynomials
+% that share identical breaks (e.g. profiles generated on a common time grid)
+% share a single bin search per location.
+%
+% @note
+% This is a MATLAB wrapper around a core MEX function, which must must be
+% compiled with make.m. See the library documentation for more information
+% about this process.
+%
+% @param[in] pps A cell array of piecewise polynomial structs, obtained via
+%            the spline() or interp1() functions.
+% @param[in] xx The x-axis locations to evaluate values at. Must be a column
+%            vector or scalar.
+%
+% @param[out] varargout The values of each spline evaluated at the @c xx
+%             locations, in the same order as @c pps. Each will be the same
+%             size as @c xx.
+%
+% @par Usage
+% [v_1, ..., v_N] = ppvalFastMulti({pp_1, ..., pp_N}, xx)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No. 
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer 
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+breaks = cellfun(@(pp) pp.breaks, pps, 'UniformOutput', false);
+coefs = cellfun(@(pp) pp.coefs, pps, 'UniformOutput', false);
+[varargout{1:max(nargout, 1)}] = ppvalFastMultiCore(breaks, coefs, xx);
@@ -0,0 +1,24 @@
+function ppvalFree(h)
+%%
+% @brief Release compiled piecewise polynomials.
+%
+% @note
+% This is a MATLAB wrapper around a core MEX function, which must be compiled
+% with make.m.
+%
+% @param[in] h A uint64 handle, or array of handles, from ppvalCompile(). The
+%            handles are invalid after this call.
+%
+% @par Usage
+% ppvalFree(h)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No. 
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer 
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+ppvalSplineCore('free', h);
@@ -0,0 +1,40 @@
+function h_integral = ppvalIntegrate(h, period)
+%%
+% @brief Compile the antiderivative of a compiled piecewise polynomial.
+%
+% Each piece is integrated exactly, giving a piecewise polynomial of one
+% order higher on the same breaks, zero at the first break; integrating a
+% Doppler profile (in Hz vs sec) gives the carrier phase (in cycles vs sec).
+% Given a @c period, the constant accumulated at the start of each piece is
+% reduced modulo the period, so the values keep their precision over
+% arbitrarily long profiles, but are then only meaningful modulo the period
+% (see ppvalRotate()).
+%
+% @note
+% The antiderivative holds native memory until it is released with
+% ppvalFree(). This is a MATLAB wrapper around a core MEX function, which must
+% be compiled with make.m.
+%
+% @param[in] h A uint64 handle from ppvalCompile().
+% @param[in] period The period to reduce the antiderivative by, or zero to
+%            keep it whole. Defaults to zero.
+%
+% @param[out] h_integral A uint64 handle to the compiled antiderivative.
+%
+% @par Usage
+% h_integral = ppvalIntegrate(h)
+% h_integral = ppvalIntegrate(h, period)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No. 
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer 
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+if nargin < 2
+    period = 0;
+end
+h_integral = ppvalSplineCore('integrate', h, double(period));
@@ -0,0 +1,33 @@
+function h = ppvalLoad(filename)
+%%
+% @brief Load a binary piecewise polynomial (.mgpp) file directly into a
+%        compiled spline.
+%
+% The file is memory-mapped and validated, and its coefficients are copied
+% straight into the native storage used by ppvalEval(), with no intermediate
+% MATLAB struct. The result is the same as
+% <c>ppvalCompile(readPiecewisePolynomialBinary(filename))</c>.
+%
+% @note
+% Compiled splines hold native memory until they are released with
+% ppvalFree(). This is a MATLAB wrapper around a core MEX function, which must
+% be compiled with make.m.
+%
+% @param[in] filename The path of the binary piecewise polynomial file. The
+%            breaks must be sorted ascending.
+%
+% @param[out] h A uint64 handle to the compiled spline.
+%
+% @par Usage
+% h = ppvalLoad(filename)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+h = ppvalSplineCore('load', char(filename));
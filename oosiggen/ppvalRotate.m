@@ -0,0 +1,39 @@
+function [y, last_phase] = ppvalRotate(h, x, phase, xx)
+%%
+% @brief Rotate samples by a carrier whose phase is a compiled piecewise
+%        polynomial, such as the antiderivative of a Doppler profile (see
+%        ppvalIntegrate()).
+%
+% Sample @c k is multiplied by <c>exp(1i * (phase + 2*pi*v(k)))</c>, where
+% @c v is the spline evaluated at @c xx (in cycles). The spline is evaluated
+% and applied in short runs in native code, so no vector of the phase or
+% frequency is formed, and the bin search resumes where the previous call
+% stopped.
+%
+% @note
+% This is a MATLAB wrapper around a core MEX function, which must be compiled
+% with make.m.
+%
+% @param[in] h A uint64 handle to the carrier phase spline (in cycles).
+% @param[in] x The samples to rotate, a real or complex column vector.
+% @param[in] phase The carrier phase offset (in rad).
+% @param[in] xx The ascending x-axis location of each sample, a column
+%            vector the length of @c x.
+%
+% @param[out] y The rotated samples, a complex column vector.
+% @param[out] last_phase The carrier phase of the last sample (in rad),
+%             wrapped to [0, 2*pi).
+%
+% @par Usage
+% [y, last_phase] = ppvalRotate(h, x, phase, xx)
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No. 
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer 
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
+
+[y, last_phase] = ppvalSplineCore('rotate', h, x, phase, xx);
@@ -13,10 +13,10 @@
  * Software and Noncommercial Computer Software Documentation Clause
  * (DFARS) 252.227-7014 (JUN 1995)
  *****************************************************************************/
-#include <algorithm> // For lower_bound().
-
 #include "mex.h"
 
+#include "ppval_kernel.h"
+
 /**
  * @brief The standard MEX gateway function.
  *
@@ -67,6 +67,11 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
         mexErrMsgTxt("coefs must be a real matrix of doubles.");
     }
 
+    if (num_breaks < 2)
+    {
+        mexErrMsgTxt("breaks must contain at least two fenceposts.");
+    }
+
     if (num_polynomials != num_breaks - 1)
     {
         mexErrMsgTxt("Number of polynomials is not consistent with number "
@@ -93,37 +98,6 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     }
     double *v = static_cast<double*>(mxGetPr(plhs[0]));
 
-    // Evaluate each input value.
-    for (size_t out_idx = 0; out_idx < num_values; ++out_idx)
-    {
-        const double x = xx[out_idx];
-
-        // Find the correct bin using binary search algorithm.
-        size_t lookup_idx;
-        if (x <= breaks[0])
-        {
-            // Value is before first bin, so use the first bin.
-            lookup_idx = 0;
-        }
-        else if (x > breaks[num_breaks - 1])
-        {
-            // Value is after last bin, so use last bin.
-            lookup_idx = num_breaks - 1;
-        }
-        else
-        {
-            double *it = std::lower_bound(&breaks[0], &breaks[num_breaks], x);
-            lookup_idx = it - &breaks[0] - 1;
-        }
-
-        // Evaluate polynomial.
-        const double delta_x = x - breaks[lookup_idx];
-        v[out_idx] = coefs[lookup_idx];
-        for (size_t coef_idx = 1; coef_idx < order; ++coef_idx)
-        {
-            v[out_idx] = delta_x * v[out_idx] +
-                         coefs[lookup_idx + coef_idx * num_polynomials];
-        }
-    }
+    oosiggen::evaluateColumnMajorPiecewisePolynomial(breaks, num_breaks, coefs,
+                                                     order, xx, num_values, v);
 }
-
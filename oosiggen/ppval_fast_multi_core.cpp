@@ -0,0 +1,246 @@
+/**************************************************************************//**
+ * @brief      Batched evaluation of several piecewise polynomials at a common
+ *             set of x-axis locations.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <algorithm> // For min().
+#include <cstring> // For memcmp().
+#include <vector>
+
+#include "mex.h"
+
+#include "ppval_kernel.h"
+
+namespace
+{
+
+/**
+ * @brief A single piecewise polynomial to evaluate, and its output location.
+ */
+struct SplineView
+{
+    oosiggen::CoefficientLayout layout; ///< Coefficient storage.
+    std::vector<double> row_major_coefs; ///< Transposed copy, if used.
+    double *v; ///< Output vector.
+};
+
+/**
+ * @brief A set of piecewise polynomials that share the same fenceposts, and
+ *        therefore the same bin for any x-axis location.
+ */
+struct BreaksGroup
+{
+    const double *breaks; ///< The shared fencepost locations.
+    size_t num_breaks; ///< The number of fenceposts.
+    std::vector<SplineView> splines; ///< The member piecewise polynomials.
+    size_t cursor; ///< The bin found for the previous x-axis location.
+};
+
+/**
+ * @brief Check whether two fencepost vectors are identical.
+ *
+ * MATLAB shares the underlying data of copied arrays, so splines fitted on the
+ * same grid usually compare equal by pointer; otherwise the contents are
+ * compared.
+ */
+bool sameBreaks(const double *a, size_t num_a, const double *b, size_t num_b)
+{
+    if (num_a != num_b)
+    {
+        return false;
+    }
+    return a == b || std::memcmp(a, b, num_a * sizeof(double)) == 0;
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * [v_1, ..., v_N] = ppvalFastMultiCore(breaks, coefs, xx)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: A cell array of @c N fencepost vectors, @c breaks. Each
+ *   element has the same requirements as the @c breaks input of
+ *   ppvalFastCore.
+ * - <c>prhs[1]</c>: A cell array of @c N coefficient matrices, @c coefs. Each
+ *   element has the same requirements as the @c coefs input of ppvalFastCore
+ *   and must be consistent with the matching element of @c breaks.
+ * - <c>prhs[2]</c>: The input vector, @c xx, which represents the desired
+ *   x-axis locations to evaluate all of the piecewise polynomials at.
+ *
+ * - <c>plhs[0..N-1]</c>: The output vectors, @c v_1 through @c v_N, which
+ *   contain the values of each piecewise polynomial evaluated at @c xx. Each
+ *   will be the same size as @c xx.
+ *
+ * Piecewise polynomials that share identical fenceposts are grouped so that
+ * the bin search for each x-axis location is performed once per group rather
+ * than once per polynomial. All groups are evaluated in a single pass over
+ * @c xx.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    // Input argument checks.
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("Incorrect number of input arguments (three required).");
+    }
+
+    if (prhs[0] == NULL || !mxIsCell(prhs[0]) ||
+        prhs[1] == NULL || !mxIsCell(prhs[1]))
+    {
+        mexErrMsgTxt("breaks and coefs must be cell arrays.");
+    }
+    const size_t num_splines = mxGetNumberOfElements(prhs[0]);
+    if (num_splines == 0)
+    {
+        mexErrMsgTxt("breaks and coefs must not be empty.");
+    }
+    if (mxGetNumberOfElements(prhs[1]) != num_splines)
+    {
+        mexErrMsgTxt("breaks and coefs must have the same number of "
+                     "elements.");
+    }
+    if (static_cast<size_t>(nlhs) > num_splines ||
+        (nlhs == 0 && num_splines > 1))
+    {
+        mexErrMsgTxt("Number of output arguments must not exceed the number "
+                     "of piecewise polynomials.");
+    }
+
+    const size_t num_values = mxGetM(prhs[2]);
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        (mxGetNumberOfElements(prhs[2]) != num_values))
+    {
+        mexErrMsgTxt("xx must be a real column array of doubles.");
+    }
+    const double *xx = static_cast<double*>(mxGetPr(prhs[2]));
+
+    // Only the polynomials that have a requested output are evaluated.
+    const size_t num_outputs = nlhs > 0 ? static_cast<size_t>(nlhs) : 1;
+
+    // Validate each spline, allocate its output and sort it into a group of
+    // splines sharing the same fenceposts.
+    std::vector<BreaksGroup> groups;
+    for (size_t spline_idx = 0; spline_idx < num_outputs; ++spline_idx)
+    {
+        const mxArray *breaks_array = mxGetCell(prhs[0], spline_idx);
+        const mxArray *coefs_array = mxGetCell(prhs[1], spline_idx);
+
+        if (breaks_array == NULL || !mxIsDouble(breaks_array) ||
+            mxIsComplex(breaks_array) ||
+            (mxGetNumberOfElements(breaks_array) != mxGetN(breaks_array)))
+        {
+            mexErrMsgTxt("breaks must be a real row array of doubles.");
+        }
+        const size_t num_breaks = mxGetN(breaks_array);
+
+        if (coefs_array == NULL || !mxIsDouble(coefs_array) ||
+            mxIsComplex(coefs_array))
+        {
+            mexErrMsgTxt("coefs must be a real matrix of doubles.");
+        }
+        const size_t num_polynomials = mxGetM(coefs_array);
+        const size_t order = mxGetN(coefs_array);
+        if (order == 0 ||
+            mxGetNumberOfElements(coefs_array) != num_polynomials * order)
+        {
+            mexErrMsgTxt("coefs must be a real matrix of doubles with at "
+                         "least one column.");
+        }
+
+        if (num_breaks < 2)
+        {
+            mexErrMsgTxt("breaks must contain at least two fenceposts.");
+        }
+        if (num_polynomials != num_breaks - 1)
+        {
+            mexErrMsgTxt("Number of polynomials is not consistent with "
+                         "number of breaks.");
+        }
+
+        plhs[spline_idx] = mxCreateDoubleMatrix(
+            static_cast<mwSize>(num_values), 1, mxREAL);
+        if (plhs[spline_idx] == NULL)
+        {
+            mexErrMsgTxt("Could not allocate output array.");
+        }
+
+        const double *coefs = static_cast<double*>(mxGetPr(coefs_array));
+        const double *breaks = static_cast<double*>(mxGetPr(breaks_array));
+        size_t group_idx = 0;
+        while (group_idx < groups.size() &&
+               !sameBreaks(groups[group_idx].breaks,
+                           groups[group_idx].num_breaks,
+                           breaks, num_breaks))
+        {
+            ++group_idx;
+        }
+        if (group_idx == groups.size())
+        {
+            groups.push_back(BreaksGroup());
+            groups[group_idx].breaks = breaks;
+            groups[group_idx].num_breaks = num_breaks;
+            groups[group_idx].cursor = 0;
+        }
+
+        // Put each polynomial's coefficients next to each other in memory
+        // when there are enough values to amortize the transposition.
+        groups[group_idx].splines.push_back(SplineView());
+        SplineView &view = groups[group_idx].splines.back();
+        view.layout = oosiggen::columnMajorLayout(coefs, num_polynomials,
+                                                  order);
+        if (oosiggen::shouldTransposeCoefficients(num_polynomials, order,
+                                                  num_values))
+        {
+            view.row_major_coefs.resize(num_polynomials * order);
+            oosiggen::transposeCoefficients(coefs, num_polynomials, order,
+                                            &view.row_major_coefs[0]);
+            view.layout = oosiggen::rowMajorLayout(&view.row_major_coefs[0],
+                                                   order);
+        }
+        view.v = static_cast<double*>(mxGetPr(plhs[spline_idx]));
+    }
+
+    // Evaluate the input values block by block, performing one bin search
+    // per group. Each group keeps its own cursor so the searches stay
+    // amortized constant time for sorted inputs.
+    size_t bins[oosiggen::kEvaluationBlockSize];
+    for (size_t start = 0; start < num_values;
+         start += oosiggen::kEvaluationBlockSize)
+    {
+        const size_t block_size = std::min(oosiggen::kEvaluationBlockSize,
+                                           num_values - start);
+        for (size_t group_idx = 0; group_idx < groups.size(); ++group_idx)
+        {
+            BreaksGroup &group = groups[group_idx];
+            oosiggen::findBins(group.breaks, group.num_breaks, &xx[start],
+                               block_size, bins, group.cursor);
+            for (size_t member_idx = 0; member_idx < group.splines.size();
+                 ++member_idx)
+            {
+                const SplineView &spline = group.splines[member_idx];
+                oosiggen::evaluateBins(group.breaks, spline.layout,
+                                       &xx[start], bins, block_size,
+                                       &spline.v[start]);
+            }
+        }
+    }
+}
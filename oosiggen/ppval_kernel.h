@@ -0,0 +1,518 @@
+/**************************************************************************//**
+ * @brief      Piecewise polynomial evaluation kernels shared by the ppval MEX
+ *             functions.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_PPVAL_KERNEL_H_
+#define OOSIGGEN_PPVAL_KERNEL_H_
+
+#include <algorithm> // For lower_bound(), min().
+#include <cstddef>
+#include <vector>
+
+// Vectorized kernels require AVX2 with FMA (MSVC's /arch:AVX2 implies FMA
+// but does not define __FMA__) or AVX-512.
+#if defined(__AVX512F__) || \
+    (defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER)))
+#define OOSIGGEN_PPVAL_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace oosiggen
+{
+
+/**
+ * @brief Find the polynomial bin that an x-axis location falls into.
+ *
+ * Bin @c i covers the half-open interval (<c>breaks[i]</c>,
+ * <c>breaks[i + 1]</c>]. Values before the first fencepost use the first bin
+ * and values after the last fencepost use the last bin (extrapolation).
+ *
+ * @param breaks The x-axis fencepost locations, sorted ascending.
+ * @param num_breaks The number of fenceposts; must be at least two.
+ * @param x The x-axis location to look up.
+ *
+ * @return The zero-indexed bin (polynomial) index, in the inclusive range
+ *         0 to <c>num_breaks - 2</c>.
+ */
+inline size_t findBin(const double *breaks, size_t num_breaks, double x)
+{
+    if (x <= breaks[0])
+    {
+        // Value is before first bin, so use the first bin.
+        return 0;
+    }
+    else if (x > breaks[num_breaks - 1])
+    {
+        // Value is after last bin, so use last bin.
+        return num_breaks - 2;
+    }
+    const double *it = std::lower_bound(&breaks[0], &breaks[num_breaks], x);
+    return it - &breaks[0] - 1;
+}
+
+/**
+ * @brief Find the polynomial bin that an x-axis location falls into, starting
+ *        the search from a previously found bin.
+ *
+ * This returns exactly the same bin as findBin(), but rather than searching
+ * all of @c breaks it first checks the bin given by @c cursor and then
+ * gallops (exponential search) forward or backward from it before finishing
+ * with a binary search over the bracketed range. When successive lookups are
+ * for ascending x-axis locations, as is the case for time axes, the cost is
+ * amortized O(1) per lookup rather than O(log N). Arbitrarily ordered lookups
+ * remain correct and cost at most about twice a plain binary search.
+ *
+ * @param breaks The x-axis fencepost locations, sorted ascending.
+ * @param num_breaks The number of fenceposts; must be at least two.
+ * @param x The x-axis location to look up.
+ * @param cursor On input, the bin to start searching from (any value in the
+ *        inclusive range 0 to <c>num_breaks - 2</c>). On output, the found
+ *        bin.
+ *
+ * @return The zero-indexed bin (polynomial) index, in the inclusive range
+ *         0 to <c>num_breaks - 2</c>.
+ */
+inline size_t findBinFromCursor(const double *breaks, size_t num_breaks,
+                                double x, size_t &cursor)
+{
+    const size_t last_bin = num_breaks - 2;
+    size_t bin = cursor;
+
+    if (bin < last_bin && x > breaks[bin + 1])
+    {
+        // Gallop forward.
+        if (x > breaks[num_breaks - 1])
+        {
+            bin = last_bin;
+        }
+        else
+        {
+            // Maintain breaks[lo] < x, until breaks[hi] >= x.
+            size_t lo = bin + 1;
+            size_t step = 1;
+            size_t hi = lo + step;
+            while (hi < num_breaks - 1 && breaks[hi] < x)
+            {
+                lo = hi;
+                step <<= 1;
+                hi = lo + step;
+            }
+            if (hi > num_breaks - 1)
+            {
+                hi = num_breaks - 1;
+            }
+            const double *it = std::lower_bound(&breaks[lo + 1],
+                                                &breaks[hi + 1], x);
+            bin = it - &breaks[0] - 1;
+        }
+    }
+    else if (bin > 0 && x <= breaks[bin])
+    {
+        // Gallop backward.
+        if (x <= breaks[0])
+        {
+            bin = 0;
+        }
+        else
+        {
+            // Maintain breaks[hi] >= x, until breaks[lo] < x.
+            size_t hi = bin;
+            size_t step = 1;
+            size_t lo = hi - step;
+            while (lo > 0 && breaks[lo] >= x)
+            {
+                hi = lo;
+                step <<= 1;
+                lo = hi > step ? hi - step : 0;
+            }
+            const double *it = std::lower_bound(&breaks[lo + 1],
+                                                &breaks[hi + 1], x);
+            bin = it - &breaks[0] - 1;
+        }
+    }
+
+    cursor = bin;
+    return bin;
+}
+
+/**
+ * @brief The number of x-axis locations processed per block by
+ *        evaluatePiecewisePolynomial(). Bins for one block are found before
+ *        any of its polynomials are evaluated.
+ */
+const size_t kEvaluationBlockSize = 256;
+
+/**
+ * @brief Describes where the coefficients of a piecewise polynomial are stored.
+ *
+ * Coefficient @c k (highest power first) of polynomial @c i is located at
+ * <c>coefs[i * bin_stride + k * coef_stride]</c>. MATLAB's column-major
+ * coefficient matrix has a @c bin_stride of one, which places every
+ * coefficient of a polynomial in a different cache line; the transposed
+ * (row-major) layout keeps each polynomial contiguous.
+ */
+struct CoefficientLayout
+{
+    const double *coefs; ///< The coefficient storage.
+    size_t order; ///< The number of coefficients per polynomial.
+    size_t bin_stride; ///< Distance between successive polynomials.
+    size_t coef_stride; ///< Distance between successive coefficients.
+};
+
+/**
+ * @brief Describe a MATLAB column-major coefficient matrix.
+ *
+ * @param coefs The coefficient matrix (<c>num_polynomials</c> x @c order).
+ * @param num_polynomials The number of polynomials (rows of @c coefs).
+ * @param order The polynomial order (columns of @c coefs).
+ */
+inline CoefficientLayout columnMajorLayout(const double *coefs,
+                                           size_t num_polynomials,
+                                           size_t order)
+{
+    CoefficientLayout layout = {coefs, order, 1, num_polynomials};
+    return layout;
+}
+
+/**
+ * @brief Describe a row-major (one polynomial per row) coefficient array, as
+ *        produced by transposeCoefficients().
+ *
+ * @param coefs The coefficient array (@c order values per polynomial).
+ * @param order The polynomial order.
+ */
+inline CoefficientLayout rowMajorLayout(const double *coefs, size_t order)
+{
+    CoefficientLayout layout = {coefs, order, order, 1};
+    return layout;
+}
+
+/**
+ * @brief Transpose a MATLAB column-major coefficient matrix to row-major.
+ *
+ * @param column_major The input matrix (<c>num_polynomials</c> x @c order).
+ * @param num_polynomials The number of polynomials.
+ * @param order The polynomial order.
+ * @param row_major The output array, of <c>num_polynomials * order</c>
+ *        elements.
+ */
+inline void transposeCoefficients(const double *column_major,
+                                  size_t num_polynomials, size_t order,
+                                  double *row_major)
+{
+    for (size_t bin = 0; bin < num_polynomials; ++bin)
+    {
+        for (size_t coef_idx = 0; coef_idx < order; ++coef_idx)
+        {
+            row_major[bin * order + coef_idx] =
+                column_major[bin + coef_idx * num_polynomials];
+        }
+    }
+}
+
+/**
+ * @brief Evaluate one polynomial of a piecewise polynomial with Horner's
+ *        method.
+ *
+ * @param layout The coefficient storage.
+ * @param bin The zero-indexed polynomial to evaluate.
+ * @param delta_x The offset of the evaluation point from the bin's left
+ *        fencepost.
+ *
+ * @return The value of the polynomial.
+ */
+inline double evaluatePolynomial(const CoefficientLayout &layout, size_t bin,
+                                 double delta_x)
+{
+    if (layout.order == 0)
+    {
+        return 0.0;
+    }
+    const double *c = &layout.coefs[bin * layout.bin_stride];
+    double v = c[0];
+    for (size_t coef_idx = 1; coef_idx < layout.order; ++coef_idx)
+    {
+        v = delta_x * v + c[coef_idx * layout.coef_stride];
+    }
+    return v;
+}
+
+/**
+ * @brief Find the bins of a block of x-axis locations.
+ *
+ * @param breaks The x-axis fencepost locations, sorted ascending.
+ * @param num_breaks The number of fenceposts; must be at least two.
+ * @param xx The x-axis locations to look up.
+ * @param num_values The number of elements of @c xx.
+ * @param bins The output bins, one per element of @c xx.
+ * @param cursor The search cursor (see findBinFromCursor()).
+ */
+inline void findBins(const double *breaks, size_t num_breaks,
+                     const double *xx, size_t num_values, size_t *bins,
+                     size_t &cursor)
+{
+    for (size_t idx = 0; idx < num_values; ++idx)
+    {
+        bins[idx] = findBinFromCursor(breaks, num_breaks, xx[idx], cursor);
+    }
+}
+
+/**
+ * @brief Horner's method for a polynomial order known at compile time, so
+ *        that the coefficient loop is fully unrolled.
+ */
+template <size_t Order>
+inline double evaluateFixedOrder(const double *c, size_t coef_stride,
+                                 double delta_x)
+{
+    double v = c[0];
+    for (size_t coef_idx = 1; coef_idx < Order; ++coef_idx)
+    {
+        v = delta_x * v + c[coef_idx * coef_stride];
+    }
+    return v;
+}
+
+#if defined(OOSIGGEN_PPVAL_SIMD)
+/**
+ * @brief Evaluate a block of x-axis locations with known bins, several
+ *        locations at a time, using gathered coefficient loads and fused
+ *        multiply-adds.
+ *
+ * AVX-512 evaluates eight locations per iteration, AVX2 four.
+ *
+ * @return The number of locations evaluated; the remainder (fewer than one
+ *         vector's worth) is left for the scalar code.
+ */
+template <size_t Order>
+inline size_t evaluateBinsSimd(const double *breaks,
+                               const CoefficientLayout &layout,
+                               const double *xx, const size_t *bins,
+                               size_t num_values, double *v)
+{
+    static_assert(sizeof(size_t) == sizeof(long long),
+                  "Bins are gathered as 64-bit indices.");
+#if defined(__AVX512F__)
+    const size_t kLanes = 8;
+#else
+    const size_t kLanes = 4;
+#endif
+    size_t idx = 0;
+    for (; idx + kLanes <= num_values; idx += kLanes)
+    {
+        long long offsets[kLanes];
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            offsets[lane] = static_cast<long long>(bins[idx + lane] *
+                                                   layout.bin_stride);
+        }
+#if defined(__AVX512F__)
+        const __m512i bin_idx = _mm512_loadu_si512(&bins[idx]);
+        const __m512i coef_idx = _mm512_loadu_si512(offsets);
+        const __m512d delta_x = _mm512_sub_pd(
+            _mm512_loadu_pd(&xx[idx]),
+            _mm512_i64gather_pd(bin_idx, breaks, sizeof(double)));
+        __m512d acc = _mm512_i64gather_pd(coef_idx, layout.coefs,
+                                          sizeof(double));
+        for (size_t coef_idx_k = 1; coef_idx_k < Order; ++coef_idx_k)
+        {
+            acc = _mm512_fmadd_pd(
+                delta_x, acc,
+                _mm512_i64gather_pd(
+                    coef_idx, &layout.coefs[coef_idx_k * layout.coef_stride],
+                    sizeof(double)));
+        }
+        _mm512_storeu_pd(&v[idx], acc);
+#else
+        const __m256i bin_idx = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&bins[idx]));
+        const __m256i coef_idx = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(offsets));
+        const __m256d delta_x = _mm256_sub_pd(
+            _mm256_loadu_pd(&xx[idx]),
+            _mm256_i64gather_pd(breaks, bin_idx, sizeof(double)));
+        __m256d acc = _mm256_i64gather_pd(layout.coefs, coef_idx,
+                                          sizeof(double));
+        for (size_t coef_idx_k = 1; coef_idx_k < Order; ++coef_idx_k)
+        {
+            acc = _mm256_fmadd_pd(
+                delta_x, acc,
+                _mm256_i64gather_pd(
+                    &layout.coefs[coef_idx_k * layout.coef_stride], coef_idx,
+                    sizeof(double)));
+        }
+        _mm256_storeu_pd(&v[idx], acc);
+#endif
+    }
+    return idx;
+}
+#endif
+
+/**
+ * @brief Evaluate a block of x-axis locations with known bins, for a
+ *        polynomial order known at compile time.
+ */
+template <size_t Order>
+inline void evaluateBinsFixedOrder(const double *breaks,
+                                   const CoefficientLayout &layout,
+                                   const double *xx, const size_t *bins,
+                                   size_t num_values, double *v)
+{
+#if defined(OOSIGGEN_PPVAL_SIMD)
+    size_t idx = evaluateBinsSimd<Order>(breaks, layout, xx, bins,
+                                         num_values, v);
+#else
+    size_t idx = 0;
+#endif
+    for (; idx < num_values; ++idx)
+    {
+        const size_t bin = bins[idx];
+        v[idx] = evaluateFixedOrder<Order>(
+            &layout.coefs[bin * layout.bin_stride], layout.coef_stride,
+            xx[idx] - breaks[bin]);
+    }
+}
+
+/**
+ * @brief Evaluate a block of x-axis locations whose bins have already been
+ *        found (see findBins()).
+ *
+ * Orders one through four (up to cubic, as produced by spline()) dispatch to
+ * compile-time specialized, vectorized kernels; other orders use a generic
+ * scalar loop.
+ *
+ * @param breaks The x-axis fencepost locations.
+ * @param layout The coefficient storage.
+ * @param xx The x-axis locations to evaluate at.
+ * @param bins The bin of each element of @c xx.
+ * @param num_values The number of elements of @c xx.
+ * @param v The output values, one per element of @c xx.
+ */
+inline void evaluateBins(const double *breaks, const CoefficientLayout &layout,
+                         const double *xx, const size_t *bins,
+                         size_t num_values, double *v)
+{
+    switch (layout.order)
+    {
+        case 1:
+            evaluateBinsFixedOrder<1>(breaks, layout, xx, bins, num_values, v);
+            break;
+        case 2:
+            evaluateBinsFixedOrder<2>(breaks, layout, xx, bins, num_values, v);
+            break;
+        case 3:
+            evaluateBinsFixedOrder<3>(breaks, layout, xx, bins, num_values, v);
+            break;
+        case 4:
+            evaluateBinsFixedOrder<4>(breaks, layout, xx, bins, num_values, v);
+            break;
+        default:
+            for (size_t idx = 0; idx < num_values; ++idx)
+            {
+                v[idx] = evaluatePolynomial(layout, bins[idx],
+                                            xx[idx] - breaks[bins[idx]]);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Evaluate a piecewise polynomial at a set of x-axis locations.
+ *
+ * @param breaks The x-axis fencepost locations, sorted ascending.
+ * @param num_breaks The number of fenceposts; must be at least two.
+ * @param layout The coefficient storage, for <c>num_breaks - 1</c>
+ *        polynomials.
+ * @param xx The x-axis locations to evaluate at.
+ * @param num_values The number of elements of @c xx.
+ * @param v The output values, one per element of @c xx.
+ * @param cursor The search cursor (see findBinFromCursor()).
+ */
+inline void evaluatePiecewisePolynomial(const double *breaks, size_t num_breaks,
+                                        const CoefficientLayout &layout,
+                                        const double *xx, size_t num_values,
+                                        double *v, size_t &cursor)
+{
+    size_t bins[kEvaluationBlockSize];
+    for (size_t start = 0; start < num_values; start += kEvaluationBlockSize)
+    {
+        const size_t block_size = std::min(kEvaluationBlockSize,
+                                           num_values - start);
+        findBins(breaks, num_breaks, &xx[start], block_size, bins, cursor);
+        evaluateBins(breaks, layout, &xx[start], bins, block_size, &v[start]);
+    }
+}
+
+/**
+ * @brief Decide whether to transpose a column-major coefficient matrix before
+ *        evaluation.
+ *
+ * Transposing touches every coefficient once, which pays for itself when there
+ * are at least as many locations to evaluate as polynomials.
+ */
+inline bool shouldTransposeCoefficients(size_t num_polynomials, size_t order,
+                                        size_t num_values)
+{
+    return order > 1 && num_values >= num_polynomials;
+}
+
+/**
+ * @brief Evaluate a piecewise polynomial with MATLAB column-major
+ *        coefficients, as ppvalFastCore does.
+ *
+ * The coefficients are transposed into a temporary row-major copy first when
+ * shouldTransposeCoefficients() says it pays for itself.
+ *
+ * @param breaks The x-axis fencepost locations, sorted ascending.
+ * @param num_breaks The number of fenceposts; must be at least two.
+ * @param coefs The <c>(num_breaks - 1)</c> x @c order column-major
+ *        coefficient matrix.
+ * @param order The polynomial order.
+ * @param xx The x-axis locations to evaluate at.
+ * @param num_values The number of elements of @c xx.
+ * @param v The output values, one per element of @c xx.
+ */
+inline void evaluateColumnMajorPiecewisePolynomial(const double *breaks,
+                                                   size_t num_breaks,
+                                                   const double *coefs,
+                                                   size_t order,
+                                                   const double *xx,
+                                                   size_t num_values,
+                                                   double *v)
+{
+    // Put each polynomial's coefficients next to each other in memory when
+    // there are enough values to amortize the transposition.
+    const size_t num_polynomials = num_breaks - 1;
+    CoefficientLayout layout = columnMajorLayout(coefs, num_polynomials,
+                                                 order);
+    std::vector<double> row_major_coefs;
+    if (shouldTransposeCoefficients(num_polynomials, order, num_values))
+    {
+        row_major_coefs.resize(num_polynomials * order);
+        transposeCoefficients(coefs, num_polynomials, order,
+                              &row_major_coefs[0]);
+        layout = rowMajorLayout(&row_major_coefs[0], order);
+    }
+
+    // Evaluate each input value. The bin search resumes from the previous
+    // value's bin, which is amortized constant time for sorted inputs.
+    size_t cursor = 0;
+    evaluatePiecewisePolynomial(breaks, num_breaks, layout, xx, num_values, v,
+                                cursor);
+}
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_PPVAL_KERNEL_H_
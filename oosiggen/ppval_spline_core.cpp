@@ -0,0 +1,405 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to compiled piecewise polynomials, so
+ *             splines are validated and marshaled once rather than on every
+ *             evaluation.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mex.h"
+
+#include "compiled_spline.h"
+#include "mex_handle_registry.h"
+#include "nco.h"
+#include "piecewise_polynomial_file.h"
+
+namespace
+{
+
+/**
+ * @brief The compiled splines owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::CompiledSpline> &splines()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::CompiledSpline>
+        registry("ppvalSplineCore");
+    return registry;
+}
+
+/**
+ * @brief The fencepost storage shared between compiled splines.
+ */
+oosiggen::BreaksPool &breaksPool()
+{
+    static oosiggen::BreaksPool pool;
+    return pool;
+}
+
+/**
+ * @brief Free all compiled splines when the MEX file is cleared.
+ */
+void freeAllSplines()
+{
+    splines().clear();
+}
+
+/**
+ * @brief Compile a spline from its breaks and coefficients.
+ */
+void compileSpline(int nlhs, mxArray *plhs[], int nrhs,
+                   const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("compile requires breaks and coefs.");
+    }
+
+    const size_t num_breaks = mxGetN(prhs[1]);
+    if (prhs[1] == NULL || !mxIsDouble(prhs[1]) || mxIsComplex(prhs[1]) ||
+        (mxGetNumberOfElements(prhs[1]) != num_breaks))
+    {
+        mexErrMsgTxt("breaks must be a real row array of doubles.");
+    }
+    if (num_breaks < 2)
+    {
+        mexErrMsgTxt("breaks must contain at least two fenceposts.");
+    }
+
+    const size_t num_polynomials = mxGetM(prhs[2]);
+    const size_t order = mxGetN(prhs[2]);
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        (mxGetNumberOfElements(prhs[2]) != num_polynomials * order))
+    {
+        mexErrMsgTxt("coefs must be a real matrix of doubles.");
+    }
+    if (num_polynomials != num_breaks - 1)
+    {
+        mexErrMsgTxt("Number of polynomials is not consistent with number "
+                     "of breaks.");
+    }
+
+    const double *breaks = static_cast<double*>(mxGetPr(prhs[1]));
+    for (size_t break_idx = 1; break_idx < num_breaks; ++break_idx)
+    {
+        if (!(breaks[break_idx] >= breaks[break_idx - 1]))
+        {
+            mexErrMsgTxt("breaks must be sorted in ascending order.");
+        }
+    }
+
+    std::unique_ptr<oosiggen::CompiledSpline> spline(
+        new oosiggen::CompiledSpline(
+            breaksPool().intern(breaks, num_breaks),
+            static_cast<double*>(mxGetPr(prhs[2])), order));
+    plhs[0] = splines().add(std::move(spline));
+}
+
+/**
+ * @brief Compile a spline directly from a binary piecewise polynomial file.
+ */
+void loadSpline(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2 || !mxIsChar(prhs[1]))
+    {
+        mexErrMsgTxt("load requires a filename.");
+    }
+    char *filename = mxArrayToString(prhs[1]);
+    if (filename == NULL)
+    {
+        mexErrMsgTxt("Could not read filename.");
+    }
+    const std::string path(filename);
+    mxFree(filename);
+
+    std::unique_ptr<oosiggen::CompiledSpline> spline;
+    try
+    {
+        const oosiggen::PiecewisePolynomialFile file(path);
+        std::vector<double> breaks(file.numBreaks());
+        file.readBreaks(&breaks[0]);
+        for (size_t break_idx = 1; break_idx < breaks.size(); ++break_idx)
+        {
+            if (!(breaks[break_idx] >= breaks[break_idx - 1]))
+            {
+                throw std::runtime_error(
+                    "breaks must be sorted in ascending order.");
+            }
+        }
+
+        // The file stores each polynomial contiguously, as the compiled
+        // spline does, so the records are copied straight into place.
+        spline.reset(new oosiggen::CompiledSpline(
+            breaksPool().intern(&breaks[0], breaks.size()), file.order()));
+        file.readCoefficients(spline->coefficients(), file.order(), 1);
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = splines().add(std::move(spline));
+}
+
+/**
+ * @brief Evaluate one or more compiled splines at a common set of x-axis
+ *        locations.
+ */
+void evaluateSplines(int nlhs, mxArray *plhs[], int nrhs,
+                     const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("eval requires handles and xx.");
+    }
+    if (prhs[1] == NULL || !mxIsUint64(prhs[1]) || mxIsEmpty(prhs[1]))
+    {
+        mexErrMsgTxt("handles must be a non-empty uint64 array.");
+    }
+    const size_t num_splines = mxGetNumberOfElements(prhs[1]);
+    if (static_cast<size_t>(nlhs) > num_splines ||
+        (nlhs == 0 && num_splines > 1))
+    {
+        mexErrMsgTxt("Number of output arguments must not exceed the number "
+                     "of handles.");
+    }
+
+    const size_t num_values = mxGetM(prhs[2]);
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        (mxGetNumberOfElements(prhs[2]) != num_values))
+    {
+        mexErrMsgTxt("xx must be a real column array of doubles.");
+    }
+
+    // Only the splines that have a requested output are evaluated.
+    const size_t num_outputs = nlhs > 0 ? static_cast<size_t>(nlhs) : 1;
+    const unsigned long long *handles =
+        static_cast<unsigned long long*>(mxGetData(prhs[1]));
+    std::vector<oosiggen::CompiledSpline*> targets(num_outputs);
+    std::vector<double*> outputs(num_outputs);
+    for (size_t spline_idx = 0; spline_idx < num_outputs; ++spline_idx)
+    {
+        targets[spline_idx] = &splines().get(handles[spline_idx]);
+        plhs[spline_idx] = mxCreateDoubleMatrix(
+            static_cast<mwSize>(num_values), 1, mxREAL);
+        if (plhs[spline_idx] == NULL)
+        {
+            mexErrMsgTxt("Could not allocate output array.");
+        }
+        outputs[spline_idx] =
+            static_cast<double*>(mxGetPr(plhs[spline_idx]));
+    }
+
+    oosiggen::evaluateCompiledSplines(
+        &targets[0], num_outputs, static_cast<double*>(mxGetPr(prhs[2])),
+        num_values, &outputs[0]);
+}
+
+/**
+ * @brief Compile the antiderivative of a compiled spline.
+ */
+void integrateSpline(int nlhs, mxArray *plhs[], int nrhs,
+                     const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("integrate requires a handle and period.");
+    }
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        mxGetNumberOfElements(prhs[2]) != 1 || !(mxGetScalar(prhs[2]) >= 0.0))
+    {
+        mexErrMsgTxt("period must be a nonnegative real scalar double.");
+    }
+    plhs[0] = splines().add(
+        splines().get(prhs[1]).integral(mxGetScalar(prhs[2])));
+}
+
+/**
+ * @brief Rotate samples by the carrier phase given by a compiled spline.
+ */
+void rotateSamples(int nlhs, mxArray *plhs[], int nrhs,
+                   const mxArray *prhs[])
+{
+    if (nrhs != 5)
+    {
+        mexErrMsgTxt("rotate requires a handle, x, phase and xx.");
+    }
+    if (nlhs > 2)
+    {
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    const mxArray *x = prhs[2];
+    const size_t num_samples = mxGetM(x);
+    if (x == NULL || !mxIsDouble(x) ||
+        mxGetNumberOfElements(x) != num_samples)
+    {
+        mexErrMsgTxt("x must be a column array of doubles.");
+    }
+    if (prhs[3] == NULL || !mxIsDouble(prhs[3]) || mxIsComplex(prhs[3]) ||
+        mxGetNumberOfElements(prhs[3]) != 1)
+    {
+        mexErrMsgTxt("phase must be a real scalar double.");
+    }
+    if (prhs[4] == NULL || !mxIsDouble(prhs[4]) || mxIsComplex(prhs[4]) ||
+        mxGetNumberOfElements(prhs[4]) != num_samples ||
+        mxGetM(prhs[4]) != num_samples)
+    {
+        mexErrMsgTxt("xx must be a real column array of doubles the length "
+                     "of x.");
+    }
+    oosiggen::CompiledSpline &spline = splines().get(prhs[1]);
+
+    plhs[0] = mxCreateDoubleMatrix(static_cast<mwSize>(num_samples), 1,
+                                   mxCOMPLEX);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+    const double last_phase = oosiggen::ncoRotateSpline(
+        mxGetScalar(prhs[3]), spline, static_cast<double*>(mxGetPr(prhs[4])),
+        num_samples, static_cast<double*>(mxGetPr(x)),
+        mxIsComplex(x) ? static_cast<double*>(mxGetPi(x)) : NULL,
+        static_cast<double*>(mxGetPr(plhs[0])),
+        static_cast<double*>(mxGetPi(plhs[0])));
+    if (nlhs > 1)
+    {
+        plhs[1] = mxCreateDoubleScalar(last_phase);
+    }
+}
+
+/**
+ * @brief Free one or more compiled splines.
+ */
+void freeSplines(int nlhs, mxArray *plhs[], int nrhs,
+                 const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    splines().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = ppvalSplineCore('compile', breaks, coefs)
+ * h = ppvalSplineCore('load', filename)
+ * [v_1, ..., v_N] = ppvalSplineCore('eval', handles, xx)
+ * h_integral = ppvalSplineCore('integrate', h, period)
+ * [y, last_phase] = ppvalSplineCore('rotate', h, x, phase, xx)
+ * ppvalSplineCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'compile':
+ * - <c>prhs[1]</c>: The input vector, @c breaks, as for ppvalFastCore. Must
+ *   be sorted in ascending order.
+ * - <c>prhs[2]</c>: The input matrix, @c coefs, as for ppvalFastCore.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the compiled spline.
+ *
+ * For @c 'load':
+ * - <c>prhs[1]</c>: The path of a binary piecewise polynomial file (see
+ *   PiecewisePolynomialFile). Its breaks must be sorted in ascending order.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the compiled spline.
+ *
+ * For @c 'eval':
+ * - <c>prhs[1]</c>: A @c uint64 array of @c N handles.
+ * - <c>prhs[2]</c>: The input vector, @c xx, which represents the desired
+ *   x-axis locations. Must be a real column vector of doubles.
+ * - <c>plhs[0..N-1]</c>: The values of each spline evaluated at @c xx.
+ *
+ * For @c 'integrate':
+ * - <c>prhs[1]</c>: A @c uint64 scalar handle.
+ * - <c>prhs[2]</c>: The period to reduce the antiderivative's per-bin
+ *   constants by, or zero (see CompiledSpline::integral()).
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the compiled
+ *   antiderivative, zero at the first break.
+ *
+ * For @c 'rotate':
+ * - <c>prhs[1]</c>: A @c uint64 scalar handle to a spline of carrier phase
+ *   (in cycles) vs x.
+ * - <c>prhs[2]</c>: The samples to rotate, a real or complex column array.
+ * - <c>prhs[3]</c>: The carrier phase offset (in rad).
+ * - <c>prhs[4]</c>: The ascending x-axis location of each sample, a real
+ *   column vector of doubles.
+ * - <c>plhs[0]</c>: The complex column array of rotated samples, each
+ *   multiplied by <c>exp(1i * (phase + 2*pi*v))</c>, where @c v is the
+ *   spline's value at its location (see oosiggen::ncoRotateSpline()).
+ * - <c>plhs[1]</c>: The carrier phase of the last sample (in rad), wrapped
+ *   to [0, 2*pi).
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllSplines);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "compile") == 0)
+    {
+        compileSpline(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "load") == 0)
+    {
+        loadSpline(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "eval") == 0)
+    {
+        evaluateSplines(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "integrate") == 0)
+    {
+        integrateSpline(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "rotate") == 0)
+    {
+        rotateSamples(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeSplines(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
@@ -62,5 +62,20 @@ classdef SineWaveGenerator < SampleGenerator
             samples = sin(2 * pi * obj.frequency * current_time_vector);
             obj.sample_counter = obj.sample_counter + num_samples;
         end
+        
+        function seek(obj, sample_index)
+        %%
+        % @brief Position the generator at a sample index from its start
+        %        (see SampleGenerator.seek()).
+        %
+        % @par Usage
+        % obj.seek(sample_index)
+        %
+        % @param[in] obj The class instance.
+        % @param[in] sample_index The zero-indexed sample.
+            validateattributes(sample_index, {'numeric'}, ...
+                               {'scalar', 'integer', 'nonnegative'});
+            obj.sample_counter = uint64(sample_index);
+        end
     end
 end
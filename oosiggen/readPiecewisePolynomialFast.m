@@ -0,0 +1,37 @@
+%%
+% @brief Reads a binary piecewise polynomial (.mgpp) file into a spline
+%        struct.
+%
+% This is a native replacement for the MATLAB implementation in
+% readPiecewisePolynomialBinary(), which it returns the same struct as. The
+% file is memory-mapped and its header, lookup table and polynomial records
+% are validated before use; the breaks and coefficients are then copied
+% straight from the mapping into the output arrays. Polynomials with fewer
+% coefficients than the highest order in the file are padded with leading
+% zeros.
+%
+% @note
+% To read a file directly into a compiled spline for ppvalEval(), without
+% forming the struct, use ppvalLoad().
+%
+% @note
+% This is a MATLAB stub to provide "help" support; this function is implemented
+% as a MEX function that must be compiled with make.m. See the library
+% documentation for more information about this process.
+%
+% @par Usage
+% pp = readPiecewisePolynomialFast(filename)
+%
+% @param[in] filename The path of the binary piecewise polynomial file.
+%
+% @param[out] pp The piecewise polynomial struct, in the format returned by
+%             spline().
+%
+%
+% @copyright Copyright &copy; 2026 The %MITRE Corporation
+%
+% @par Notice
+% This software was produced for the U.S. Government under Contract No.
+% FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+% Software and Noncommercial Computer Software Documentation Clause
+% (DFARS) 252.227-7014 (JUN 1995)
@@ -0,0 +1,100 @@
+/**************************************************************************//**
+ * @brief      Reads a binary piecewise polynomial file into a spline struct.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "mex.h"
+
+#include "piecewise_polynomial_file.h"
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * pp = readPiecewisePolynomialFast(filename)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The path of the binary piecewise polynomial file.
+ *
+ * - <c>plhs[0]</c>: The piecewise polynomial struct, with the @c breaks,
+ *   @c coefs, @c form, @c pieces, @c order and @c dim fields of a spline()
+ *   struct.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    // Input argument checks.
+    if (nrhs != 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("One input required: filename.");
+    }
+    if (nlhs > 1)
+    {
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    char *filename = mxArrayToString(prhs[0]);
+    if (filename == NULL)
+    {
+        mexErrMsgTxt("Could not read filename.");
+    }
+    const std::string path(filename);
+    mxFree(filename);
+
+    std::unique_ptr<oosiggen::PiecewisePolynomialFile> file;
+    try
+    {
+        file.reset(new oosiggen::PiecewisePolynomialFile(path));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+
+    // Fill the MATLAB arrays directly from the mapped file.
+    mxArray *breaks = mxCreateDoubleMatrix(
+        1, static_cast<mwSize>(file->numBreaks()), mxREAL);
+    mxArray *coefs = mxCreateDoubleMatrix(
+        static_cast<mwSize>(file->numPolynomials()),
+        static_cast<mwSize>(file->order()), mxREAL);
+    if (breaks == NULL || coefs == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output arrays.");
+    }
+    file->readBreaks(static_cast<double*>(mxGetPr(breaks)));
+    file->readCoefficients(static_cast<double*>(mxGetPr(coefs)), 1,
+                           file->numPolynomials());
+
+    const char *field_names[] = {"breaks", "coefs", "form", "pieces",
+                                 "order", "dim"};
+    plhs[0] = mxCreateStructMatrix(1, 1, 6, field_names);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output struct.");
+    }
+    mxSetField(plhs[0], 0, "breaks", breaks);
+    mxSetField(plhs[0], 0, "coefs", coefs);
+    mxSetField(plhs[0], 0, "form", mxCreateString("pp"));
+    mxSetField(plhs[0], 0, "pieces", mxCreateDoubleScalar(
+        static_cast<double>(file->numPolynomials())));
+    mxSetField(plhs[0], 0, "order", mxCreateDoubleScalar(
+        static_cast<double>(file->order())));
+    mxSetField(plhs[0], 0, "dim", mxCreateDoubleScalar(1.0));
+}
@@ -0,0 +1,235 @@
+/**************************************************************************//**
+ * @brief      Paces a stream of IQ samples into a live sink at the sample
+ *             rate.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include "realtime_streamer.h"
+
+#include <algorithm> // For fill(), max(), min().
+#include <chrono>
+#include <stdexcept>
+#include <utility> // For move().
+
+namespace oosiggen
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+/// How long the producer sleeps while the ring is full, and the transmit
+/// thread while it waits for the prefill.
+const std::chrono::microseconds kPollInterval(200);
+
+} // namespace
+
+RealtimeStreamer::RealtimeStreamer(std::unique_ptr<IqSink> sink,
+                                   double byte_rate, size_t sample_bytes,
+                                   size_t ring_bytes, size_t prefill_bytes)
+    : sink_(std::move(sink)), byte_rate_(byte_rate), packet_bytes_(0),
+      prefill_bytes_(prefill_bytes), ring_(ring_bytes), bytes_accepted_(0),
+      in_underrun_(false)
+{
+    if (!sink_)
+    {
+        throw std::invalid_argument("A sink is required.");
+    }
+    if (!(byte_rate > 0.0) || sample_bytes == 0)
+    {
+        throw std::invalid_argument("byte_rate and sample_bytes must be "
+                                    "positive.");
+    }
+    packet_bytes_ = (sink_->maxPacketBytes() / sample_bytes) * sample_bytes;
+    if (packet_bytes_ == 0)
+    {
+        throw std::invalid_argument("The sink's packets cannot hold a "
+                                    "sample.");
+    }
+    if (prefill_bytes > ring_bytes || packet_bytes_ > ring_bytes)
+    {
+        throw std::invalid_argument("The ring must hold the prefill and a "
+                                    "packet.");
+    }
+    packet_.resize(packet_bytes_);
+    statistics_.bytes_accepted = 0;
+    statistics_.bytes_sent = 0;
+    statistics_.packets_sent = 0;
+    statistics_.underruns = 0;
+    statistics_.underrun_bytes = 0;
+    statistics_.elapsed = 0.0;
+    statistics_.max_lateness = 0.0;
+    statistics_.min_queued_bytes = ring_bytes;
+    closing_.store(false);
+    failed_.store(false);
+    transmitter_ = std::thread(&RealtimeStreamer::transmitLoop, this);
+}
+
+RealtimeStreamer::~RealtimeStreamer()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+void RealtimeStreamer::write(const void *data, size_t num_bytes)
+{
+    if (!isOpen())
+    {
+        throw std::logic_error("The stream has been closed.");
+    }
+    const char *source = static_cast<const char*>(data);
+    for (;;)
+    {
+        checkError();
+        const size_t count = ring_.write(source, num_bytes);
+        source += count;
+        num_bytes -= count;
+        bytes_accepted_ += count;
+        if (num_bytes == 0)
+        {
+            return;
+        }
+        std::this_thread::sleep_for(kPollInterval);
+    }
+}
+
+void RealtimeStreamer::close()
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    closing_.store(true, std::memory_order_release);
+    transmitter_.join();
+    checkError();
+}
+
+StreamerStatistics RealtimeStreamer::statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    StreamerStatistics statistics = statistics_;
+    statistics.bytes_accepted = bytes_accepted_;
+    return statistics;
+}
+
+void RealtimeStreamer::checkError() const
+{
+    if (failed_.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        throw std::runtime_error(error_);
+    }
+}
+
+void RealtimeStreamer::transmitLoop()
+{
+    try
+    {
+        // Build up the prefill, which is the latency from generation to
+        // transmission and the margin against generation jitter.
+        while (ring_.size() < prefill_bytes_ &&
+               !closing_.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(kPollInterval);
+        }
+
+        const Clock::time_point start = Clock::now();
+        unsigned long long bytes_due = 0;
+        for (;;)
+        {
+            const Clock::time_point due = start +
+                std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(bytes_due / byte_rate_));
+            Clock::time_point now = Clock::now();
+            if (now < due)
+            {
+                std::this_thread::sleep_until(due);
+                now = Clock::now();
+            }
+            const double elapsed =
+                std::chrono::duration<double>(now - start).count();
+            const double lateness =
+                std::chrono::duration<double>(now - due).count();
+
+            // Read the flag before the ring, so that a closed stream's size
+            // is final.
+            const bool closing = closing_.load(std::memory_order_acquire);
+            const size_t queued = ring_.size();
+            if (queued >= packet_bytes_)
+            {
+                ring_.read(packet_.data(), packet_bytes_);
+                sink_->send(packet_.data(), packet_bytes_);
+                recordPacket(packet_bytes_, queued, false, elapsed, lateness);
+            }
+            else if (closing)
+            {
+                if (queued > 0)
+                {
+                    ring_.read(packet_.data(), queued);
+                    sink_->send(packet_.data(), queued);
+                    recordPacket(queued, queued, false, elapsed, lateness);
+                }
+                return;
+            }
+            else
+            {
+                std::fill(packet_.begin(), packet_.end(), '\0');
+                sink_->send(packet_.data(), packet_bytes_);
+                recordPacket(packet_bytes_, queued, true, elapsed, lateness);
+            }
+            bytes_due += packet_bytes_;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = e.what();
+        failed_.store(true, std::memory_order_release);
+    }
+}
+
+void RealtimeStreamer::recordPacket(size_t num_bytes, size_t queued,
+                                    bool underrun, double elapsed,
+                                    double lateness)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.bytes_sent += num_bytes;
+    ++statistics_.packets_sent;
+    if (underrun)
+    {
+        statistics_.underrun_bytes += num_bytes;
+        if (!in_underrun_)
+        {
+            ++statistics_.underruns;
+        }
+    }
+    in_underrun_ = underrun;
+    statistics_.elapsed = elapsed;
+    statistics_.max_lateness = std::max(statistics_.max_lateness, lateness);
+    // The ring drains at the end of the stream; only the fill while data is
+    // still being written measures the margin.
+    if (!closing_.load(std::memory_order_acquire))
+    {
+        statistics_.min_queued_bytes =
+            std::min<unsigned long long>(statistics_.min_queued_bytes,
+                                         queued);
+    }
+}
+
+} // namespace oosiggen
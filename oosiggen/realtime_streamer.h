@@ -0,0 +1,154 @@
+/**************************************************************************//**
+ * @brief      Paces a stream of IQ samples into a live sink at the sample
+ *             rate.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_REALTIME_STREAMER_H_
+#define OOSIGGEN_REALTIME_STREAMER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "iq_sink.h"
+#include "spsc_ring.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief The counters of a RealtimeStreamer, for underrun detection and a
+ *        latency budget.
+ */
+struct StreamerStatistics
+{
+    unsigned long long bytes_accepted; ///< Bytes passed to write().
+    unsigned long long bytes_sent; ///< Bytes sent, including underrun fill.
+    unsigned long long packets_sent; ///< Packets sent.
+    /// The number of times the ring ran dry while transmitting.
+    unsigned long long underruns;
+    unsigned long long underrun_bytes; ///< Zero bytes sent to fill underruns.
+    double elapsed; ///< Time since transmission started (in sec).
+    double max_lateness; ///< Longest a packet was sent past its time (sec).
+    /// The fewest bytes queued when a packet was due, while data was still
+    /// being written.
+    unsigned long long min_queued_bytes;
+};
+
+/**
+ * @brief Sends a byte stream of interleaved IQ samples to an IqSink in real
+ *        time, from a background transmit thread.
+ *
+ * write() copies into a lock-free single-producer, single-consumer ring
+ * (see SpscRing), waiting only while the ring is full. The transmit thread
+ * waits for the ring to hold a prefill, then sends packets on a fixed
+ * schedule: packet @c k is due when the bytes before it would have played
+ * out at the byte rate. Due times are absolute, so sleep granularity only
+ * jitters packets and never accumulates as drift.
+ *
+ * If the ring cannot supply a whole packet when one is due, generation has
+ * fallen behind real time. That underrun is counted and a packet of zeros is
+ * sent in its place, so the receiver's sample clock stays continuous, as an
+ * SDR's DAC does when its transmit buffer empties; the stream then resumes,
+ * delayed by the fill.
+ *
+ * An error in the transmit thread is reported by the next call to write()
+ * or close().
+ */
+class RealtimeStreamer
+{
+public:
+    /**
+     * @brief Start a transmit thread sending to a sink.
+     *
+     * @param sink The destination, owned by the streamer.
+     * @param byte_rate The real-time rate of the stream (in bytes/sec).
+     * @param sample_bytes The size of one interleaved IQ sample (in bytes);
+     *        packets are whole samples.
+     * @param ring_bytes The capacity of the ring (in bytes).
+     * @param prefill_bytes The bytes queued before transmission starts; at
+     *        most @c ring_bytes.
+     */
+    RealtimeStreamer(std::unique_ptr<IqSink> sink, double byte_rate,
+                     size_t sample_bytes, size_t ring_bytes,
+                     size_t prefill_bytes);
+
+    /**
+     * @brief Stop transmitting, if not already closed; errors are discarded.
+     */
+    ~RealtimeStreamer();
+
+    /**
+     * @brief Queue data for transmission. Returns once the data has been
+     *        copied into the ring.
+     */
+    void write(const void *data, size_t num_bytes);
+
+    /**
+     * @brief Transmit the queued data, then stop. Further writes are not
+     *        allowed.
+     */
+    void close();
+
+    bool isOpen() const { return transmitter_.joinable(); }
+
+    /**
+     * @brief A snapshot of the counters; may be called while streaming.
+     */
+    StreamerStatistics statistics() const;
+
+    size_t packetBytes() const { return packet_bytes_; }
+
+private:
+    RealtimeStreamer(const RealtimeStreamer&);
+    RealtimeStreamer &operator=(const RealtimeStreamer&);
+
+    /**
+     * @brief Throw the transmit thread's error, if any.
+     */
+    void checkError() const;
+
+    void transmitLoop();
+
+    /**
+     * @brief Record a sent packet; @c queued is the bytes queued when it was
+     *        due.
+     */
+    void recordPacket(size_t num_bytes, size_t queued, bool underrun,
+                      double elapsed, double lateness);
+
+    std::unique_ptr<IqSink> sink_; ///< The destination.
+    double byte_rate_; ///< The real-time rate (in bytes/sec).
+    size_t packet_bytes_; ///< The size of each full packet.
+    size_t prefill_bytes_; ///< The bytes queued before transmitting.
+    SpscRing ring_; ///< Bytes written but not yet sent.
+    std::vector<char> packet_; ///< The transmit thread's packet buffer.
+    unsigned long long bytes_accepted_; ///< Bytes passed to write().
+
+    std::thread transmitter_; ///< Sends packets on schedule.
+    std::atomic<bool> closing_; ///< True once no more data will be written.
+    std::atomic<bool> failed_; ///< True once error_ is set.
+    mutable std::mutex mutex_; ///< Guards the fields below.
+    StreamerStatistics statistics_; ///< All but bytes_accepted.
+    bool in_underrun_; ///< True while sending underrun fill.
+    std::string error_; ///< The transmit thread's error, if any.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_REALTIME_STREAMER_H_
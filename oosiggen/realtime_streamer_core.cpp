@@ -0,0 +1,323 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to the real-time IQ streamer.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility> // For move().
+
+#include "mex.h"
+
+#include "iq_sink.h"
+#include "mex_handle_registry.h"
+#include "realtime_streamer.h"
+
+namespace
+{
+
+/**
+ * @brief The streamers owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::RealtimeStreamer> &streamers()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::RealtimeStreamer>
+        registry("realtimeStreamerCore");
+    return registry;
+}
+
+/**
+ * @brief Free all streamers when the MEX file is cleared.
+ */
+void freeAllStreamers()
+{
+    streamers().clear();
+}
+
+/**
+ * @brief Check that an argument is a real scalar double.
+ */
+bool isRealScalar(const mxArray *array)
+{
+    return array != NULL && mxIsDouble(array) && !mxIsComplex(array) &&
+           mxGetNumberOfElements(array) == 1;
+}
+
+/**
+ * @brief Convert a streamer's counters to a MATLAB struct.
+ */
+mxArray *statisticsToStruct(const oosiggen::StreamerStatistics &statistics,
+                            size_t packet_bytes)
+{
+    const char *field_names[] = {"bytes_accepted", "bytes_sent",
+                                 "packets_sent", "underruns",
+                                 "underrun_bytes", "elapsed", "max_lateness",
+                                 "min_queued_bytes", "packet_bytes"};
+    const double values[] = {
+        static_cast<double>(statistics.bytes_accepted),
+        static_cast<double>(statistics.bytes_sent),
+        static_cast<double>(statistics.packets_sent),
+        static_cast<double>(statistics.underruns),
+        static_cast<double>(statistics.underrun_bytes),
+        statistics.elapsed,
+        statistics.max_lateness,
+        static_cast<double>(statistics.min_queued_bytes),
+        static_cast<double>(packet_bytes)};
+    const int num_fields = sizeof(field_names) / sizeof(field_names[0]);
+    mxArray *result = mxCreateStructMatrix(1, 1, num_fields, field_names);
+    for (int field_idx = 0; field_idx < num_fields; ++field_idx)
+    {
+        mxSetField(result, 0, field_names[field_idx],
+                   mxCreateDoubleScalar(values[field_idx]));
+    }
+    return result;
+}
+
+/**
+ * @brief Open a sink and start a streamer transmitting to it.
+ */
+void createStreamer(int nlhs, mxArray *plhs[], int nrhs,
+                    const mxArray *prhs[])
+{
+    if (nrhs != 7)
+    {
+        mexErrMsgTxt("create requires destination, byte_rate, sample_bytes, "
+                     "ring_bytes, prefill_bytes and packet_bytes.");
+    }
+    if (!mxIsChar(prhs[1]))
+    {
+        mexErrMsgTxt("destination must be a character array.");
+    }
+    for (int arg_idx = 2; arg_idx < 7; ++arg_idx)
+    {
+        if (!isRealScalar(prhs[arg_idx]))
+        {
+            mexErrMsgTxt("byte_rate, sample_bytes, ring_bytes, "
+                         "prefill_bytes and packet_bytes must be real "
+                         "scalar doubles.");
+        }
+    }
+    const double byte_rate = mxGetScalar(prhs[2]);
+    const double sample_bytes = mxGetScalar(prhs[3]);
+    const double ring_bytes = mxGetScalar(prhs[4]);
+    const double prefill_bytes = mxGetScalar(prhs[5]);
+    const double packet_bytes = mxGetScalar(prhs[6]);
+    if (!(byte_rate > 0.0) || !(sample_bytes >= 1.0) ||
+        !(ring_bytes >= 1.0) || !(prefill_bytes >= 0.0) ||
+        !(packet_bytes >= 0.0))
+    {
+        mexErrMsgTxt("byte_rate, sample_bytes and ring_bytes must be "
+                     "positive, and prefill_bytes and packet_bytes "
+                     "non-negative.");
+    }
+
+    char *destination_text = mxArrayToString(prhs[1]);
+    if (destination_text == NULL)
+    {
+        mexErrMsgTxt("Could not read destination.");
+    }
+    const std::string destination(destination_text);
+    mxFree(destination_text);
+
+    std::unique_ptr<oosiggen::RealtimeStreamer> streamer;
+    try
+    {
+        streamer.reset(new oosiggen::RealtimeStreamer(
+            oosiggen::createIqSink(destination,
+                                   static_cast<size_t>(packet_bytes)),
+            byte_rate, static_cast<size_t>(sample_bytes),
+            static_cast<size_t>(ring_bytes),
+            static_cast<size_t>(prefill_bytes)));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = streamers().add(std::move(streamer));
+}
+
+/**
+ * @brief Queue the raw bytes of a numeric array for transmission.
+ */
+void writeData(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("write requires a handle and data.");
+    }
+    oosiggen::RealtimeStreamer &streamer = streamers().get(prhs[1]);
+    if (prhs[2] == NULL || !mxIsNumeric(prhs[2]) || mxIsComplex(prhs[2]))
+    {
+        mexErrMsgTxt("data must be a real numeric array.");
+    }
+
+    try
+    {
+        streamer.write(mxGetData(prhs[2]), mxGetNumberOfElements(prhs[2]) *
+                                           mxGetElementSize(prhs[2]));
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+}
+
+/**
+ * @brief Return a streamer's counters.
+ */
+void getStatistics(int nlhs, mxArray *plhs[], int nrhs,
+                   const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("statistics requires a handle.");
+    }
+    const oosiggen::RealtimeStreamer &streamer = streamers().get(prhs[1]);
+    plhs[0] = statisticsToStruct(streamer.statistics(),
+                                 streamer.packetBytes());
+}
+
+/**
+ * @brief Transmit the queued data and stop a streamer.
+ */
+void closeStreamer(int nlhs, mxArray *plhs[], int nrhs,
+                   const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("close requires a handle.");
+    }
+    oosiggen::RealtimeStreamer &streamer = streamers().get(prhs[1]);
+
+    try
+    {
+        streamer.close();
+    }
+    catch (const std::exception &e)
+    {
+        mexErrMsgTxt(e.what());
+    }
+    plhs[0] = statisticsToStruct(streamer.statistics(),
+                                 streamer.packetBytes());
+}
+
+/**
+ * @brief Free one or more streamers, stopping their transmission.
+ */
+void freeStreamers(int nlhs, mxArray *plhs[], int nrhs,
+                   const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    streamers().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = realtimeStreamerCore('create', destination, byte_rate, ...
+ *                          sample_bytes, ring_bytes, prefill_bytes, ...
+ *                          packet_bytes)
+ * realtimeStreamerCore('write', h, data)
+ * statistics = realtimeStreamerCore('statistics', h)
+ * statistics = realtimeStreamerCore('close', h)
+ * realtimeStreamerCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>prhs[1]</c>: The destination, such as <c>'udp://host:port'</c>.
+ * - <c>prhs[2]</c>: The real-time rate of the stream (in bytes/sec).
+ * - <c>prhs[3]</c>: The size of one interleaved IQ sample (in bytes).
+ * - <c>prhs[4]</c>: The capacity of the ring (in bytes).
+ * - <c>prhs[5]</c>: The bytes queued before transmission starts.
+ * - <c>prhs[6]</c>: The largest packet to send (in bytes), or 0 for the
+ *   sink's default.
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to the new streamer.
+ *
+ * For @c 'write':
+ * - <c>prhs[1]</c>: The streamer handle.
+ * - <c>prhs[2]</c>: A real numeric array, whose elements are queued in their
+ *   native byte order. Errors from the transmit thread are reported here.
+ *
+ * For @c 'statistics' and @c 'close':
+ * - <c>prhs[1]</c>: The streamer handle.
+ * - <c>plhs[0]</c>: A struct of counters with the fields @c bytes_accepted,
+ *   @c bytes_sent (including underrun fill), @c packets_sent, @c underruns
+ *   (the number of times the ring ran dry), @c underrun_bytes, @c elapsed
+ *   (the time since transmission started, in sec), @c max_lateness (the
+ *   longest a packet was sent past its due time, in sec),
+ *   @c min_queued_bytes (the fewest bytes queued when a packet was due) and
+ *   @c packet_bytes.
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllStreamers);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createStreamer(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "write") == 0)
+    {
+        writeData(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "statistics") == 0)
+    {
+        getStatistics(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "close") == 0)
+    {
+        closeStreamer(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeStreamers(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ * @brief      Lock-free single-producer, single-consumer byte ring.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_SPSC_RING_H_
+#define OOSIGGEN_SPSC_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "aligned_buffer.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief A fixed-capacity byte queue between exactly one producer thread and
+ *        one consumer thread, neither of which ever blocks or locks.
+ *
+ * The producer and consumer each own one monotonically increasing byte
+ * count, and only read the other's; a release store of a count publishes the
+ * bytes copied before it. The two counts are kept on separate cache lines so
+ * that the threads do not contend for one line on every transfer.
+ *
+ * Waiting, when the ring is full or empty, is left to the caller, which
+ * knows whether to spin, sleep or give up.
+ */
+class SpscRing
+{
+public:
+    /**
+     * @brief Create a ring.
+     *
+     * @param capacity The number of bytes the ring can hold; positive.
+     */
+    explicit SpscRing(size_t capacity)
+        : storage_(capacity), capacity_(capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("capacity must be positive.");
+        }
+        written_.count.store(0, std::memory_order_relaxed);
+        read_.count.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief The number of bytes queued. Exact when called by either thread
+     *        while the other is idle, and otherwise a bound: a lower bound
+     *        for the consumer and an upper bound for the producer.
+     */
+    size_t size() const
+    {
+        const unsigned long long read =
+            read_.count.load(std::memory_order_acquire);
+        return static_cast<size_t>(
+            written_.count.load(std::memory_order_acquire) - read);
+    }
+
+    /**
+     * @brief Copy up to @c num_bytes into the ring. Producer only.
+     *
+     * @return The number of bytes copied, limited by the free space.
+     */
+    size_t write(const void *data, size_t num_bytes)
+    {
+        const unsigned long long written =
+            written_.count.load(std::memory_order_relaxed);
+        const unsigned long long read =
+            read_.count.load(std::memory_order_acquire);
+        const size_t space =
+            capacity_ - static_cast<size_t>(written - read);
+        const size_t count = num_bytes < space ? num_bytes : space;
+        copyIn(static_cast<size_t>(written % capacity_),
+               static_cast<const char*>(data), count);
+        written_.count.store(written + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Move up to @c num_bytes out of the ring. Consumer only.
+     *
+     * @return The number of bytes copied, limited by the bytes queued.
+     */
+    size_t read(void *data, size_t num_bytes)
+    {
+        const unsigned long long read =
+            read_.count.load(std::memory_order_relaxed);
+        const unsigned long long written =
+            written_.count.load(std::memory_order_acquire);
+        const size_t available = static_cast<size_t>(written - read);
+        const size_t count = num_bytes < available ? num_bytes : available;
+        copyOut(static_cast<size_t>(read % capacity_),
+                static_cast<char*>(data), count);
+        read_.count.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    /// A byte count alone on its cache line.
+    struct Counter
+    {
+        std::atomic<unsigned long long> count;
+        char padding[AlignedBuffer<char>::kAlignment -
+                     sizeof(std::atomic<unsigned long long>)];
+    };
+
+    SpscRing(const SpscRing&);
+    SpscRing &operator=(const SpscRing&);
+
+    /**
+     * @brief Copy into the storage from @c position, wrapping at the end.
+     */
+    void copyIn(size_t position, const char *data, size_t count)
+    {
+        const size_t first = count < capacity_ - position ?
+                             count : capacity_ - position;
+        std::memcpy(storage_.data() + position, data, first);
+        std::memcpy(storage_.data(), data + first, count - first);
+    }
+
+    /**
+     * @brief Copy out of the storage from @c position, wrapping at the end.
+     */
+    void copyOut(size_t position, char *data, size_t count) const
+    {
+        const size_t first = count < capacity_ - position ?
+                             count : capacity_ - position;
+        std::memcpy(data, storage_.data() + position, first);
+        std::memcpy(data + first, storage_.data(), count - first);
+    }
+
+    AlignedBuffer<char> storage_; ///< The ring's bytes.
+    size_t capacity_; ///< The size of the storage (in bytes).
+    char padding_[AlignedBuffer<char>::kAlignment]; ///< Separates the counts.
+    Counter written_; ///< Bytes written by the producer.
+    Counter read_; ///< Bytes read by the consumer.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_SPSC_RING_H_
@@ -0,0 +1,231 @@
+/**************************************************************************//**
+ * @brief      Stateful nearest-lower-neighbor resampler for sample streams
+ *             that arrive in blocks.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_STREAMING_RESAMPLER_H_
+#define OOSIGGEN_STREAMING_RESAMPLER_H_
+
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+
+#include "aligned_buffer.h"
+
+namespace oosiggen
+{
+
+/**
+ * @brief Performs nearest-lower-neighbor (sample-and-hold) interpolation of a
+ *        non-uniformly sampled stream onto ascending output locations, with
+ *        the source samples supplied incrementally.
+ *
+ * The (time, sample) history is held in a ring buffer. Blocks are appended
+ * at the tail, and each resample() call releases all history before the
+ * sample being held at its last output location, so the buffer only ever
+ * holds the samples spanning one output block. The scan position is retained
+ * between calls, so no source sample is visited more than once as long as the
+ * output locations keep ascending.
+ *
+ * This is the streaming counterpart of nonUniformResampleFast: each output is
+ * the source sample with the largest time less than or equal to the output
+ * location, or zero if there is none. Once the stream is marked finished,
+ * outputs after its final sample are zero rather than holding that sample.
+ */
+class StreamingResampler
+{
+public:
+    typedef std::complex<double> Sample; ///< Sample type.
+
+    StreamingResampler()
+        : head_(0), tail_(0), next_(0), mask_(0), is_complex_(false),
+          finished_(false)
+    {
+    }
+
+    /**
+     * @brief Append a block of source samples.
+     *
+     * @param times The sample times; must be strictly increasing, and later
+     *        than every previously appended sample.
+     * @param real The real parts of the samples.
+     * @param imag The imaginary parts of the samples, or NULL for real
+     *        samples.
+     * @param num_samples The number of samples in the block.
+     *
+     * @throws std::invalid_argument if the times are not strictly increasing.
+     * @throws std::logic_error if the stream has been finished.
+     */
+    void append(const double *times, const double *real, const double *imag,
+                size_t num_samples)
+    {
+        if (finished_ && num_samples > 0)
+        {
+            throw std::logic_error("Cannot append to a finished stream.");
+        }
+        double previous = empty() ? 0.0 : lastTime();
+        for (size_t idx = 0; idx < num_samples; ++idx)
+        {
+            if ((!empty() || idx > 0) && !(times[idx] > previous))
+            {
+                throw std::invalid_argument(
+                    "Signal time axis is not monotonically increasing.");
+            }
+            previous = times[idx];
+        }
+
+        reserve(size() + num_samples);
+        for (size_t idx = 0; idx < num_samples; ++idx)
+        {
+            const size_t slot = static_cast<size_t>(tail_ + idx) & mask_;
+            times_[slot] = times[idx];
+            samples_[slot] = Sample(real[idx], imag == NULL ? 0.0 : imag[idx]);
+        }
+        tail_ += num_samples;
+        is_complex_ = is_complex_ || (imag != NULL && num_samples > 0);
+    }
+
+    /**
+     * @brief Resample the buffered stream at ascending output locations.
+     *
+     * @param xi The output locations.
+     * @param num_values The number of elements of @c xi.
+     * @param yi_real The real parts of the output samples, one per element of
+     *        @c xi.
+     * @param yi_imag The imaginary parts of the output samples, or NULL if
+     *        they are not needed.
+     */
+    void resample(const double *xi, size_t num_values, double *yi_real,
+                  double *yi_imag)
+    {
+        for (size_t out_idx = 0; out_idx < num_values; ++out_idx)
+        {
+            const double x = xi[out_idx];
+
+            // Output locations are expected to ascend; if one steps back,
+            // rescan from the oldest retained sample.
+            if (next_ > head_ && timeAt(next_ - 1) > x)
+            {
+                next_ = head_;
+            }
+            while (next_ < tail_ && timeAt(next_) <= x)
+            {
+                ++next_;
+            }
+
+            // If there is no reference sample behind the current resample
+            // point, or the stream has finished before it, set output to
+            // zero.
+            const bool has_sample = next_ > head_ &&
+                !(finished_ && next_ == tail_ && x > timeAt(tail_ - 1));
+            const Sample value = has_sample ? sampleAt(next_ - 1)
+                                            : Sample(0.0, 0.0);
+            yi_real[out_idx] = value.real();
+            if (yi_imag != NULL)
+            {
+                yi_imag[out_idx] = value.imag();
+            }
+        }
+
+        // Release the consumed history, keeping the held sample.
+        if (next_ > head_ + 1)
+        {
+            head_ = next_ - 1;
+        }
+    }
+
+    /**
+     * @brief Discard all buffered samples.
+     */
+    void clear()
+    {
+        head_ = tail_;
+        next_ = tail_;
+    }
+
+    /**
+     * @brief Mark the end of the stream; no further samples may be appended.
+     */
+    void finish() { finished_ = true; }
+
+    bool finished() const { return finished_; }
+
+    /**
+     * @brief True once any complex samples have been appended.
+     */
+    bool isComplex() const { return is_complex_; }
+
+    bool empty() const { return head_ == tail_; }
+    size_t size() const { return static_cast<size_t>(tail_ - head_); }
+
+    /**
+     * @brief The time of the most recently appended sample; the stream must
+     *        not be empty.
+     */
+    double lastTime() const { return timeAt(tail_ - 1); }
+
+private:
+    double timeAt(unsigned long long idx) const
+    {
+        return times_[static_cast<size_t>(idx) & mask_];
+    }
+
+    const Sample &sampleAt(unsigned long long idx) const
+    {
+        return samples_[static_cast<size_t>(idx) & mask_];
+    }
+
+    /**
+     * @brief Grow the ring (to a power of two) so that it can hold at least
+     *        @c capacity samples, preserving the buffered samples.
+     */
+    void reserve(size_t capacity)
+    {
+        if (capacity <= times_.size())
+        {
+            return;
+        }
+        size_t new_capacity = 1024;
+        while (new_capacity < capacity)
+        {
+            new_capacity <<= 1;
+        }
+
+        AlignedBuffer<double> new_times(new_capacity);
+        AlignedBuffer<Sample> new_samples(new_capacity);
+        const size_t new_mask = new_capacity - 1;
+        for (unsigned long long idx = head_; idx < tail_; ++idx)
+        {
+            const size_t slot = static_cast<size_t>(idx) & new_mask;
+            new_times[slot] = timeAt(idx);
+            new_samples[slot] = sampleAt(idx);
+        }
+        times_.swap(new_times);
+        samples_.swap(new_samples);
+        mask_ = new_mask;
+    }
+
+    AlignedBuffer<double> times_; ///< Ring of sample times.
+    AlignedBuffer<Sample> samples_; ///< Ring of samples.
+    unsigned long long head_; ///< Absolute index of the oldest sample.
+    unsigned long long tail_; ///< Absolute index one past the newest sample.
+    unsigned long long next_; ///< First sample after the last output location.
+    size_t mask_; ///< Ring capacity minus one.
+    bool is_complex_; ///< True once complex samples have been appended.
+    bool finished_; ///< True once the end of the stream has been marked.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_STREAMING_RESAMPLER_H_
@@ -0,0 +1,301 @@
+/**************************************************************************//**
+ * @brief      Handle-based interface to stateful nearest-lower-neighbor
+ *             resamplers, so that signal streams can be resampled chunk by
+ *             chunk without concatenating buffers in MATLAB.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#include <cstring> // For strcmp().
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility> // For move().
+
+#include "mex.h"
+
+#include "mex_handle_registry.h"
+#include "streaming_resampler.h"
+
+namespace
+{
+
+/**
+ * @brief The resamplers owned by this MEX file.
+ */
+oosiggen::MexHandleRegistry<oosiggen::StreamingResampler> &resamplers()
+{
+    static oosiggen::MexHandleRegistry<oosiggen::StreamingResampler>
+        registry("streamingResamplerCore");
+    return registry;
+}
+
+/**
+ * @brief Free all resamplers when the MEX file is cleared.
+ */
+void freeAllResamplers()
+{
+    resamplers().clear();
+}
+
+/**
+ * @brief Create an empty resampler.
+ */
+void createResampler(int nlhs, mxArray *plhs[], int nrhs,
+                     const mxArray *prhs[])
+{
+    if (nrhs != 1)
+    {
+        mexErrMsgTxt("create takes no arguments.");
+    }
+    std::unique_ptr<oosiggen::StreamingResampler> resampler(
+        new oosiggen::StreamingResampler());
+    plhs[0] = resamplers().add(std::move(resampler));
+}
+
+/**
+ * @brief Append a block of (time, sample) pairs to a resampler.
+ */
+void appendSamples(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 4)
+    {
+        mexErrMsgTxt("append requires a handle, x and y.");
+    }
+    oosiggen::StreamingResampler &resampler = resamplers().get(prhs[1]);
+
+    const size_t x_length = mxGetM(prhs[2]);
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        (mxGetNumberOfElements(prhs[2]) != x_length))
+    {
+        mexErrMsgTxt("x must be a real column array of doubles.");
+    }
+
+    const size_t y_length = mxGetM(prhs[3]);
+    if (prhs[3] == NULL || !mxIsDouble(prhs[3]) ||
+        (mxGetNumberOfElements(prhs[3]) != y_length))
+    {
+        mexErrMsgTxt("y must be a column array of doubles.");
+    }
+    if (x_length != y_length)
+    {
+        mexErrMsgTxt("x length does not match y length.");
+    }
+
+    const double *y_i = NULL;
+    if (mxIsComplex(prhs[3]))
+    {
+        y_i = static_cast<double*>(mxGetPi(prhs[3]));
+    }
+
+    try
+    {
+        resampler.append(static_cast<double*>(mxGetPr(prhs[2])),
+                         static_cast<double*>(mxGetPr(prhs[3])), y_i,
+                         x_length);
+    }
+    catch (const std::exception &e)
+    {
+        const std::string text = std::string(e.what()) +
+            " Exiting to prevent possible infinite loop. Consider checking "
+            "the signal time spline for proper definition over the desired "
+            "duration.";
+        mexErrMsgTxt(text.c_str());
+    }
+}
+
+/**
+ * @brief Resample the buffered stream at a set of output locations.
+ */
+void resampleSamples(int nlhs, mxArray *plhs[], int nrhs,
+                     const mxArray *prhs[])
+{
+    if (nrhs != 3)
+    {
+        mexErrMsgTxt("resample requires a handle and xi.");
+    }
+    oosiggen::StreamingResampler &resampler = resamplers().get(prhs[1]);
+
+    const size_t xi_length = mxGetM(prhs[2]);
+    if (prhs[2] == NULL || !mxIsDouble(prhs[2]) || mxIsComplex(prhs[2]) ||
+        (mxGetNumberOfElements(prhs[2]) != xi_length))
+    {
+        mexErrMsgTxt("xi must be a real column array of doubles.");
+    }
+
+    const bool is_complex = resampler.isComplex();
+    plhs[0] = mxCreateDoubleMatrix(static_cast<mwSize>(xi_length), 1,
+                                   is_complex ? mxCOMPLEX : mxREAL);
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+    double *yi_i = NULL;
+    if (is_complex)
+    {
+        yi_i = static_cast<double*>(mxGetPi(plhs[0]));
+    }
+
+    resampler.resample(static_cast<double*>(mxGetPr(prhs[2])), xi_length,
+                       static_cast<double*>(mxGetPr(plhs[0])), yi_i);
+}
+
+/**
+ * @brief Mark the end of a resampler's stream.
+ */
+void finishStream(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("finish requires a handle.");
+    }
+    resamplers().get(prhs[1]).finish();
+}
+
+/**
+ * @brief Get the time of the newest buffered sample (empty if none).
+ */
+void getLastTime(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("last_time requires a handle.");
+    }
+    const oosiggen::StreamingResampler &resampler = resamplers().get(prhs[1]);
+    if (resampler.empty())
+    {
+        plhs[0] = mxCreateDoubleMatrix(0, 0, mxREAL);
+    }
+    else
+    {
+        plhs[0] = mxCreateDoubleScalar(resampler.lastTime());
+    }
+    if (plhs[0] == NULL)
+    {
+        mexErrMsgTxt("Could not allocate output array.");
+    }
+}
+
+/**
+ * @brief Free one or more resamplers.
+ */
+void freeResamplers(int nlhs, mxArray *plhs[], int nrhs,
+                    const mxArray *prhs[])
+{
+    if (nrhs != 2)
+    {
+        mexErrMsgTxt("free requires handles.");
+    }
+    resamplers().remove(prhs[1]);
+}
+
+} // namespace
+
+/**
+ * @brief The standard MEX gateway function.
+ *
+ * @par MATLAB Usage
+ * h = streamingResamplerCore('create')
+ * streamingResamplerCore('append', h, x, y)
+ * y_i = streamingResamplerCore('resample', h, x_i)
+ * streamingResamplerCore('finish', h)
+ * t = streamingResamplerCore('last_time', h)
+ * streamingResamplerCore('free', handles)
+ *
+ * @par MATLAB Arguments
+ * - <c>prhs[0]</c>: The command string.
+ *
+ * For @c 'create':
+ * - <c>plhs[0]</c>: A @c uint64 scalar handle to a new, empty resampler.
+ *
+ * For @c 'append':
+ * - <c>prhs[1]</c>: The resampler handle.
+ * - <c>prhs[2]</c>: The input vector, @c x, which represents the reference
+ *   x-axis locations. Must be a real column vector of doubles, strictly
+ *   increasing and beyond every previously appended location.
+ * - <c>prhs[3]</c>: The input vector, @c y, which represents the reference
+ *   y-axis values. Must be a real or complex column vector of doubles.
+ *
+ * For @c 'resample':
+ * - <c>prhs[1]</c>: The resampler handle.
+ * - <c>prhs[2]</c>: The input vector, <c>x_i</c>, which represents the desired
+ *   x-axis locations. Must be a real column vector of doubles, and should be
+ *   at or beyond the locations of the previous call.
+ * - <c>plhs[0]</c>: The output vector, <c>y_i</c>, which is the same size as
+ *   <c>x_i</c>; complex if any complex data has been appended.
+ *
+ * For @c 'finish':
+ * - <c>prhs[1]</c>: The resampler handle. Marks the end of the stream, after
+ *   which outputs beyond the final sample are zero.
+ *
+ * For @c 'last_time':
+ * - <c>prhs[1]</c>: The resampler handle.
+ * - <c>plhs[0]</c>: The newest buffered x-axis location, or empty if no data
+ *   is buffered.
+ *
+ * For @c 'free':
+ * - <c>prhs[1]</c>: A @c uint64 array of handles to free.
+ *
+ * @param nlhs The number of left-hand-side arguments.
+ * @param plhs The left-hand-side arguments.
+ * @param nrhs The number of right-hand-side arguments.
+ * @param prhs The right-hand-side arguments.
+ */
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static bool registered_exit = false;
+    if (!registered_exit)
+    {
+        mexAtExit(freeAllResamplers);
+        registered_exit = true;
+    }
+
+    // Input argument checks.
+    if (nrhs < 1 || !mxIsChar(prhs[0]))
+    {
+        mexErrMsgTxt("The first argument must be a command string.");
+    }
+    char command[16];
+    if (mxGetString(prhs[0], command, sizeof(command)) != 0)
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+
+    if (std::strcmp(command, "create") == 0)
+    {
+        createResampler(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "append") == 0)
+    {
+        appendSamples(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "resample") == 0)
+    {
+        resampleSamples(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "finish") == 0)
+    {
+        finishStream(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "last_time") == 0)
+    {
+        getLastTime(nlhs, plhs, nrhs, prhs);
+    }
+    else if (std::strcmp(command, "free") == 0)
+    {
+        freeResamplers(nlhs, plhs, nrhs, prhs);
+    }
+    else
+    {
+        mexErrMsgTxt("Unknown command.");
+    }
+}
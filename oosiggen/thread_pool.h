@@ -0,0 +1,248 @@
+/**************************************************************************//**
+ * @brief      A small work-stealing thread pool for native signal generation.
+ *
+ * @author
+ *
+ * @date       Created 2026/10/14
+ *
+ * @file
+ * @copyright  Copyright &copy; 2026 The %MITRE Corporation
+ * @par Notice
+ * This software was produced for the U.S. Government under Contract No.
+ * FA8702-17-C-0001, and is subject to the Rights in Noncommercial Computer
+ * Software and Noncommercial Computer Software Documentation Clause
+ * (DFARS) 252.227-7014 (JUN 1995)
+ *****************************************************************************/
+#ifndef OOSIGGEN_THREAD_POOL_H_
+#define OOSIGGEN_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oosiggen
+{
+
+/**
+ * @brief Runs batches of independent, indexed tasks across a fixed set of
+ *        threads.
+ *
+ * Each batch is dealt out round-robin to per-thread queues. A thread works
+ * from the front of its own queue and, once that is empty, steals from the
+ * back of the others, so threads that draw cheap tasks pick up the remaining
+ * work of those that draw expensive ones. The calling thread takes part in
+ * every batch.
+ *
+ * Which thread runs a task is not deterministic; tasks must write only to
+ * their own outputs, so that results do not depend on the schedule.
+ *
+ * The tasks must not call the MEX API, which is not thread safe.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Create a pool.
+     *
+     * @param num_threads The number of threads that run tasks, including the
+     *        calling thread; zero or one runs every task on the calling
+     *        thread.
+     */
+    explicit ThreadPool(size_t num_threads)
+        : generation_(0), stopping_(false), job_(NULL), remaining_(0)
+    {
+        const size_t num_participants = num_threads > 1 ? num_threads : 1;
+        for (size_t idx = 0; idx < num_participants; ++idx)
+        {
+            queues_.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+        }
+        for (size_t idx = 1; idx < num_participants; ++idx)
+        {
+            workers_.push_back(std::thread(&ThreadPool::workerLoop, this,
+                                           idx));
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (size_t idx = 0; idx < workers_.size(); ++idx)
+        {
+            workers_[idx].join();
+        }
+    }
+
+    /**
+     * @brief The number of threads that run tasks, including the caller.
+     */
+    size_t numThreads() const { return queues_.size(); }
+
+    /**
+     * @brief Run <c>task(0)</c> through <c>task(num_tasks - 1)</c> and wait
+     *        for all to complete.
+     *
+     * If any task throws, the remaining tasks still run, and the first
+     * exception is rethrown on the calling thread.
+     */
+    void parallelFor(size_t num_tasks, const std::function<void(size_t)> &task)
+    {
+        if (queues_.size() == 1 || num_tasks <= 1)
+        {
+            for (size_t idx = 0; idx < num_tasks; ++idx)
+            {
+                task(idx);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &task;
+            remaining_ = num_tasks;
+            error_ = std::exception_ptr();
+            ++generation_;
+        }
+        // The job is published before any of its tasks are queued, so a
+        // thread that pops a task always sees the job it belongs to.
+        for (size_t idx = 0; idx < num_tasks; ++idx)
+        {
+            TaskQueue &queue = *queues_[idx % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(idx);
+        }
+        wake_.notify_all();
+
+        runTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return remaining_ == 0; });
+        job_ = NULL;
+        if (error_)
+        {
+            std::exception_ptr error = error_;
+            error_ = std::exception_ptr();
+            lock.unlock();
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool &operator=(const ThreadPool&);
+
+    /// The pending task indices of one thread.
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    void workerLoop(size_t self)
+    {
+        unsigned long long seen_generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]() {
+                    return stopping_ || generation_ != seen_generation;
+                });
+                if (stopping_)
+                {
+                    return;
+                }
+                seen_generation = generation_;
+            }
+            runTasks(self);
+        }
+    }
+
+    /**
+     * @brief Run tasks until no thread has any left to steal.
+     */
+    void runTasks(size_t self)
+    {
+        size_t task_idx;
+        while (popTask(self, task_idx))
+        {
+            const std::function<void(size_t)> *job;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job = job_;
+            }
+            try
+            {
+                (*job)(task_idx);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--remaining_ == 0)
+            {
+                done_.notify_all();
+            }
+        }
+    }
+
+    /**
+     * @brief Take the next task from this thread's own queue, or steal one
+     *        from another thread's.
+     */
+    bool popTask(size_t self, size_t &task_idx)
+    {
+        {
+            TaskQueue &queue = *queues_[self];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task_idx = queue.tasks.front();
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues_.size(); ++offset)
+        {
+            TaskQueue &queue = *queues_[(self + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task_idx = queue.tasks.back();
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<TaskQueue> > queues_; ///< One per thread.
+    std::vector<std::thread> workers_; ///< All threads but the caller.
+    std::mutex mutex_; ///< Guards the fields below.
+    std::condition_variable wake_; ///< Signals a new batch or shutdown.
+    std::condition_variable done_; ///< Signals the end of a batch.
+    unsigned long long generation_; ///< Incremented for every batch.
+    bool stopping_; ///< True once the pool is being destroyed.
+    const std::function<void(size_t)> *job_; ///< The current batch's task.
+    size_t remaining_; ///< Tasks in the current batch not yet complete.
+    std::exception_ptr error_; ///< The first exception thrown by a task.
+};
+
+} // namespace oosiggen
+
+#endif // OOSIGGEN_THREAD_POOL_H_
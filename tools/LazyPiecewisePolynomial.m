@@ -0,0 +1,77 @@
+classdef (Sealed = true) LazyPiecewisePolynomial < handle
+    % A piecewise polynomial file that is only read when its value is first
+    % requested.
+    %
+    % load_signal returns these for the profiles that building a signal
+    % generator does not use, so that they are neither parsed nor held in
+    % memory unless something asks for them. The handle is shared: once
+    % one copy has read the file, every copy returns the loaded value.
+    %
+    % Parameters:
+    % filename: Path to a binary piecewise polynomial file. The file must
+    %     exist when the handle is created, but is not opened until value()
+    %     is called.
+    %
+    % Returns: A handle whose value() returns the piecewise polynomial, as
+    %     readPiecewisePolynomialBinary does.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+    properties (SetAccess = private)
+        filename; % The path of the piecewise polynomial file.
+    end
+
+    properties (Access = private)
+        piecewise = []; % The loaded piecewise polynomial, once read.
+    end
+
+    methods
+        function obj = LazyPiecewisePolynomial(filename)
+            validateattributes(filename, {'char', 'string'}, {'scalartext'});
+            % Report a missing file now rather than on first use.
+            if exist(filename, 'file') ~= 2
+                error(['Could not open file: ' char(filename)]);
+            end
+            obj.filename = char(filename);
+        end
+
+        function piecewise = value(obj)
+            % Read the file on the first call, and return the piecewise
+            % polynomial.
+            if isempty(obj.piecewise)
+                obj.piecewise = readPiecewisePolynomialBinary(obj.filename);
+            end
+            piecewise = obj.piecewise;
+        end
+
+        function loaded = isLoaded(obj)
+            % True once the file has been read.
+            loaded = ~isempty(obj.piecewise);
+        end
+    end
+end
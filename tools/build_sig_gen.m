@@ -0,0 +1,78 @@
+function [sig_gen_v, labels, fdma_offsets] = build_sig_gen(recipe)
+    % Build the OOsiggen signal generators described by a recipe from
+    % prepare_sig_gen.
+    %
+    % Parameters:
+    % recipe: A struct returned by prepare_sig_gen, possibly loaded from a
+    %     scenario cache by compile_scenario.
+    %
+    % Returns:
+    % sig_gen_v: A cell array of signal generators, one per channel of the
+    %     recipe. The length of the cell array will be zero if `recipe` is
+    %     empty.
+    % labels: A cell array of a name for each signal generator, such as
+    %     'Galileo E1OS PRN 3 pilot', for use in profiler reports.
+    % fdma_offsets: The FDMA offset of each signal generator (in Hz), for
+    %     CompositeSignalGenerator.addSignalGenerator().
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+
+    sig_gen_v = {};
+    labels = {};
+    fdma_offsets = zeros(1, 0);
+    if isempty(recipe)
+        return
+    end
+
+    for i = 1:numel(recipe.channels)
+        channel = recipe.channels(i);
+        codegen = RepeatingSampleGenerator(channel.chips, ...
+            channel.start_index + 1, channel.chip_rate, true);
+        if channel.has_data
+            symbol_gen = FixedSetSymbolGenerator( ...
+                recipe.data_period, recipe.data_symbols);
+            ref_gen = ReferenceSignalGenerator(codegen, symbol_gen);
+        else
+            ref_gen = ReferenceSignalGenerator(codegen);
+        end
+        sig_gen_v{end + 1} = SignalGenerator( ...
+            ref_gen, recipe.signal_power_profile, ...
+            recipe.doppler_profile, recipe.carrier_phase, ...
+            recipe.time_spline);
+        labels{end + 1} = recipe.label;
+        fdma_offsets(end + 1) = recipe.fdma_offset;
+        if numel(recipe.channels) > 1
+            if channel.has_data
+                labels{end} = [labels{end} ' data'];
+            else
+                labels{end} = [labels{end} ' pilot'];
+            end
+        end
+    end
+end
@@ -0,0 +1,156 @@
+function scenario = compile_scenario(scenario_file, cache_file)
+    % Load a scenario and prepare its signals, reusing a cache of the result
+    % when the inputs have not changed.
+    %
+    % Preparing a scenario reads every binary profile of every signal, fits
+    % the signal-time splines and extracts the PRN chip sequences from the
+    % code tables (see prepare_sig_gen). The prepared recipes and the noise
+    % density profile are saved to a single uncompressed MAT file, keyed by a
+    % SHA-256 hash of the contents of every input file, so later runs of the
+    % same scenario (at any sample rate) only hash the inputs and load the
+    % cache. A stale, corrupt or unwritable cache is rebuilt or skipped.
+    %
+    % Parameters:
+    % scenario_file: Path to a `scenario.json` file.
+    % cache_file: Path to the cache file. Defaults to
+    %     `<scenario name>.cache.mat` beside `scenario_file`. An empty value
+    %     disables the cache.
+    %
+    % Returns: A struct with fields:
+    % key: The hash of the inputs, as a hexadecimal string.
+    % recipes: A cell array of signal recipes, one per supported signal, for
+    %     build_sig_gen.
+    % sample_rates: The recommended minimum sampling rate of each recipe.
+    % noise_density: The default noise density profile spline.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+
+    % Increment when the contents of a prepared scenario change.
+    CACHE_VERSION = 3;
+    % The binary profiles of each signal that prepare_sig_gen reads. The
+    % others are only loaded on demand by load_signal, so they are not read
+    % here either, and changing them does not invalidate the cache.
+    BIN_FILE_FIELDS = { ...
+        'pseudorange_profile', 'doppler_profile', 'signal_power_profile', ...
+        'data_symbols_real', 'data_symbols_imag'};
+    % The code tables read by the code generators in prepare_sig_gen.
+    CODE_TABLES = {'ca_code_table.mat', 'e1os_code_table.mat'};
+
+    [simenv_path, scenario_name, ~] = fileparts(scenario_file);
+    if nargin < 2
+        cache_file = [simenv_path, filesep, scenario_name, '.cache.mat'];
+    end
+
+    fprintf('Loading path [%s]\n', scenario_file);
+    scenario_def = jsondecode(fileread(scenario_file));
+    signals_file = [simenv_path, filesep, scenario_def.antennas.signals];
+    signals_def = jsondecode(fileread(signals_file));
+    if ~iscell(signals_def)
+        signals_def = num2cell(signals_def);
+    end
+    noise_file = [simenv_path, filesep , ...
+                  scenario_def.default_noise_density_profile];
+
+    input_files = {scenario_file, signals_file, noise_file};
+    for i = 1:numel(signals_def)
+        for j = 1:numel(BIN_FILE_FIELDS)
+            if isfield(signals_def{i}, BIN_FILE_FIELDS{j})
+                input_files{end + 1} = [simenv_path, '/', ...
+                    signals_def{i}.(BIN_FILE_FIELDS{j})]; %#ok<AGROW>
+            end
+        end
+    end
+    for i = 1:numel(CODE_TABLES)
+        code_table_file = which(CODE_TABLES{i});
+        if ~isempty(code_table_file)
+            input_files{end + 1} = code_table_file; %#ok<AGROW>
+        end
+    end
+    key = hash_files(CACHE_VERSION, input_files);
+
+    if ~isempty(cache_file) && exist(cache_file, 'file')
+        try
+            cached = load(cache_file, 'scenario');
+            if strcmp(cached.scenario.key, key)
+                fprintf('Using scenario cache [%s]\n', cache_file);
+                scenario = cached.scenario;
+                return
+            end
+        catch
+            % An unreadable cache is rebuilt below.
+        end
+    end
+
+    scenario = struct();
+    scenario.key = key;
+    scenario.recipes = {};
+    scenario.sample_rates = [];
+    for i = 1:numel(signals_def)
+        [recipe, sample_rate] = prepare_sig_gen(signals_def{i}, simenv_path);
+        if ~isempty(recipe)
+            scenario.recipes{end + 1} = recipe;
+            scenario.sample_rates(end + 1) = sample_rate;
+        end
+    end
+    scenario.noise_density = readPiecewisePolynomialBinary(noise_file);
+
+    if ~isempty(cache_file)
+        try
+            % Version 6 MAT files are uncompressed, so they load at disk
+            % speed.
+            save(cache_file, 'scenario', '-v6');
+            fprintf('Saved scenario cache [%s]\n', cache_file);
+        catch err
+            warning('Could not save scenario cache [%s]: %s', ...
+                    cache_file, err.message);
+        end
+    end
+end
+
+function key = hash_files(version, files)
+    % Hash the cache version and the name and contents of each file.
+    digest = java.security.MessageDigest.getInstance('SHA-256');
+    digest.update(typecast(uint8(sprintf('scenario cache v%d', version)), ...
+                           'int8'));
+    for i = 1:numel(files)
+        [~, name, ext] = fileparts(files{i});
+        digest.update(typecast(uint8([name, ext, 0]), 'int8'));
+        fid = fopen(files{i}, 'r');
+        if fid == -1
+            error(['Could not open file: ' files{i}]);
+        end
+        contents = fread(fid, inf, '*uint8');
+        fclose(fid);
+        if ~isempty(contents)
+            digest.update(typecast(contents, 'int8'));
+        end
+    end
+    key = lower(reshape(dec2hex(typecast(digest.digest(), 'uint8'), 2).', ...
+                        1, []));
+end
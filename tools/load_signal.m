@@ -1,4 +1,4 @@
-function signal = load_signal(signal_def, simenv_path)
+function signal = load_signal(signal_def, simenv_path, lazy_fields)
     % Load the peicewise polynomial components of a signal definition.
     %
     % Parameters:
@@ -6,10 +6,16 @@ function signal = load_signal(signal_def, simenv_path)
     %     includes file names for piecewise polynomial fields.
     % simenv_path: The path to the directory which contains the needed
     %     piecewise polynomial files.
+    % lazy_fields: Optional. The piecewise polynomial fields to return as
+    %     LazyPiecewisePolynomial handles, read only when their value() is
+    %     first requested. Defaults to the fields that make_sig_gen does not
+    %     use: 'autocorr_function' and 'noise_power_density_profile'. Pass {}
+    %     to read every field.
     %
     % Returns: An equivalent struct to `signal_def`, but with the piecewise
-    %     polynomial file names replaced with loaded piecewise polynomials.
-    %     Other fields are passed through verbatim.
+    %     polynomial file names replaced with loaded piecewise polynomials,
+    %     or with lazy handles for the fields in `lazy_fields`. Other fields
+    %     are passed through verbatim.
 
 	% NOTICE
 	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
@@ -45,6 +51,9 @@ function signal = load_signal(signal_def, simenv_path)
         'autocorr_function', 'pseudorange_profile', 'doppler_profile', ...
         'signal_power_profile', 'data_symbols_real', 'data_symbols_imag', ...
         'noise_power_density_profile'};
+    if nargin < 3
+        lazy_fields = {'autocorr_function', 'noise_power_density_profile'};
+    end
 
     signal = struct();
     for i=1:numel(verbatim_fields)
@@ -53,8 +62,11 @@ function signal = load_signal(signal_def, simenv_path)
     end
     for i=1:numel(bin_file_fields)
         bin_file_field = bin_file_fields{i};
-        piecewise = readPiecewisePolynomialBinary( ...
-            [simenv_path, '/', signal_def.(bin_file_field)]);
-        signal.(bin_file_field) = piecewise;
+        bin_file = [simenv_path, '/', signal_def.(bin_file_field)];
+        if any(strcmp(bin_file_field, lazy_fields))
+            signal.(bin_file_field) = LazyPiecewisePolynomial(bin_file);
+        else
+            signal.(bin_file_field) = readPiecewisePolynomialBinary(bin_file);
+        end
     end
 end
@@ -40,57 +40,6 @@ function [sig_gen_v, sample_rate] = make_sig_gen(signal_def, simenv_path)
 
 	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
 
-    if strcmp(signal_def.system, 'GPS') && strcmp(signal_def.name, 'L1CA')
-        has_data_channel = true;
-        has_pilot_channel = false;
-        data_codegen_func = @GPSCACodeGenerator;
-        prn_field_name = 'prn';
-        sample_rate = 4.0e6;
-    elseif strcmp(signal_def.system, 'Galileo') && strcmp(signal_def.name, 'E1OS')
-        % note that the E1OS signal generator produces only a BOC(1,1) signal and does not contain
-        % the CBOC component
-        has_data_channel = true;
-        has_pilot_channel = true;
-        data_codegen_func = @(prn) GalileoE1OSCodeGenerator(prn, 'b');
-        pilot_codegen_func = @(prn) GalileoE1OSCodeGenerator(prn, 'c');
-        prn_field_name = 'prn';
-        sample_rate = 8.0e6;
-    else
-        % System and/or signal not supported
-        sig_gen_v = [];
-        sample_rate = 0;
-        warning('Unsupported signal or system found in %s; omitting.\n', simenv_path)
-        return
-    end
-
-    signal_loaded = load_signal(signal_def, simenv_path);
-    data_symbols = ( ...
-        signal_loaded.data_symbols_real.coefs + ...
-        signal_loaded.data_symbols_imag.coefs .* 1j);
-    data_rate = signal_loaded.signal_params.data_rate;
-    data_period = 1 ./ data_rate;
-    symbol_gen = FixedSetSymbolGenerator(data_period, data_symbols);
-    time_spline = convertToSignalTimeSpline(signal_loaded.pseudorange_profile);
-
-    prn = signal_loaded.signal_params.(prn_field_name);
-    sig_gen_v = {};
-
-    if has_data_channel
-        data_codegen = data_codegen_func(prn);
-        data_ref_gen = ReferenceSignalGenerator(data_codegen, symbol_gen);
-        data_sig_gen = SignalGenerator( ...
-            data_ref_gen, signal_loaded.signal_power_profile, ...
-            signal_loaded.doppler_profile, signal_loaded.carrier_phase, ...
-            time_spline);
-        sig_gen_v{end + 1} = data_sig_gen;
-    end
-    if has_pilot_channel
-        pilot_codegen = pilot_codegen_func(prn);
-        pilot_ref_gen = ReferenceSignalGenerator(pilot_codegen);
-        pilot_sig_gen = SignalGenerator( ...
-            pilot_ref_gen, signal_loaded.signal_power_profile, ...
-            signal_loaded.doppler_profile, signal_loaded.carrier_phase, ...
-            time_spline);
-        sig_gen_v{end + 1} = pilot_sig_gen;
-    end
+    [recipe, sample_rate] = prepare_sig_gen(signal_def, simenv_path);
+    sig_gen_v = build_sig_gen(recipe);
 end
@@ -0,0 +1,167 @@
+function plan = plan_pipeline(sampling_rate, oversample_ratio, ...
+                              num_signals, run_seconds, options)
+    % Choose the block size of each stage of the IQ generation pipeline.
+    %
+    % The stages are sized from the cache sizes and the sample rate so that
+    % each one's working set stays cache-resident:
+    % - The native engine renders every stream into its own buffer of
+    %   complex doubles and then sums the buffers, so its block is the
+    %   largest power of two for which all the buffers and the output fit in
+    %   half of the shared cache, and one buffer fits in half of a core's
+    %   private cache.
+    % - Each MATLAB call to CompositeSignalGenerator.getSamples (and the
+    %   output stage after it) holds the high-rate time axis and samples and
+    %   the decimated result, so a chunk is sized to fit those in the shared
+    %   cache, within limits that keep the per-call MATLAB overhead small.
+    %   Chunks are whole numbers of engine blocks and of the oversampling
+    %   ratio.
+    % - The file writer's blocks are the smallest power of two that holds a
+    %   chunk of output, within 1 to 16 MiB.
+    %
+    % The run length does not depend on any of these: it is that of the
+    % original fixed-chunk loop, which generated chunks of
+    % `options.output_granule` seconds until the last output sample time
+    % reached `run_seconds`. Since every stage carries its state across
+    % calls, the output samples are the same for any block sizes, to within
+    % rounding.
+    %
+    % Parameters:
+    % sampling_rate: The output sampling rate (in samples/sec).
+    % oversample_ratio: The composite generator's oversampling ratio.
+    % num_signals: The number of signals summed.
+    % run_seconds: The requested run length (in sec).
+    % options: A struct of tunables; missing or empty fields take their
+    %     defaults:
+    %     private_cache_bytes: Per-core (L2) cache size. Default 1 MiB.
+    %     shared_cache_bytes: Shared (L3) cache size. Default 8 MiB.
+    %     output_granule: The run length is a whole number of these (in
+    %         sec). Default 0.05.
+    %     min_chunk_size: The shortest chunk (in sec). Default 0.005.
+    %     max_chunk_size: The longest chunk (in sec). Default 0.05.
+    %     sample_bytes: Bytes per written IQ sample. Default 4 (int16 I/Q).
+    %     chunk_size: Overrides the chosen chunk length (in sec).
+    %     engine_block_size: Overrides the chosen engine block (in high-rate
+    %         samples).
+    %     writer_block_size: Overrides the chosen writer block (in bytes).
+    %
+    % Returns: A struct with fields:
+    % chunk_samples: High-rate samples per call to getSamples.
+    % engine_block_size: High-rate samples per native engine block.
+    % writer_block_size: Bytes per file writer block.
+    % total_samples: High-rate samples in the whole run.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+
+    if nargin < 5
+        options = struct();
+    end
+    defaults = struct( ...
+        'private_cache_bytes', 2^20, ...
+        'shared_cache_bytes', 8 * 2^20, ...
+        'output_granule', 0.05, ...
+        'min_chunk_size', 0.005, ...
+        'max_chunk_size', 0.05, ...
+        'sample_bytes', 4, ...
+        'chunk_size', [], ...
+        'engine_block_size', [], ...
+        'writer_block_size', []);
+    names = fieldnames(defaults);
+    for k = 1:numel(names)
+        if ~isfield(options, names{k}) || isempty(options.(names{k}))
+            options.(names{k}) = defaults.(names{k});
+        end
+    end
+    validateattributes(sampling_rate, {'numeric'}, {'scalar', 'positive'});
+    validateattributes(oversample_ratio, {'numeric'}, ...
+                       {'scalar', 'integer', 'positive'});
+    validateattributes(num_signals, {'numeric'}, ...
+                       {'scalar', 'integer', 'nonnegative'});
+    validateattributes(run_seconds, {'numeric'}, {'scalar'});
+
+    sampling_rate_high = sampling_rate * oversample_ratio;
+
+    % Native engine: one complex double buffer per stream, plus the output.
+    BYTES_PER_STREAM_SAMPLE = 16;
+    if isempty(options.engine_block_size)
+        block = min(options.shared_cache_bytes / 2 / ...
+                    ((num_signals + 1) * BYTES_PER_STREAM_SAMPLE), ...
+                    options.private_cache_bytes / 2 / ...
+                    BYTES_PER_STREAM_SAMPLE);
+        block = 2^floor(log2(max(block, 1)));
+        plan.engine_block_size = min(max(block, 2048), 65536);
+    else
+        plan.engine_block_size = options.engine_block_size;
+    end
+
+    % MATLAB chunk: the high-rate time axis (8 bytes) and samples (16 bytes)
+    % per high-rate sample, and the decimated time axis, samples and
+    % written output per output sample.
+    if isempty(options.chunk_size)
+        bytes_per_sample = 24 + (24 + options.sample_bytes) / ...
+                                oversample_ratio;
+        chunk_size = options.shared_cache_bytes / bytes_per_sample / ...
+                     sampling_rate_high;
+        chunk_size = min(max(chunk_size, options.min_chunk_size), ...
+                         options.max_chunk_size);
+    else
+        chunk_size = options.chunk_size;
+    end
+    unit = lcm(plan.engine_block_size, oversample_ratio);
+    plan.chunk_samples = max(1, round(chunk_size * sampling_rate_high / ...
+                                      unit)) * unit;
+
+    % File writer: hold a chunk of output per block.
+    if isempty(options.writer_block_size)
+        chunk_bytes = plan.chunk_samples / oversample_ratio * ...
+                      options.sample_bytes;
+        plan.writer_block_size = ...
+            min(max(2^ceil(log2(chunk_bytes)), 2^20), 16 * 2^20);
+    else
+        plan.writer_block_size = options.writer_block_size;
+    end
+
+    % Run length: whole granules, until the last output sample time (at a
+    % high-rate index that is a multiple of the oversampling ratio) reaches
+    % run_seconds, as compared by the original loop.
+    plan.total_samples = 0;
+    granule = floor(options.output_granule * sampling_rate_high);
+    if run_seconds > 0
+        if granule < 1
+            error('output_granule is shorter than one high-rate sample.');
+        end
+        num_granules = max(1, floor(run_seconds * sampling_rate_high / ...
+                                    granule) - 1);
+        while double(floor((num_granules * granule - 1) / ...
+                           oversample_ratio) * oversample_ratio) / ...
+              sampling_rate_high < run_seconds
+            num_granules = num_granules + 1;
+        end
+        plan.total_samples = num_granules * granule;
+    end
+end
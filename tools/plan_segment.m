@@ -0,0 +1,82 @@
+function segment = plan_segment(plan, oversample_ratio, sample_bytes, ...
+                                segment_index, num_segments)
+    % Choose the part of a run that one worker of a segmented run generates.
+    %
+    % A run planned by plan_pipeline is split into `num_segments` contiguous
+    % time segments of nearly equal length, which independent processes or
+    % cluster nodes generate at the same time, each seeking to the start of
+    % its segment (see CompositeSignalGenerator.seek) and writing its samples
+    % in place in the shared IQ file (see AsyncIQWriter). The seek rebuilds
+    % the downsampling filter history and the signal buffers at each seam, so
+    % the segments join as an unbroken run would, to within rounding.
+    %
+    % Segments start on output samples whose byte offsets are multiples of
+    % 4096, so that each writer can bypass the page cache; the last segment
+    % takes the remainder.
+    %
+    % Parameters:
+    % plan: The run's plan_pipeline result.
+    % oversample_ratio: The composite generator's oversampling ratio.
+    % sample_bytes: Bytes per written IQ sample.
+    % segment_index: The one-indexed segment, 1 to num_segments.
+    % num_segments: The number of segments.
+    %
+    % Returns: A struct with fields:
+    % first_sample: The run's output sample at which the segment starts.
+    % total_samples: High-rate samples in the segment.
+    % byte_offset: The file position of the segment's first sample.
+    % file_bytes: The size of the whole IQ file.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+
+    validateattributes(num_segments, {'numeric'}, ...
+                       {'scalar', 'integer', 'positive'});
+    validateattributes(segment_index, {'numeric'}, ...
+                       {'scalar', 'integer', 'positive', '<=', num_segments});
+    validateattributes(oversample_ratio, {'numeric'}, ...
+                       {'scalar', 'integer', 'positive'});
+    validateattributes(sample_bytes, {'numeric'}, ...
+                       {'scalar', 'integer', 'positive'});
+
+    % The decimator keeps every oversample_ratio-th high-rate sample, from
+    % the first.
+    run_samples = ceil(plan.total_samples / oversample_ratio);
+    PAGE_BYTES = 4096;
+    unit = PAGE_BYTES / gcd(PAGE_BYTES, sample_bytes);
+    boundaries = round((0:num_segments) * run_samples / num_segments / ...
+                       unit) * unit;
+    boundaries = min(boundaries, run_samples);
+    boundaries(end) = run_samples;
+
+    segment.first_sample = boundaries(segment_index);
+    segment.total_samples = ...
+        min(boundaries(segment_index + 1) * oversample_ratio, ...
+            plan.total_samples) - segment.first_sample * oversample_ratio;
+    segment.total_samples = max(segment.total_samples, 0);
+    segment.byte_offset = segment.first_sample * sample_bytes;
+    segment.file_bytes = run_samples * sample_bytes;
+end
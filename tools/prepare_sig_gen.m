@@ -0,0 +1,111 @@
+function [recipe, sample_rate] = prepare_sig_gen(signal_def, simenv_path)
+    % Load and fit everything needed to build the signal generators for a
+    % scenario signal definition, without building them.
+    %
+    % The result holds only plain data (splines, chip sequences and symbols),
+    % so it can be saved by compile_scenario and rebuilt with build_sig_gen
+    % without re-reading or re-fitting any input.
+    %
+    % Parameters:
+    % signal_def: Scenario signal definition struct (including file names for
+    %     the piecewise polynomial fields). An optional `fdma_offset` field
+    %     gives the signal's FDMA offset (in Hz); it defaults to zero.
+    % simenv_path: Path to the enclosing directory for the scenario.
+    %
+    % Returns:
+    % recipe: A struct describing the signal generators, or [] if the given
+    %     signal definition is not supported. Its `channels` field holds one
+    %     element per component (such as a pilot and data channel).
+    % sample_rate: A recommended minimum sampling rate for this signal.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+
+    if strcmp(signal_def.system, 'GPS') && strcmp(signal_def.name, 'L1CA')
+        has_data_channel = true;
+        has_pilot_channel = false;
+        data_codegen_func = @GPSCACodeGenerator;
+        prn_field_name = 'prn';
+        sample_rate = 4.0e6;
+    elseif strcmp(signal_def.system, 'Galileo') && strcmp(signal_def.name, 'E1OS')
+        % note that the E1OS signal generator produces only a BOC(1,1) signal and does not contain
+        % the CBOC component
+        has_data_channel = true;
+        has_pilot_channel = true;
+        data_codegen_func = @(prn) GalileoE1OSCodeGenerator(prn, 'b');
+        pilot_codegen_func = @(prn) GalileoE1OSCodeGenerator(prn, 'c');
+        prn_field_name = 'prn';
+        sample_rate = 8.0e6;
+    else
+        % System and/or signal not supported
+        recipe = [];
+        sample_rate = 0;
+        warning('Unsupported signal or system found in %s; omitting.\n', simenv_path)
+        return
+    end
+
+    signal_loaded = load_signal(signal_def, simenv_path);
+    recipe = struct();
+    recipe.sample_rate = sample_rate;
+    recipe.data_symbols = ( ...
+        signal_loaded.data_symbols_real.coefs + ...
+        signal_loaded.data_symbols_imag.coefs .* 1j);
+    recipe.data_period = 1 ./ signal_loaded.signal_params.data_rate;
+    recipe.signal_power_profile = signal_loaded.signal_power_profile;
+    recipe.doppler_profile = signal_loaded.doppler_profile;
+    recipe.carrier_phase = signal_loaded.carrier_phase;
+    recipe.fdma_offset = 0;
+    if isfield(signal_def, 'fdma_offset')
+        recipe.fdma_offset = signal_def.fdma_offset;
+    end
+    recipe.time_spline = convertToSignalTimeSpline( ...
+        signal_loaded.pseudorange_profile);
+
+    % Keep the chip sequences rather than the code generators, so that the
+    % code tables are not needed to rebuild the signal.
+    prn = signal_loaded.signal_params.(prn_field_name);
+    recipe.label = sprintf('%s %s PRN %d', signal_def.system, ...
+                           signal_def.name, prn);
+    recipe.channels = struct('chips', {}, 'chip_rate', {}, ...
+                             'start_index', {}, 'has_data', {});
+    if has_data_channel
+        recipe.channels(end + 1) = make_channel(data_codegen_func(prn), true);
+    end
+    if has_pilot_channel
+        recipe.channels(end + 1) = make_channel(pilot_codegen_func(prn), false);
+    end
+end
+
+function channel = make_channel(codegen, has_data)
+    % Describe one component by the chip sequence of its code generator.
+    descriptor = codegen.getStreamDescriptor();
+    channel = struct('chips', descriptor.chips, ...
+                     'chip_rate', descriptor.chip_rate, ...
+                     'start_index', descriptor.start_index, ...
+                     'has_data', has_data);
+end
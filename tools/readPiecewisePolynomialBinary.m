@@ -43,6 +43,13 @@ function piecewise_polynomial_struct = readPiecewisePolynomialBinary(filename)
 
 	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
 
+% Use the native memory-mapped reader if it has been compiled (see
+% oosiggen/make.m); the MATLAB implementation below is the fallback.
+if exist('readPiecewisePolynomialFast', 'file') == 3
+    piecewise_polynomial_struct = readPiecewisePolynomialFast(filename);
+    return;
+end
+
 % Constants.
 MAGIC_WORD_BYTES = 1:4;
 NUM_BREAKS_BYTES = 17:20;
@@ -0,0 +1,78 @@
+function writePiecewisePolynomialBinary(filename, piecewise_polynomial)
+    % Write a piecewise polynomial to a binary piecewise polynomial file, the
+    % format read by readPiecewisePolynomialBinary.
+    %
+    % Each piece is written with every coefficient of its row of `coefs`, so
+    % the file reads back as the same breaks and coefficients.
+    %
+    % Parameters:
+    % filename: Path of the file to write, replacing any earlier contents.
+    % piecewise_polynomial: A scalar piecewise polynomial struct, as returned
+    %     by spline() or mkpp(), with at least one piece.
+
+	% NOTICE
+	% The Homeland Security Act of 2002 (Section 305 of PL 107-296, as codified in 6 U.S.C. 185),
+	% herein referred to as the “Act,” authorizes the Secretary of the U.S. Department of 
+	% Homeland Security (DHS), acting through the DHS Under Secretary for Science and Technology, 
+	% to establish one or more federally funded research and development centers (FFRDCs) 
+	% to provide independent analysis of homeland security issues. MITRE Corporation operates 
+	% the Homeland Security Systems Engineering and Development Institute (HSSEDI) as an FFRDC 
+	% for DHS S&T under contract 70RSAT20D00000001. 
+
+	% The HSSEDI FFRDC provides the government with the necessary systems engineering and 
+	% development expertise to conduct complex acquisition planning and development; concept 
+	% exploration, experimentation and evaluation; information technology, communications 
+	% and cyber security processes, standards, methodologies and protocols; systems 
+	% architecture and integration; quality and performance review, best practices and 
+	% performance measures and metrics; and independent test and evaluation activities. 
+	% The HSSEDI FFRDC also works with and supports other federal, state, local, tribal, 
+	% public and private sector organizations that make up the homeland security enterprise. 
+	% The HSSEDI FFRDC’s research is undertaken by mutual consent with DHS and is 
+	% organized as a set of discrete tasks. This report presents the results of research 
+	% and analysis conducted under:
+
+	% Task Order 70RSAT20FR0000062
+	% DHS S&T Next Generation Resilient PNT
+	% The results presented in this report do not necessarily reflect official DHS opinion or policy. 
+
+	% Approved for public release, Case Number 23-4096 / 70RSAT23FR-067-13
+
+    MAGIC_WORD = uint32(hex2dec('70537750'));
+    VERSION = uint32(1);
+    HEADER_BYTES = 20; % Magic word, version, 8 reserved bytes, break count
+    SIZEOF_DOUBLE = 8;
+    SIZEOF_UINT32 = 4;
+
+    breaks = piecewise_polynomial.breaks;
+    coefs = piecewise_polynomial.coefs;
+    if piecewise_polynomial.dim ~= 1
+        error('Only scalar piecewise polynomials can be written.');
+    end
+    num_breaks = numel(breaks);
+    num_polynomials = num_breaks - 1;
+    if num_polynomials < 1 || size(coefs, 1) ~= num_polynomials
+        error('Expected one row of coefficients per piece.');
+    end
+    order = size(coefs, 2);
+
+    % The lookup table holds the byte offset of each polynomial, which is
+    % its count followed by its coefficients.
+    polynomials_start = HEADER_BYTES + SIZEOF_DOUBLE * num_breaks + ...
+                        SIZEOF_UINT32 * num_polynomials;
+    polynomial_bytes = SIZEOF_UINT32 + SIZEOF_DOUBLE * order;
+    offsets = polynomials_start + (0:(num_polynomials - 1)) * polynomial_bytes;
+
+    fid = fopen(filename, 'w', 'ieee-le');
+    if fid == -1
+        error(['Could not open file: ' filename]);
+    end
+    fwrite(fid, [MAGIC_WORD, VERSION, 0, 0], 'uint32');
+    fwrite(fid, num_breaks, 'int32');
+    fwrite(fid, breaks, 'double');
+    fwrite(fid, offsets, 'uint32');
+    for polynomial_idx = 1:num_polynomials
+        fwrite(fid, order, 'int32');
+        fwrite(fid, coefs(polynomial_idx, :), 'double');
+    end
+    fclose(fid);
+end